@@ -118,6 +118,21 @@ void ServerConfig::set_defaults() {
     // Network settings
     set_string("server-ip", "");
     set_int("server-port", 25565);
+    set_int("network-threads", 2);  // Socket I/O + packet decoding threads
+    set_string("network-backend", "poll");  // poll (epoll on Linux) or io_uring
+    set_int("client-send-budget", 65536);  // Max bytes per client per tick; chunks use what's left
+    set_int("client-min-send-budget", 4096);  // Floor when a client's socket falls behind
+    set_int("client-backlog-soft-limit", 1048576);  // Queued bytes past which a client's chunk sends wait
+    set_int("client-backlog-hard-limit", 8388608);  // Queued bytes at which a client is kicked
+    set_int("client-stall-timeout", 30);  // Seconds a client may stay backlogged or not read before it is kicked
+    set_int("client-inbound-packets-per-tick", 64);  // Packets handled per client per tick; the rest wait
+    set_int("client-inbound-cost-per-tick", 64);  // Same in cost units (dig/place 8, chat 4, movement 1)
+    set_int("inbound-cost-per-tick", 2048);  // Cost units handled per tick across all clients
+    set_int("connection-throttle-burst", 8);  // Connections one address may open at once; 0 = no limit
+    set_int("connection-throttle-per-minute", 20);  // Rate at which an address earns connections back
+    set_int("accepts-per-tick", 16);  // New connections accepted per tick; the rest wait in the backlog
+    set_int("login-timeout", 30);  // Seconds from connecting until the client must be in game
+    set_int("chunks-per-tick", 5);  // Chunks sent to each player per tick; the rest stay queued
 
     // World settings
     set_string("level-name", "world");
@@ -138,6 +153,11 @@ void ServerConfig::set_defaults() {
     set_bool("allow-nether", true);
     set_bool("pvp", true);
     set_bool("allow-flight", false);
+    set_int("mob-update-interval", 3);  // Ticks between mob movement updates to clients
+    set_int("player-update-interval", 2);  // Ticks between player movement updates to other clients
+    set_string("chunk-compression-engine", "auto");  // zlib, libdeflate or auto (fastest built in)
+    set_int("chunk-compression-level", 6);  // 1 (fastest) to 9 (smallest)
+    set_bool("chunk-compression-adaptive", false);  // Lower the level while ticks run long
 
     // World generation settings
     set_int("max-build-height", 128);  // Beta 1.7.3 world height
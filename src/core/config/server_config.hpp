@@ -45,6 +45,26 @@ public:
     bool allow_flight() const { return get_bool("allow-flight", false); }
     bool allow_nether() const { return get_bool("allow-nether", true); }
     i32 max_players() const { return get_int("max-players", 20); }
+    i32 network_threads() const { return get_int("network-threads", 2); }
+    std::string network_backend() const { return get_string("network-backend", "poll"); }
+    i32 client_send_budget() const { return get_int("client-send-budget", 65536); }
+    i32 client_min_send_budget() const { return get_int("client-min-send-budget", 4096); }
+    i32 client_backlog_soft_limit() const { return get_int("client-backlog-soft-limit", 1048576); }
+    i32 client_backlog_hard_limit() const { return get_int("client-backlog-hard-limit", 8388608); }
+    i32 client_stall_timeout() const { return get_int("client-stall-timeout", 30); }
+    i32 client_inbound_packets_per_tick() const { return get_int("client-inbound-packets-per-tick", 64); }
+    i32 client_inbound_cost_per_tick() const { return get_int("client-inbound-cost-per-tick", 64); }
+    i32 inbound_cost_per_tick() const { return get_int("inbound-cost-per-tick", 2048); }
+    i32 connection_throttle_burst() const { return get_int("connection-throttle-burst", 8); }
+    i32 connection_throttle_per_minute() const { return get_int("connection-throttle-per-minute", 20); }
+    i32 accepts_per_tick() const { return get_int("accepts-per-tick", 16); }
+    i32 login_timeout() const { return get_int("login-timeout", 30); }
+    i32 chunks_per_tick() const { return get_int("chunks-per-tick", 5); }
+    i32 mob_update_interval() const { return get_int("mob-update-interval", 3); }
+    i32 player_update_interval() const { return get_int("player-update-interval", 2); }
+    std::string chunk_compression_engine() const { return get_string("chunk-compression-engine", "auto"); }
+    i32 chunk_compression_level() const { return get_int("chunk-compression-level", 6); }
+    bool chunk_compression_adaptive() const { return get_bool("chunk-compression-adaptive", false); }
 
 private:
     std::map<std::string, std::string> properties_;
@@ -16,12 +16,17 @@ void Random::set_seed(i64 seed) {
 }
 
 i64 Random::next_seed() {
-    seed_ = (seed_ * MULTIPLIER + ADDEND) & MASK;
+    // Unsigned, so the product wraps like Java's long instead of overflowing
+    seed_ = static_cast<i64>((static_cast<u64>(seed_) * MULTIPLIER + ADDEND) & MASK);
     return seed_;
 }
 
+i32 Random::next(i32 bits) {
+    return static_cast<i32>(next_seed() >> (48 - bits));
+}
+
 i32 Random::next_int() {
-    return static_cast<i32>(next_seed() >> 16);
+    return next(32);
 }
 
 i32 Random::next_int(i32 bound) {
@@ -31,14 +36,14 @@ i32 Random::next_int(i32 bound) {
 
     if ((bound & -bound) == bound) {
         // Power of 2
-        return static_cast<i32>((bound * static_cast<i64>(next_seed() >> 16)) >> 31);
+        return static_cast<i32>((bound * static_cast<i64>(next(31))) >> 31);
     }
 
     i32 bits, val;
     do {
-        bits = static_cast<i32>(next_seed() >> 16);
+        bits = next(31);
         val = bits % bound;
-    } while (bits - val + (bound - 1) < 0);
+    } while (static_cast<i32>(static_cast<u32>(bits - val) + static_cast<u32>(bound - 1)) < 0);  // Java int overflow
 
     return val;
 }
@@ -48,16 +53,16 @@ i64 Random::next_long() {
 }
 
 f32 Random::next_float() {
-    return static_cast<f32>(next_seed() >> 16) / static_cast<f32>(1 << 24);
+    return static_cast<f32>(next(24)) / static_cast<f32>(1 << 24);
 }
 
 f64 Random::next_double() {
-    return static_cast<f64>((static_cast<i64>(next_seed() >> 16) << 27) + (next_seed() >> 16)) /
+    return static_cast<f64>((static_cast<i64>(next(26)) << 27) + next(27)) /
            static_cast<f64>(1LL << 53);
 }
 
 bool Random::next_bool() {
-    return next_int() >= 0;
+    return next(1) != 0;
 }
 
 } // namespace mcserver
@@ -32,6 +32,9 @@ public:
 private:
     i64 seed_;
     i64 next_seed();
+
+    // Top 'bits' bits of the next seed, as java.util.Random.next()
+    i32 next(i32 bits);
 };
 
 } // namespace mcserver
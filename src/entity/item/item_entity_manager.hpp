@@ -50,6 +50,9 @@ public:
 
     // Get all item entities
     std::vector<ItemEntity*> get_all_items();
+    const std::unordered_map<i32, std::unique_ptr<ItemEntity>>& get_items() const {
+        return items_;
+    }
 
     // Update all items (called every tick)
     void tick();
@@ -2,8 +2,6 @@
 #include "entity/mob/passive_mob.hpp"
 #include "entity/mob/hostile_mob.hpp"
 #include "entity/mob/mob_spawner.hpp"
-#include "net/session/client_session.hpp"
-#include "net/protocol/packets/mob_spawn.hpp"
 #include "world/chunk/chunk.hpp"
 #include "world/chunk/chunk_manager.hpp"
 #include "util/log/logger.hpp"
@@ -144,20 +142,6 @@ const Mob* MobManager::get_mob(i32 entity_id) const {
     return (it != mobs_.end()) ? it->second.get() : nullptr;
 }
 
-void MobManager::spawn_existing_mobs_for(ClientSession* session) {
-    if (!session) {
-        return;
-    }
-
-    for (const auto& [id, mob] : mobs_) {
-        PacketMobSpawn spawn_packet(mob.get());
-        session->send_packet(spawn_packet);
-    }
-
-    LOG_DEBUG_CAT("Sent " + std::to_string(mobs_.size()) + " existing mobs to " +
-                 session->get_username(), LogCategory::Entity);
-}
-
 void MobManager::spawn_test_mobs(f64 spawn_x, f64 spawn_z) {
     // Spawn a few test mobs in a circle around the spawn point
     std::random_device rd;
@@ -11,7 +11,6 @@
 
 namespace mcserver {
 
-class ClientSession;
 class ChunkManager;
 class Player;
 class MobSpawner;
@@ -50,9 +49,6 @@ public:
         return mobs_;
     }
 
-    // Spawn existing mobs for a new player
-    void spawn_existing_mobs_for(ClientSession* session);
-
     // Set callback for mob spawn events
     void set_spawn_callback(MobSpawnCallback callback) {
         spawn_callback_ = callback;
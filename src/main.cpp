@@ -143,7 +143,7 @@ int main(int argc, char** argv) {
     EntityManager entity_manager;
 
     // Start network listening
-    NetworkManager network(&chunk_manager, world_path.string());
+    NetworkManager network(&chunk_manager, world_path.string(), config);
     auto network_result = network.start(config.server_ip(), config.server_port());
     if (!network_result) {
         LOG_FATAL("Failed to bind to port");
@@ -196,7 +196,11 @@ int main(int argc, char** argv) {
                 // Mob tick
                 network.get_mob_manager()->update_all();
 
+                // Send everything queued this tick
+                network.flush();
+
                 tick_manager.tick_finished();
+                network.report_tick_time(static_cast<f64>(tick_manager.last_tick_time_ms()));
                 ++tick_count;
 
                 // Auto-save world every 5 minutes
@@ -208,11 +212,22 @@ int main(int argc, char** argv) {
 
                 // Log status every 20 seconds (400 ticks)
                 if (tick_count % 400 == 0) {
+                    auto outbound = network.outbound_queue_stats();
+                    auto link = network.link_stats();
                     LOG_INFO_CAT(
                         std::string("Tick: ") + std::to_string(tick_count) +
                         " | Clients: " + std::to_string(network.client_count()) +
                         " | Chunks: " + std::to_string(chunk_manager.get_loaded_chunk_count()) +
-                        " | Avg tick: " + std::to_string(tick_manager.average_tick_time_ms()) + "ms",
+                        " | Avg tick: " + std::to_string(tick_manager.average_tick_time_ms()) + "ms" +
+                        " | Outbound queued: " + std::to_string(outbound.total_bytes / 1024) + "KB" +
+                        " (max " + std::to_string(outbound.max_bytes / 1024) + "KB)" +
+                        " | Backlogged: " + std::to_string(outbound.backlogged_clients) +
+                        " | Slow kicks: " + std::to_string(outbound.evicted_clients) +
+                        " | Inbound held: " + std::to_string(network.pending_inbound_packets()) +
+                        " | Throttled: " + std::to_string(network.throttled_connections()) +
+                        " | RTT p50/p99: " + std::to_string(link.rtt_p50_us / 1000.0) + "/" +
+                        std::to_string(link.rtt_p99_us / 1000.0) + "ms" +
+                        " | Drain p50: " + std::to_string(link.drain_p50 / 1024) + "KB/s",
                         LogCategory::Performance
                     );
                 }
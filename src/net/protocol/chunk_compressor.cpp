@@ -0,0 +1,179 @@
+#include "chunk_compressor.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <zlib.h>
+
+#ifdef HAVE_LIBDEFLATE
+#include <libdeflate.h>
+#endif
+
+namespace mcserver {
+
+static i32 clamp_level(i32 level) {
+    return std::clamp(level, CompressionSettings::MIN_LEVEL, CompressionSettings::MAX_LEVEL);
+}
+
+// Fed section by section: same output as compressing the concatenation, without
+// copying everything into a staging buffer first
+static SharedBytes compress_zlib(std::initializer_list<std::pair<const u8*, usize>> sections,
+                                 i32 level) {
+    z_stream stream{};
+    if (deflateInit(&stream, clamp_level(level)) != Z_OK) {
+        return nullptr;
+    }
+
+    uLong total_size = 0;
+    for (const auto& section : sections) {
+        total_size += static_cast<uLong>(section.second);
+    }
+
+    std::vector<byte> compressed(deflateBound(&stream, total_size));
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = static_cast<uInt>(compressed.size());
+
+    int result = Z_OK;
+    usize remaining = sections.size();
+    for (const auto& [data, size] : sections) {
+        stream.next_in = const_cast<Bytef*>(data);
+        stream.avail_in = static_cast<uInt>(size);
+        result = deflate(&stream, --remaining == 0 ? Z_FINISH : Z_NO_FLUSH);
+        if (result != Z_OK) {
+            break;
+        }
+    }
+
+    usize compressed_size = stream.total_out;
+    deflateEnd(&stream);
+
+    // deflateBound() leaves room for everything, so Z_FINISH completes in one call
+    if (result != Z_STREAM_END) {
+        return nullptr;
+    }
+
+    compressed.resize(compressed_size);
+    return std::make_shared<const std::vector<byte>>(std::move(compressed));
+}
+
+#ifdef HAVE_LIBDEFLATE
+// One compressor per level and thread: they are costly to set up and not thread-safe
+struct LibdeflateCompressors {
+    std::array<libdeflate_compressor*, CompressionSettings::MAX_LEVEL + 1> by_level{};
+    std::vector<u8> staging;    // libdeflate needs its input in one piece
+
+    ~LibdeflateCompressors() {
+        for (libdeflate_compressor* compressor : by_level) {
+            if (compressor) {
+                libdeflate_free_compressor(compressor);
+            }
+        }
+    }
+};
+
+static SharedBytes compress_libdeflate(std::initializer_list<std::pair<const u8*, usize>> sections,
+                                       i32 level) {
+    thread_local LibdeflateCompressors compressors;
+
+    level = clamp_level(level);
+    libdeflate_compressor*& compressor = compressors.by_level[static_cast<usize>(level)];
+    if (!compressor) {
+        compressor = libdeflate_alloc_compressor(level);
+        if (!compressor) {
+            return nullptr;
+        }
+    }
+
+    const u8* input = nullptr;
+    usize input_size = 0;
+    if (sections.size() == 1) {
+        input = sections.begin()->first;
+        input_size = sections.begin()->second;
+    } else {
+        compressors.staging.clear();
+        for (const auto& [data, size] : sections) {
+            compressors.staging.insert(compressors.staging.end(), data, data + size);
+        }
+        input = compressors.staging.data();
+        input_size = compressors.staging.size();
+    }
+
+    std::vector<byte> compressed(libdeflate_zlib_compress_bound(compressor, input_size));
+    usize compressed_size = libdeflate_zlib_compress(compressor, input, input_size,
+                                                     compressed.data(), compressed.size());
+    if (compressed_size == 0) {
+        return nullptr;
+    }
+
+    compressed.resize(compressed_size);
+    return std::make_shared<const std::vector<byte>>(std::move(compressed));
+}
+#endif
+
+const char* ChunkCompressor::engine_name(CompressionEngine engine) {
+    switch (engine) {
+        case CompressionEngine::Zlib:
+            return "zlib";
+        case CompressionEngine::Libdeflate:
+            return "libdeflate";
+    }
+    return "unknown";
+}
+
+bool ChunkCompressor::parse_engine(std::string_view name, CompressionEngine& engine) {
+    if (name == "auto") {
+        engine = is_available(CompressionEngine::Libdeflate) ? CompressionEngine::Libdeflate
+                                                             : CompressionEngine::Zlib;
+        return true;
+    }
+
+    for (CompressionEngine candidate : {CompressionEngine::Zlib, CompressionEngine::Libdeflate}) {
+        if (name == engine_name(candidate) && is_available(candidate)) {
+            engine = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ChunkCompressor::is_available(CompressionEngine engine) {
+    switch (engine) {
+        case CompressionEngine::Zlib:
+            return true;
+        case CompressionEngine::Libdeflate:
+#ifdef HAVE_LIBDEFLATE
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+SharedBytes ChunkCompressor::compress(std::initializer_list<std::pair<const u8*, usize>> sections,
+                                      const CompressionSettings& settings) {
+#ifdef HAVE_LIBDEFLATE
+    if (settings.engine == CompressionEngine::Libdeflate) {
+        return compress_libdeflate(sections, settings.level);
+    }
+#endif
+    return compress_zlib(sections, settings.level);
+}
+
+i32 AdaptiveCompressionLevel::update(f64 tick_ms, f64 budget_ms) {
+    f64 load = budget_ms > 0.0 ? tick_ms / budget_ms : 1.0;
+
+    if (load > HIGH_LOAD) {
+        quiet_ticks_ = 0;
+        level_ = std::max(min_level_, level_ - 1);
+    } else if (load < LOW_LOAD) {
+        if (++quiet_ticks_ >= RECOVERY_TICKS) {
+            quiet_ticks_ = 0;
+            level_ = std::min(max_level_, level_ + 1);
+        }
+    } else {
+        quiet_ticks_ = 0;
+    }
+    return level_;
+}
+
+} // namespace mcserver
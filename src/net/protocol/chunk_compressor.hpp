@@ -0,0 +1,74 @@
+#pragma once
+
+#include "net/protocol/packet.hpp"
+#include "util/types.hpp"
+#include <initializer_list>
+#include <string_view>
+#include <utility>
+
+namespace mcserver {
+
+// Deflate implementation used for MapChunk payloads
+// All of them produce zlib streams the Beta client inflates; libdeflate is only
+// available when it was found at build time (HAVE_LIBDEFLATE).
+enum class CompressionEngine : u8 {
+    Zlib,
+    Libdeflate
+};
+
+// How chunk payloads are compressed
+struct CompressionSettings {
+    static constexpr i32 MIN_LEVEL = 1;     // Fastest
+    static constexpr i32 MAX_LEVEL = 9;     // Smallest
+    static constexpr i32 DEFAULT_LEVEL = 6; // zlib's default
+
+    CompressionEngine engine = CompressionEngine::Zlib;
+    i32 level = DEFAULT_LEVEL;
+};
+
+// Compresses chunk data with the configured engine and level
+// Stateless apart from per-thread engine state, so safe to call from job system workers.
+class ChunkCompressor {
+public:
+    // Engine name as used in the config ("zlib", "libdeflate")
+    static const char* engine_name(CompressionEngine engine);
+
+    // Engine for a config name; "auto" picks the fastest one built in.
+    // Returns false for unknown names and engines this build doesn't have
+    static bool parse_engine(std::string_view name, CompressionEngine& engine);
+
+    // True if the engine was compiled in
+    static bool is_available(CompressionEngine engine);
+
+    // Compress the sections, in order, as one zlib stream
+    // Returns nullptr if compression fails
+    static SharedBytes compress(std::initializer_list<std::pair<const u8*, usize>> sections,
+                                const CompressionSettings& settings);
+};
+
+// Compression level that follows how much of the tick budget is left
+// Drops a level for every tick that used more than HIGH_LOAD of the budget, so
+// chunk compression gives CPU back quickly under load, and climbs back towards
+// the configured level after RECOVERY_TICKS ticks in a row under LOW_LOAD.
+class AdaptiveCompressionLevel {
+public:
+    static constexpr f64 HIGH_LOAD = 0.8;
+    static constexpr f64 LOW_LOAD = 0.5;
+    static constexpr u32 RECOVERY_TICKS = 100;
+
+    AdaptiveCompressionLevel(i32 min_level, i32 max_level)
+        : min_level_(min_level), max_level_(max_level), level_(max_level) {}
+
+    // Account for one tick and return the level to use from now on
+    i32 update(f64 tick_ms, f64 budget_ms);
+
+    i32 level() const { return level_; }
+
+private:
+    i32 min_level_;
+    i32 max_level_;
+    i32 level_;
+    u32 quiet_ticks_ = 0;
+};
+
+} // namespace mcserver
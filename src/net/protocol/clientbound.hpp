@@ -0,0 +1,226 @@
+#pragma once
+
+#include "net/protocol/packet.hpp"
+#include "net/protocol/packets/animation.hpp"
+#include "entity/mob/mob.hpp"
+#include "entity/mob/mob_metadata.hpp"
+#include "entity/player.hpp"
+#include "entity/item/item_entity.hpp"
+#include "util/types.hpp"
+#include <cmath>
+#include <span>
+#include <variant>
+
+namespace mcserver {
+
+// Encoders for the server -> client packets sent every tick
+// Each writes the ID byte and payload straight from game state into a (reused)
+// PacketWriter, so the hot entity and block update paths build no Packet object
+// and allocate nothing once the writer has grown. The Packet classes of the same
+// name produce identical bytes and remain for everything else.
+namespace clientbound {
+
+inline void write_field(PacketWriter& writer, i8 value) { writer.write_i8(value); }
+inline void write_field(PacketWriter& writer, u8 value) { writer.write_u8(value); }
+inline void write_field(PacketWriter& writer, i16 value) { writer.write_i16(value); }
+inline void write_field(PacketWriter& writer, i32 value) { writer.write_i32(value); }
+
+// Packet made only of fixed-size fields: the size is known at compile time, so the
+// writer grows at most once
+template <typename... Fields>
+inline void fixed_packet(PacketWriter& writer, PacketId id, Fields... fields) {
+    writer.reserve(1 + (sizeof(Fields) + ... + 0));
+    writer.write_u8(static_cast<u8>(id));
+    (write_field(writer, fields), ...);
+}
+
+// DataWatcher entries: (type << 5 | index) and the value, terminated by 0x7F
+inline void write_metadata(PacketWriter& writer, const MobMetadata& metadata) {
+    for (const auto& [index, entry] : metadata.get_all()) {
+        writer.write_u8(static_cast<u8>((static_cast<u8>(entry.type) << 5) | (entry.index & 0x1F)));
+
+        switch (entry.type) {
+            case MetadataType::Byte:
+                writer.write_i8(std::get<i8>(entry.value));
+                break;
+            case MetadataType::Short:
+                writer.write_i16(std::get<i16>(entry.value));
+                break;
+            case MetadataType::Int:
+                writer.write_i32(std::get<i32>(entry.value));
+                break;
+            case MetadataType::Float:
+                writer.write_f32(std::get<f32>(entry.value));
+                break;
+            case MetadataType::String:
+                writer.write_string(std::get<std::string>(entry.value));
+                break;
+            default:
+                break;
+        }
+    }
+    writer.write_i8(0x7F);
+}
+
+// Packet 53: BlockChange
+inline void block_change(PacketWriter& writer, i32 x, i8 y, i32 z, u8 block_type, u8 metadata) {
+    fixed_packet(writer, PacketId::BlockChange, x, y, z, block_type, metadata);
+}
+
+// Entity position as clients see it: 1/32 block fixed point, angles in 1/256 turn
+struct EntityPosition {
+    i32 x = 0;
+    i32 y = 0;
+    i32 z = 0;
+    i8 yaw = 0;
+    i8 pitch = 0;
+
+    static EntityPosition of(f64 x, f64 y, f64 z, f32 yaw, f32 pitch) {
+        return {static_cast<i32>(std::floor(x * 32.0)),
+                static_cast<i32>(std::floor(y * 32.0)),
+                static_cast<i32>(std::floor(z * 32.0)),
+                encode_angle(yaw), encode_angle(pitch)};
+    }
+
+    static i8 encode_angle(f32 degrees) {
+        return static_cast<i8>(static_cast<i32>(std::floor(degrees * 256.0f / 360.0f)) & 0xFF);
+    }
+
+    // Chunk the entity is in (32 units per block, 16 blocks per chunk)
+    i32 chunk_x() const { return x >> 9; }
+    i32 chunk_z() const { return z >> 9; }
+
+    bool operator==(const EntityPosition&) const = default;
+};
+
+// One block in a MultiBlockChange, addressed within its chunk
+struct LocalBlockChange {
+    u16 position;       // x << 12 | z << 8 | y
+    u8 block_type;
+    u8 metadata;
+
+    static u16 pack(i32 x, i8 y, i32 z) {
+        return static_cast<u16>(((x & 15) << 12) | ((z & 15) << 8) | static_cast<u8>(y));
+    }
+    i32 local_x() const { return position >> 12; }
+    i32 local_z() const { return (position >> 8) & 15; }
+    i8 y() const { return static_cast<i8>(position & 0xFF); }
+};
+
+// Packet 52: MultiBlockChange (all positions, then all types, then all metadata)
+inline void multi_block_change(PacketWriter& writer, i32 chunk_x, i32 chunk_z,
+                               std::span<const LocalBlockChange> changes) {
+    writer.reserve(1 + 4 + 4 + 2 + changes.size() * 4);
+    writer.write_u8(static_cast<u8>(PacketId::MultiBlockChange));
+    writer.write_i32(chunk_x);
+    writer.write_i32(chunk_z);
+    writer.write_i16(static_cast<i16>(changes.size()));
+    for (const LocalBlockChange& change : changes) {
+        writer.write_i16(static_cast<i16>(change.position));
+    }
+    for (const LocalBlockChange& change : changes) {
+        writer.write_u8(change.block_type);
+    }
+    for (const LocalBlockChange& change : changes) {
+        writer.write_u8(change.metadata);
+    }
+}
+
+// Packet 29: DestroyEntity
+inline void destroy_entity(PacketWriter& writer, i32 entity_id) {
+    fixed_packet(writer, PacketId::DestroyEntity, entity_id);
+}
+
+// Packet 18: Animation
+inline void animation(PacketWriter& writer, i32 entity_id, AnimationType animation) {
+    fixed_packet(writer, PacketId::Animation, entity_id, static_cast<i8>(animation));
+}
+
+// Packet 38: EntityStatus (2 = hurt, 3 = dead)
+inline void entity_status(PacketWriter& writer, i32 entity_id, i8 status) {
+    fixed_packet(writer, PacketId::EntityStatus, entity_id, status);
+}
+
+// Packet 22: Collect
+inline void collect(PacketWriter& writer, i32 collected_entity_id, i32 collector_entity_id) {
+    fixed_packet(writer, PacketId::Collect, collected_entity_id, collector_entity_id);
+}
+
+// Packet 31: RelEntityMove (deltas in 1/32 block)
+inline void entity_relative_move(PacketWriter& writer, i32 entity_id, i8 dx, i8 dy, i8 dz) {
+    fixed_packet(writer, PacketId::RelEntityMove, entity_id, dx, dy, dz);
+}
+
+// Packet 32: EntityLook (angles in 1/256 turn)
+inline void entity_look(PacketWriter& writer, i32 entity_id, i8 yaw, i8 pitch) {
+    fixed_packet(writer, PacketId::EntityLook, entity_id, yaw, pitch);
+}
+
+// Packet 34: EntityTeleport (absolute position and angles)
+inline void entity_teleport(PacketWriter& writer, i32 entity_id, const EntityPosition& position) {
+    fixed_packet(writer, PacketId::EntityTeleport, entity_id, position.x, position.y, position.z,
+                 position.yaw, position.pitch);
+}
+
+// Packet 33: RelEntityMoveLook (deltas in 1/32 block, angles in 1/256 turn)
+inline void entity_look_move(PacketWriter& writer, i32 entity_id, i8 dx, i8 dy, i8 dz,
+                             i8 yaw, i8 pitch) {
+    fixed_packet(writer, PacketId::RelEntityMoveLook, entity_id, dx, dy, dz, yaw, pitch);
+}
+
+// Packet 24: MobSpawn, at the position clients are tracking the mob at
+inline void mob_spawn(PacketWriter& writer, const Mob& mob, const EntityPosition& position) {
+    fixed_packet(writer, PacketId::MobSpawn,
+                 mob.get_entity_id(),
+                 static_cast<i8>(mob.get_mob_type()),
+                 position.x, position.y, position.z, position.yaw, position.pitch);
+    write_metadata(writer, *mob.get_metadata());
+}
+
+// Packet 24: MobSpawn, at the mob's current position
+inline void mob_spawn(PacketWriter& writer, const Mob& mob) {
+    mob_spawn(writer, mob, EntityPosition::of(mob.get_x(), mob.get_y(), mob.get_z(),
+                                              mob.get_yaw(), mob.get_pitch()));
+}
+
+// Packet 20: NamedEntitySpawn, at the position clients are tracking the player at
+inline void named_entity_spawn(PacketWriter& writer, const Player& player,
+                               const EntityPosition& position, i16 current_item) {
+    const std::string& name = player.get_username();
+    writer.reserve(1 + 4 + 2 + name.length() * 2 + 12 + 2 + 2);
+    writer.write_u8(static_cast<u8>(PacketId::NamedEntitySpawn));
+    writer.write_i32(player.get_entity_id());
+    writer.write_string(name);
+    writer.write_i32(position.x);
+    writer.write_i32(position.y);
+    writer.write_i32(position.z);
+    writer.write_i8(position.yaw);
+    writer.write_i8(position.pitch);
+    writer.write_i16(current_item);
+}
+
+// Packet 20: NamedEntitySpawn, at the player's current position
+inline void named_entity_spawn(PacketWriter& writer, const Player& player, i16 current_item) {
+    named_entity_spawn(writer, player,
+                       EntityPosition::of(player.get_x(), player.get_y(), player.get_z(),
+                                          player.get_yaw(), player.get_pitch()),
+                       current_item);
+}
+
+// Packet 21: PickupSpawn (no rotation)
+inline void pickup_spawn(PacketWriter& writer, const ItemEntity& item) {
+    const ItemStack* stack = item.get_item();
+    fixed_packet(writer, PacketId::PickupSpawn,
+                 item.get_entity_id(),
+                 stack->get_item_id(),
+                 stack->get_count(),
+                 stack->get_damage(),
+                 static_cast<i32>(item.get_x() * 32.0),
+                 static_cast<i32>(item.get_y() * 32.0),
+                 static_cast<i32>(item.get_z() * 32.0),
+                 i8{0}, i8{0}, i8{0});
+}
+
+} // namespace clientbound
+
+} // namespace mcserver
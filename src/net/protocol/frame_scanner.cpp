@@ -0,0 +1,107 @@
+#include "frame_scanner.hpp"
+#include <array>
+
+namespace mcserver {
+
+static constexpr FrameLayout fixed(u16 size) {
+    return {FrameRule::Fixed, size, 0, 0};
+}
+
+static constexpr FrameLayout string(u16 prefix, u16 max_chars, u16 suffix) {
+    return {FrameRule::String, prefix, suffix, max_chars};
+}
+
+static constexpr FrameLayout optional_item(u16 prefix) {
+    return {FrameRule::OptionalItem, prefix, 0, 0};
+}
+
+static constexpr std::array<FrameLayout, 256> build_layouts() {
+    std::array<FrameLayout, 256> layouts{};
+    auto at = [&layouts](PacketId id) -> FrameLayout& { return layouts[static_cast<u8>(id)]; };
+
+    // Limits match the max_length the packet readers pass to read_string
+    at(PacketId::KeepAlive)       = fixed(0);
+    at(PacketId::Login)           = string(4, 16, 9);      // protocol | username | seed, dimension
+    at(PacketId::Handshake)       = string(0, 32, 0);      // username
+    at(PacketId::Chat)            = string(0, 119, 0);     // message
+    at(PacketId::UseEntity)       = fixed(9);              // user, target, left click
+    at(PacketId::Flying)          = fixed(1);              // on ground
+    at(PacketId::PlayerPosition)  = fixed(33);             // x, y, stance, z, on ground
+    at(PacketId::PlayerLook)      = fixed(9);              // yaw, pitch, on ground
+    at(PacketId::PlayerLookMove)  = fixed(41);             // x, y, stance, z, yaw, pitch, on ground
+    at(PacketId::BlockDig)        = fixed(11);             // status, x, y, z, face
+    at(PacketId::Place)           = optional_item(10);     // x, y, z, direction | item
+    at(PacketId::BlockItemSwitch) = fixed(2);              // slot
+    at(PacketId::Animation)       = fixed(5);              // entity, animation
+    at(PacketId::EntityAction)    = fixed(5);              // entity, action
+    at(PacketId::WindowClick)     = optional_item(7);      // window, slot, right, action, shift | item
+    at(PacketId::CloseWindow)     = fixed(1);              // window
+    return layouts;
+}
+
+// Serverbound length rules, indexed by packet ID
+static constexpr std::array<FrameLayout, 256> FRAME_LAYOUTS = build_layouts();
+
+static i16 read_i16_at(ConstByteSpan data, usize offset) {
+    return static_cast<i16>((static_cast<u16>(data[offset]) << 8) |
+                             static_cast<u16>(data[offset + 1]));
+}
+
+static FrameInfo complete_if_buffered(ConstByteSpan data, usize frame_size) {
+    if (data.size() >= frame_size) {
+        return {FrameStatus::Complete, frame_size};
+    }
+    return {FrameStatus::Incomplete, frame_size};
+}
+
+const FrameLayout& FrameScanner::layout(u8 packet_id) {
+    return FRAME_LAYOUTS[packet_id];
+}
+
+FrameInfo FrameScanner::scan(ConstByteSpan data) {
+    if (data.empty()) {
+        return {FrameStatus::Incomplete, 1};
+    }
+
+    const FrameLayout& frame = layout(static_cast<u8>(data[0]));
+
+    // Offset of the variable field's length, right after ID + prefix
+    usize field = 1 + frame.prefix;
+
+    switch (frame.rule) {
+        case FrameRule::Unknown:
+            return {FrameStatus::UnknownPacket, 0};
+
+        case FrameRule::Fixed:
+            return complete_if_buffered(data, field);
+
+        case FrameRule::String: {
+            if (data.size() < field + 2) {
+                return {FrameStatus::Incomplete, field + 2 + frame.suffix};
+            }
+
+            i16 chars = read_i16_at(data, field);
+            if (chars < 0 || chars > frame.max_string) {
+                return {FrameStatus::Malformed, 0};
+            }
+
+            // UTF-16: two bytes per character
+            return complete_if_buffered(data, field + 2 + static_cast<usize>(chars) * 2 + frame.suffix);
+        }
+
+        case FrameRule::OptionalItem: {
+            if (data.size() < field + 2) {
+                return {FrameStatus::Incomplete, field + 2 + frame.suffix};
+            }
+
+            // Count (i8) and damage (i16) follow unless the slot is empty
+            i16 item_id = read_i16_at(data, field);
+            usize item_size = (item_id != -1) ? 5 : 2;
+            return complete_if_buffered(data, field + item_size + frame.suffix);
+        }
+    }
+
+    return {FrameStatus::UnknownPacket, 0};
+}
+
+} // namespace mcserver
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "net/protocol/packet.hpp"
+#include "util/types.hpp"
+#include "util/span_util.hpp"
+
+namespace mcserver {
+
+// How the payload length (bytes after the ID) of a serverbound packet is found
+enum class FrameRule : u8 {
+    Unknown,        // Not accepted from clients
+    Fixed,          // 'prefix' bytes
+    String,         // 'prefix' bytes, UTF-16 string (i16 length), 'suffix' bytes
+    OptionalItem    // 'prefix' bytes, i16 item ID (+ i8 count, i16 damage unless -1), 'suffix' bytes
+};
+
+struct FrameLayout {
+    FrameRule rule = FrameRule::Unknown;
+    u16 prefix = 0;
+    u16 suffix = 0;
+    u16 max_string = 0;    // String rule: longest accepted string in characters
+};
+
+enum class FrameStatus {
+    Complete,       // 'size' is the whole frame, ID byte included
+    Incomplete,     // 'size' is the frame size known so far; don't rescan before it is buffered
+    UnknownPacket,  // ID is not accepted from clients
+    Malformed       // Length field out of range
+};
+
+struct FrameInfo {
+    FrameStatus status;
+    usize size;
+};
+
+// Determines where the next serverbound frame ends without decoding it
+// Every Beta 1.7.3 client packet either has a fixed size or a single variable
+// field (a string or an optional item stack), so a table lookup plus at most
+// one length read is enough. Only complete frames reach the decoders.
+class FrameScanner {
+public:
+    static FrameInfo scan(ConstByteSpan data);
+
+    // Length rule for a packet ID (FrameRule::Unknown if clients may not send it)
+    static const FrameLayout& layout(u8 packet_id);
+};
+
+} // namespace mcserver
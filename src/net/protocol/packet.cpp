@@ -4,84 +4,81 @@
 
 namespace mcserver {
 
-PacketBuffer::PacketBuffer(std::vector<byte> data)
-    : data_(std::move(data)), position_(0) {}
-
-bool PacketBuffer::ensure_available(usize bytes) {
-    return position_ + bytes <= data_.size();
-}
-
-Result<u8> PacketBuffer::read_u8() {
+Result<u8> PacketReader::read_u8() {
     if (!ensure_available(1)) {
         return ErrorCode::ParseError;
     }
-    u8 value = static_cast<u8>(data_[position_++]);
+    const byte* bytes = data_.data();
+    u8 value = static_cast<u8>(bytes[position_++]);
     return value;
 }
 
-Result<i8> PacketBuffer::read_i8() {
+Result<i8> PacketReader::read_i8() {
     auto result = read_u8();
     if (!result) return result.error();
     return static_cast<i8>(result.value());
 }
 
-Result<u16> PacketBuffer::read_u16() {
+Result<u16> PacketReader::read_u16() {
     if (!ensure_available(2)) {
         return ErrorCode::ParseError;
     }
-    u16 value = (static_cast<u16>(data_[position_]) << 8) |
-                 static_cast<u16>(data_[position_ + 1]);
+    const byte* bytes = data_.data();
+    u16 value = (static_cast<u16>(bytes[position_]) << 8) |
+                 static_cast<u16>(bytes[position_ + 1]);
     position_ += 2;
     return value;
 }
 
-Result<i16> PacketBuffer::read_i16() {
+Result<i16> PacketReader::read_i16() {
     auto result = read_u16();
     if (!result) return result.error();
     return static_cast<i16>(result.value());
 }
 
-Result<u32> PacketBuffer::read_u32() {
+Result<u32> PacketReader::read_u32() {
     if (!ensure_available(4)) {
         return ErrorCode::ParseError;
     }
-    u32 value = (static_cast<u32>(data_[position_]) << 24) |
-                (static_cast<u32>(data_[position_ + 1]) << 16) |
-                (static_cast<u32>(data_[position_ + 2]) << 8) |
-                 static_cast<u32>(data_[position_ + 3]);
+    const byte* bytes = data_.data();
+    u32 value = (static_cast<u32>(bytes[position_]) << 24) |
+                (static_cast<u32>(bytes[position_ + 1]) << 16) |
+                (static_cast<u32>(bytes[position_ + 2]) << 8) |
+                 static_cast<u32>(bytes[position_ + 3]);
     position_ += 4;
     return value;
 }
 
-Result<i32> PacketBuffer::read_i32() {
+Result<i32> PacketReader::read_i32() {
     auto result = read_u32();
     if (!result) return result.error();
     return static_cast<i32>(result.value());
 }
 
-Result<u64> PacketBuffer::read_u64() {
+Result<u64> PacketReader::read_u64() {
     if (!ensure_available(8)) {
         return ErrorCode::ParseError;
     }
-    u64 value = (static_cast<u64>(data_[position_]) << 56) |
-                (static_cast<u64>(data_[position_ + 1]) << 48) |
-                (static_cast<u64>(data_[position_ + 2]) << 40) |
-                (static_cast<u64>(data_[position_ + 3]) << 32) |
-                (static_cast<u64>(data_[position_ + 4]) << 24) |
-                (static_cast<u64>(data_[position_ + 5]) << 16) |
-                (static_cast<u64>(data_[position_ + 6]) << 8) |
-                 static_cast<u64>(data_[position_ + 7]);
+    const byte* bytes = data_.data();
+    u64 value = (static_cast<u64>(bytes[position_]) << 56) |
+                (static_cast<u64>(bytes[position_ + 1]) << 48) |
+                (static_cast<u64>(bytes[position_ + 2]) << 40) |
+                (static_cast<u64>(bytes[position_ + 3]) << 32) |
+                (static_cast<u64>(bytes[position_ + 4]) << 24) |
+                (static_cast<u64>(bytes[position_ + 5]) << 16) |
+                (static_cast<u64>(bytes[position_ + 6]) << 8) |
+                 static_cast<u64>(bytes[position_ + 7]);
     position_ += 8;
     return value;
 }
 
-Result<i64> PacketBuffer::read_i64() {
+Result<i64> PacketReader::read_i64() {
     auto result = read_u64();
     if (!result) return result.error();
     return static_cast<i64>(result.value());
 }
 
-Result<f32> PacketBuffer::read_f32() {
+Result<f32> PacketReader::read_f32() {
     auto result = read_u32();
     if (!result) return result.error();
     f32 value;
@@ -89,7 +86,7 @@ Result<f32> PacketBuffer::read_f32() {
     return value;
 }
 
-Result<f64> PacketBuffer::read_f64() {
+Result<f64> PacketReader::read_f64() {
     auto result = read_u64();
     if (!result) return result.error();
     f64 value;
@@ -97,13 +94,13 @@ Result<f64> PacketBuffer::read_f64() {
     return value;
 }
 
-Result<bool> PacketBuffer::read_bool() {
+Result<bool> PacketReader::read_bool() {
     auto result = read_u8();
     if (!result) return result.error();
     return result.value() != 0;
 }
 
-Result<std::string> PacketBuffer::read_string(usize max_length) {
+Result<std::string> PacketReader::read_string(usize max_length) {
     auto length_result = read_i16();
     if (!length_result) {
         return length_result.error();
@@ -123,13 +120,14 @@ Result<std::string> PacketBuffer::read_string(usize max_length) {
     if (!ensure_available(bytes_needed)) {
         return ErrorCode::ParseError;
     }
+    const byte* bytes = data_.data();
 
     std::string result;
     result.reserve(length);
 
     for (i16 i = 0; i < length; ++i) {
-        u16 ch = (static_cast<u16>(data_[position_]) << 8) |
-                  static_cast<u16>(data_[position_ + 1]);
+        u16 ch = (static_cast<u16>(bytes[position_]) << 8) |
+                  static_cast<u16>(bytes[position_ + 1]);
         position_ += 2;
 
         // Simple conversion (ASCII only for now, proper UTF-16 would be more complex)
@@ -143,76 +141,151 @@ Result<std::string> PacketBuffer::read_string(usize max_length) {
     return result;
 }
 
-void PacketBuffer::write_u8(u8 value) {
+Result<ConstByteSpan> PacketReader::read_bytes(usize size) {
+    if (!ensure_available(size)) {
+        return ErrorCode::ParseError;
+    }
+    ConstByteSpan bytes = data_.subspan(position_, size);
+    position_ += size;
+    return bytes;
+}
+
+PacketWriter::PacketWriter(usize capacity) {
+    data_.reserve(capacity);
+}
+
+byte* PacketWriter::grow(usize size) {
+    usize offset = data_.size();
+    data_.resize(offset + size);
+    return data_.data() + offset;
+}
+
+void PacketWriter::write_u8(u8 value) {
     data_.push_back(static_cast<byte>(value));
 }
 
-void PacketBuffer::write_i8(i8 value) {
+void PacketWriter::write_i8(i8 value) {
     write_u8(static_cast<u8>(value));
 }
 
-void PacketBuffer::write_u16(u16 value) {
-    data_.push_back(static_cast<byte>(value >> 8));
-    data_.push_back(static_cast<byte>(value & 0xFF));
+void PacketWriter::write_u16(u16 value) {
+    byte* out = grow(2);
+    out[0] = static_cast<byte>(value >> 8);
+    out[1] = static_cast<byte>(value & 0xFF);
 }
 
-void PacketBuffer::write_i16(i16 value) {
+void PacketWriter::write_i16(i16 value) {
     write_u16(static_cast<u16>(value));
 }
 
-void PacketBuffer::write_u32(u32 value) {
-    data_.push_back(static_cast<byte>(value >> 24));
-    data_.push_back(static_cast<byte>((value >> 16) & 0xFF));
-    data_.push_back(static_cast<byte>((value >> 8) & 0xFF));
-    data_.push_back(static_cast<byte>(value & 0xFF));
+void PacketWriter::write_u32(u32 value) {
+    byte* out = grow(4);
+    out[0] = static_cast<byte>(value >> 24);
+    out[1] = static_cast<byte>((value >> 16) & 0xFF);
+    out[2] = static_cast<byte>((value >> 8) & 0xFF);
+    out[3] = static_cast<byte>(value & 0xFF);
 }
 
-void PacketBuffer::write_i32(i32 value) {
+void PacketWriter::write_i32(i32 value) {
     write_u32(static_cast<u32>(value));
 }
 
-void PacketBuffer::write_u64(u64 value) {
-    data_.push_back(static_cast<byte>(value >> 56));
-    data_.push_back(static_cast<byte>((value >> 48) & 0xFF));
-    data_.push_back(static_cast<byte>((value >> 40) & 0xFF));
-    data_.push_back(static_cast<byte>((value >> 32) & 0xFF));
-    data_.push_back(static_cast<byte>((value >> 24) & 0xFF));
-    data_.push_back(static_cast<byte>((value >> 16) & 0xFF));
-    data_.push_back(static_cast<byte>((value >> 8) & 0xFF));
-    data_.push_back(static_cast<byte>(value & 0xFF));
+void PacketWriter::write_u64(u64 value) {
+    byte* out = grow(8);
+    for (usize i = 0; i < 8; ++i) {
+        out[i] = static_cast<byte>((value >> (56 - i * 8)) & 0xFF);
+    }
 }
 
-void PacketBuffer::write_i64(i64 value) {
+void PacketWriter::write_i64(i64 value) {
     write_u64(static_cast<u64>(value));
 }
 
-void PacketBuffer::write_f32(f32 value) {
+void PacketWriter::write_f32(f32 value) {
     u32 bits;
     std::memcpy(&bits, &value, sizeof(f32));
     write_u32(bits);
 }
 
-void PacketBuffer::write_f64(f64 value) {
+void PacketWriter::write_f64(f64 value) {
     u64 bits;
     std::memcpy(&bits, &value, sizeof(f64));
     write_u64(bits);
 }
 
-void PacketBuffer::write_bool(bool value) {
+void PacketWriter::write_bool(bool value) {
     write_u8(value ? 1 : 0);
 }
 
-void PacketBuffer::write_string(const std::string& str) {
+void PacketWriter::write_string(const std::string& str) {
     if (str.length() > 32767) {
         return; // String too long, should return error
     }
 
-    write_i16(static_cast<i16>(str.length()));
+    // Beta 1.7.3 uses UTF-16 encoding (2 bytes per character), length in characters
+    byte* out = grow(2 + str.length() * 2);
+    out[0] = static_cast<byte>(str.length() >> 8);
+    out[1] = static_cast<byte>(str.length() & 0xFF);
+    out += 2;
 
-    // Beta 1.7.3 uses UTF-16 encoding (2 bytes per character)
     for (char ch : str) {
-        write_u16(static_cast<u16>(static_cast<unsigned char>(ch)));
+        out[0] = byte{0};
+        out[1] = static_cast<byte>(ch);
+        out += 2;
+    }
+}
+
+void PacketWriter::write_bytes(ConstByteSpan bytes) {
+    data_.insert(data_.end(), bytes.begin(), bytes.end());
+}
+
+void PacketWriter::attach(SharedBytes bytes) {
+    if (!bytes || bytes->empty()) {
+        return;
+    }
+    attached_size_ += bytes->size();
+    attachments_.push_back(Attachment{data_.size(), std::move(bytes)});
+}
+
+std::vector<byte> PacketWriter::take_flat() {
+    if (attachments_.empty()) {
+        return std::move(data_);
+    }
+
+    std::vector<byte> flat;
+    flat.reserve(size());
+
+    usize offset = 0;
+    for (const auto& attachment : attachments_) {
+        flat.insert(flat.end(), data_.begin() + static_cast<isize>(offset),
+                    data_.begin() + static_cast<isize>(attachment.offset));
+        flat.insert(flat.end(), attachment.bytes->begin(), attachment.bytes->end());
+        offset = attachment.offset;
+    }
+    flat.insert(flat.end(), data_.begin() + static_cast<isize>(offset), data_.end());
+
+    clear();
+    return flat;
+}
+
+void PacketWriter::clear() {
+    data_.clear();
+    attachments_.clear();
+    attached_size_ = 0;
+}
+
+Result<void> Packet::encode(PacketWriter& writer) const {
+    writer.reserve(estimated_size() + 1);
+    writer.write_u8(static_cast<u8>(get_id()));
+    return write(writer);
+}
+
+EncodedPacket Packet::encode() const {
+    PacketWriter writer;
+    if (!encode(writer)) {
+        return nullptr;
     }
+    return std::make_shared<const std::vector<byte>>(writer.take_flat());
 }
 
 } // namespace mcserver
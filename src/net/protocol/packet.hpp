@@ -70,12 +70,15 @@ enum class PacketId : u8 {
     Kick = 255
 };
 
-// Packet reader/writer for Beta 1.7.3 format
-class PacketBuffer {
+// Immutable, ref-counted bytes shared between packets and sessions
+using SharedBytes = std::shared_ptr<const std::vector<byte>>;
+
+// Reads Beta 1.7.3 fields from bytes owned elsewhere (e.g. a receive buffer)
+// Nothing is copied, so the bytes must outlive the reader
+class PacketReader {
 public:
-    explicit PacketBuffer(std::vector<byte> data = {});
+    explicit PacketReader(ConstByteSpan data) : data_(data) {}
 
-    // Read operations
     Result<u8> read_u8();
     Result<i8> read_i8();
     Result<u16> read_u16();
@@ -89,7 +92,35 @@ public:
     Result<bool> read_bool();
     Result<std::string> read_string(usize max_length = 32767);
 
-    // Write operations
+    // The next 'size' bytes, without copying
+    Result<ConstByteSpan> read_bytes(usize size);
+
+    usize size() const { return data_.size(); }
+    usize position() const { return position_; }
+    usize remaining() const { return data_.size() - position_; }
+
+private:
+    ConstByteSpan data_;
+    usize position_ = 0;
+
+    bool ensure_available(usize bytes) const { return bytes <= data_.size() - position_; }
+};
+
+// Builds an outgoing packet in Beta 1.7.3 format
+// Reserve the packet's estimated_size() up front so encoding never reallocates.
+// Large payloads that are already shared (e.g. compressed chunk data) are attached
+// by reference instead of copied; the outbound queue sends them as their own
+// segment between the bytes written before and after them.
+class PacketWriter {
+public:
+    // Shared payload that belongs 'offset' bytes into data()
+    struct Attachment {
+        usize offset;
+        SharedBytes bytes;
+    };
+
+    explicit PacketWriter(usize capacity = 0);
+
     void write_u8(u8 value);
     void write_i8(i8 value);
     void write_u16(u16 value);
@@ -103,29 +134,56 @@ public:
     void write_bool(bool value);
     void write_string(const std::string& str);
 
-    // Buffer management
+    // Copy a block of bytes
+    void write_bytes(ConstByteSpan bytes);
+
+    // Reference a shared payload instead of copying it
+    void attach(SharedBytes bytes);
+
+    // Make room for 'size' more bytes
+    void reserve(usize size) { data_.reserve(data_.size() + size); }
+
+    // Written bytes; attachments are not included
     const std::vector<byte>& data() const { return data_; }
-    std::vector<byte>&& take_data() { return std::move(data_); }
-    usize size() const { return data_.size(); }
-    usize position() const { return position_; }
-    void reset_position() { position_ = 0; }
+    const std::vector<Attachment>& attachments() const { return attachments_; }
+
+    // Total size including attachments
+    usize size() const { return data_.size() + attached_size_; }
+
+    // Everything in order as one buffer (attachments are copied in)
+    std::vector<byte> take_flat();
+
+    // Drop the contents but keep the capacity, for reuse
+    void clear();
 
 private:
     std::vector<byte> data_;
-    usize position_ = 0;
+    std::vector<Attachment> attachments_;
+    usize attached_size_ = 0;
 
-    bool ensure_available(usize bytes);
+    // Extend by 'size' bytes and return where they start
+    byte* grow(usize size);
 };
 
+// Immutable encoded packet (ID byte + payload)
+// Ref-counted so one encoding can be queued on any number of sessions
+using EncodedPacket = SharedBytes;
+
 // Base packet class
 class Packet {
 public:
     virtual ~Packet() = default;
 
     virtual PacketId get_id() const = 0;
-    virtual Result<void> read(PacketBuffer& buffer) = 0;
-    virtual Result<void> write(PacketBuffer& buffer) const = 0;
+    virtual Result<void> read(PacketReader& reader) = 0;
+    virtual Result<void> write(PacketWriter& writer) const = 0;
     virtual usize estimated_size() const = 0;
+
+    // Write the ID byte and payload, reserving estimated_size() first
+    Result<void> encode(PacketWriter& writer) const;
+
+    // Serialize once for fan-out to several sessions; nullptr if writing failed
+    EncodedPacket encode() const;
 };
 
 } // namespace mcserver
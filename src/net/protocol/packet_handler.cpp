@@ -1,2 +1,237 @@
-// Placeholder implementation
-// Will be expanded in Step 2
+#include "packet_handler.hpp"
+#include "net/protocol/frame_scanner.hpp"
+#include <array>
+#include <type_traits>
+#include <utility>
+
+namespace mcserver {
+
+// ---- Field readers ----
+
+template <typename T>
+static Result<void> store(const Result<T>& result, T& field) {
+    if (!result) {
+        return result.error();
+    }
+    field = result.value();
+    return {};
+}
+
+static Result<void> read_field(PacketReader& reader, bool& field) { return store(reader.read_bool(), field); }
+static Result<void> read_field(PacketReader& reader, i8& field) { return store(reader.read_i8(), field); }
+static Result<void> read_field(PacketReader& reader, u8& field) { return store(reader.read_u8(), field); }
+static Result<void> read_field(PacketReader& reader, i16& field) { return store(reader.read_i16(), field); }
+static Result<void> read_field(PacketReader& reader, i32& field) { return store(reader.read_i32(), field); }
+static Result<void> read_field(PacketReader& reader, i64& field) { return store(reader.read_i64(), field); }
+static Result<void> read_field(PacketReader& reader, f32& field) { return store(reader.read_f32(), field); }
+static Result<void> read_field(PacketReader& reader, f64& field) { return store(reader.read_f64(), field); }
+
+// Enums are sent as their underlying integer
+template <typename E>
+    requires std::is_enum_v<E>
+static Result<void> read_field(PacketReader& reader, E& field) {
+    std::underlying_type_t<E> raw{};
+    auto result = read_field(reader, raw);
+    field = static_cast<E>(raw);
+    return result;
+}
+
+static Result<void> read_field(PacketReader& reader, serverbound::ItemSlot& item) {
+    auto result = read_field(reader, item.id);
+    if (!result || item.empty()) {
+        return result;
+    }
+    result = read_field(reader, item.count);
+    if (!result) {
+        return result;
+    }
+    return read_field(reader, item.damage);
+}
+
+// Read fields in wire order, stopping at the first one that fails
+template <typename... Fields>
+static Result<void> read_fields(PacketReader& reader, Fields&... fields) {
+    Result<void> result;
+    (void)((result = read_field(reader, fields), result.is_ok()) && ...);
+    return result;
+}
+
+static Result<void> read_string_field(PacketReader& reader, std::string& field, usize max_length) {
+    return store(reader.read_string(max_length), field);
+}
+
+// ---- Packet readers ----
+// String limits match the lengths FrameScanner accepts
+
+static Result<void> read_packet(PacketReader&, serverbound::KeepAlive&) {
+    return {};
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::Login& p) {
+    auto result = read_field(reader, p.protocol_version);
+    if (!result) {
+        return result;
+    }
+    result = read_string_field(reader, p.username, 16);
+    if (!result) {
+        return result;
+    }
+    return read_fields(reader, p.map_seed, p.dimension);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::Handshake& p) {
+    return read_string_field(reader, p.username, 32);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::Chat& p) {
+    return read_string_field(reader, p.message, 119);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::UseEntity& p) {
+    return read_fields(reader, p.user_id, p.target_id, p.left_click);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::Flying& p) {
+    return read_fields(reader, p.on_ground);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::Position& p) {
+    return read_fields(reader, p.x, p.y, p.stance, p.z, p.on_ground);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::Look& p) {
+    return read_fields(reader, p.yaw, p.pitch, p.on_ground);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::PositionLook& p) {
+    return read_fields(reader, p.x, p.y, p.stance, p.z, p.yaw, p.pitch, p.on_ground);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::BlockDig& p) {
+    return read_fields(reader, p.status, p.x, p.y, p.z, p.face);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::Place& p) {
+    return read_fields(reader, p.x, p.y, p.z, p.direction, p.item);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::BlockItemSwitch& p) {
+    return read_fields(reader, p.slot);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::Animation& p) {
+    return read_fields(reader, p.entity_id, p.animation);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::EntityAction& p) {
+    return read_fields(reader, p.entity_id, p.state);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::CloseWindow& p) {
+    return read_fields(reader, p.window_id);
+}
+
+static Result<void> read_packet(PacketReader& reader, serverbound::WindowClick& p) {
+    return read_fields(reader, p.window_id, p.slot, p.right_click, p.action_number,
+                       p.shift, p.item);
+}
+
+// ---- Dispatch table ----
+
+using DecodeFn = Result<void> (*)(PacketReader&, ServerboundPacket&);
+
+struct ServerboundEntry {
+    DecodeFn decode = nullptr;  // nullptr: not accepted from clients
+    u8 legal_states = 0;        // One bit per SessionState
+};
+
+template <typename T>
+static Result<void> decode_as(PacketReader& reader, ServerboundPacket& out) {
+    return read_packet(reader, out.emplace<T>());
+}
+
+static constexpr u8 state_bit(SessionState state) {
+    return static_cast<u8>(1u << static_cast<u8>(state));
+}
+
+template <typename T, typename... States>
+static constexpr void add(std::array<ServerboundEntry, 256>& table, States... states) {
+    table[static_cast<u8>(T::ID)] = {&decode_as<T>, static_cast<u8>((state_bit(states) | ...))};
+}
+
+static constexpr std::array<ServerboundEntry, 256> build_table() {
+    std::array<ServerboundEntry, 256> table{};
+    using namespace serverbound;
+
+    add<Handshake>(table, SessionState::Handshake);
+    add<Login>(table, SessionState::Login);
+
+    // Clients keep the connection alive while their spawn area loads
+    add<KeepAlive>(table, SessionState::LoggingIn, SessionState::Play);
+    add<Chat>(table, SessionState::Play);
+    add<UseEntity>(table, SessionState::Play);
+    add<Flying>(table, SessionState::Play);
+    add<Position>(table, SessionState::Play);
+    add<Look>(table, SessionState::Play);
+    add<PositionLook>(table, SessionState::Play);
+    add<BlockDig>(table, SessionState::Play);
+    add<Place>(table, SessionState::Play);
+    add<BlockItemSwitch>(table, SessionState::Play);
+    add<Animation>(table, SessionState::Play);
+    add<EntityAction>(table, SessionState::Play);
+    add<CloseWindow>(table, SessionState::Play);
+    add<WindowClick>(table, SessionState::Play);
+    return table;
+}
+
+// Serverbound decoders and legality, indexed by packet ID
+static constexpr std::array<ServerboundEntry, 256> SERVERBOUND_TABLE = build_table();
+
+template <usize... I>
+static constexpr bool table_covers(std::index_sequence<I...>) {
+    return ((SERVERBOUND_TABLE[static_cast<u8>(
+                 std::variant_alternative_t<I, ServerboundPacket>::ID)].decode != nullptr) && ...);
+}
+
+static_assert(table_covers(std::make_index_sequence<std::variant_size_v<ServerboundPacket>>()),
+              "every ServerboundPacket alternative needs a decoder");
+
+bool PacketHandler::accepts(u8 packet_id) {
+    return SERVERBOUND_TABLE[packet_id].decode != nullptr;
+}
+
+bool PacketHandler::is_legal(PacketId packet_id, SessionState state) {
+    return (SERVERBOUND_TABLE[static_cast<u8>(packet_id)].legal_states & state_bit(state)) != 0;
+}
+
+DecodeStatus PacketHandler::decode(ConstByteSpan data, ServerboundPacket& out, usize& frame_size) {
+    FrameInfo frame = FrameScanner::scan(data);
+    frame_size = frame.size;
+
+    switch (frame.status) {
+        case FrameStatus::Incomplete:
+            return DecodeStatus::NeedMoreData;
+        case FrameStatus::UnknownPacket:
+            return DecodeStatus::UnknownPacket;
+        case FrameStatus::Malformed:
+            return DecodeStatus::Malformed;
+        case FrameStatus::Complete:
+            break;
+    }
+
+    const ServerboundEntry& entry = SERVERBOUND_TABLE[static_cast<u8>(data[0])];
+    if (!entry.decode) {
+        return DecodeStatus::UnknownPacket;
+    }
+
+    // The reader sees exactly this frame's payload and has to use all of it
+    PacketReader reader(data.subspan(1, frame.size - 1));
+    auto read_result = entry.decode(reader, out);
+    if (!read_result || reader.remaining() != 0) {
+        return DecodeStatus::Malformed;
+    }
+
+    return DecodeStatus::Complete;
+}
+
+} // namespace mcserver
@@ -1,13 +1,35 @@
 #pragma once
 
-// Packet handler will be expanded in Step 2
-// For Step 1, packet handling is done in ClientSession
+#include "net/protocol/serverbound.hpp"
+#include "util/types.hpp"
+#include "util/span_util.hpp"
 
 namespace mcserver {
 
+// Outcome of decoding one packet from the front of a byte stream
+enum class DecodeStatus {
+    Complete,       // Packet decoded, 'frame_size' bytes can be dropped
+    NeedMoreData,   // Packet is incomplete, wait until 'frame_size' bytes are buffered
+    UnknownPacket,  // Packet ID is not accepted from clients
+    Malformed       // Length out of range, or the payload didn't match its frame
+};
+
+// Decodes client -> server packets
+// A constexpr table indexed by packet ID holds each serverbound packet's decoder
+// and the session states it is legal in. Stateless, so it is safe to use from the
+// network I/O threads; ClientSession checks legality against its own state.
 class PacketHandler {
 public:
-    // Placeholder for Step 2 expansion
+    // True if clients may send this packet ID at all
+    static bool accepts(u8 packet_id);
+
+    // True if the packet may be handled while the session is in 'state'
+    static bool is_legal(PacketId packet_id, SessionState state);
+
+    // Decode the packet (ID byte + payload) at the front of 'data'
+    // FrameScanner checks completeness first, so a partial packet is never parsed.
+    // On Complete, 'out' holds the packet and 'frame_size' the bytes it used
+    static DecodeStatus decode(ConstByteSpan data, ServerboundPacket& out, usize& frame_size);
 };
 
 } // namespace mcserver
@@ -9,32 +9,32 @@ PacketBlockChange::PacketBlockChange(i32 x, i8 y, i32 z, u8 block_type, u8 block
     , block_type(block_type)
     , block_metadata(block_metadata) {}
 
-Result<void> PacketBlockChange::read(PacketBuffer& buffer) {
-    auto x_result = buffer.read_i32();
+Result<void> PacketBlockChange::read(PacketReader& reader) {
+    auto x_result = reader.read_i32();
     if (!x_result) {
         return Result<void>(x_result.error());
     }
     x = x_result.value();
 
-    auto y_result = buffer.read_i8();
+    auto y_result = reader.read_i8();
     if (!y_result) {
         return Result<void>(y_result.error());
     }
     y = y_result.value();
 
-    auto z_result = buffer.read_i32();
+    auto z_result = reader.read_i32();
     if (!z_result) {
         return Result<void>(z_result.error());
     }
     z = z_result.value();
 
-    auto type_result = buffer.read_u8();
+    auto type_result = reader.read_u8();
     if (!type_result) {
         return Result<void>(type_result.error());
     }
     block_type = type_result.value();
 
-    auto meta_result = buffer.read_u8();
+    auto meta_result = reader.read_u8();
     if (!meta_result) {
         return Result<void>(meta_result.error());
     }
@@ -43,12 +43,12 @@ Result<void> PacketBlockChange::read(PacketBuffer& buffer) {
     return Result<void>();
 }
 
-Result<void> PacketBlockChange::write(PacketBuffer& buffer) const {
-    buffer.write_i32(x);
-    buffer.write_i8(y);
-    buffer.write_i32(z);
-    buffer.write_u8(block_type);
-    buffer.write_u8(block_metadata);
+Result<void> PacketBlockChange::write(PacketWriter& writer) const {
+    writer.write_i32(x);
+    writer.write_i8(y);
+    writer.write_i32(z);
+    writer.write_u8(block_type);
+    writer.write_u8(block_metadata);
 
     return Result<void>();
 }
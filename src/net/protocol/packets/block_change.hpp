@@ -13,8 +13,8 @@ public:
     PacketBlockChange(i32 x, i8 y, i32 z, u8 block_type, u8 block_metadata);
 
     PacketId get_id() const override { return PacketId::BlockChange; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 11; } // 4+1+4+1+1
 
     i32 x = 0;
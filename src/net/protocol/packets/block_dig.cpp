@@ -9,32 +9,32 @@ PacketBlockDig::PacketBlockDig(DigStatus status, i32 x, i8 y, i32 z, i8 face)
     , z(z)
     , face(face) {}
 
-Result<void> PacketBlockDig::read(PacketBuffer& buffer) {
-    auto status_result = buffer.read_u8();
+Result<void> PacketBlockDig::read(PacketReader& reader) {
+    auto status_result = reader.read_u8();
     if (!status_result) {
         return Result<void>(status_result.error());
     }
     status = static_cast<DigStatus>(status_result.value());
 
-    auto x_result = buffer.read_i32();
+    auto x_result = reader.read_i32();
     if (!x_result) {
         return Result<void>(x_result.error());
     }
     x = x_result.value();
 
-    auto y_result = buffer.read_i8();
+    auto y_result = reader.read_i8();
     if (!y_result) {
         return Result<void>(y_result.error());
     }
     y = y_result.value();
 
-    auto z_result = buffer.read_i32();
+    auto z_result = reader.read_i32();
     if (!z_result) {
         return Result<void>(z_result.error());
     }
     z = z_result.value();
 
-    auto face_result = buffer.read_i8();
+    auto face_result = reader.read_i8();
     if (!face_result) {
         return Result<void>(face_result.error());
     }
@@ -43,12 +43,12 @@ Result<void> PacketBlockDig::read(PacketBuffer& buffer) {
     return Result<void>();
 }
 
-Result<void> PacketBlockDig::write(PacketBuffer& buffer) const {
-    buffer.write_u8(static_cast<u8>(status));
-    buffer.write_i32(x);
-    buffer.write_i8(y);
-    buffer.write_i32(z);
-    buffer.write_i8(face);
+Result<void> PacketBlockDig::write(PacketWriter& writer) const {
+    writer.write_u8(static_cast<u8>(status));
+    writer.write_i32(x);
+    writer.write_i8(y);
+    writer.write_i32(z);
+    writer.write_i8(face);
 
     return Result<void>();
 }
@@ -23,8 +23,8 @@ public:
     PacketBlockDig(DigStatus status, i32 x, i8 y, i32 z, i8 face);
 
     PacketId get_id() const override { return PacketId::BlockDig; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 11; } // 1+4+1+4+1
 
     DigStatus status = DigStatus::Started;
@@ -4,15 +4,15 @@ namespace mcserver {
 
 PacketBlockItemSwitch::PacketBlockItemSwitch(i16 slot) : slot(slot) {}
 
-Result<void> PacketBlockItemSwitch::read(PacketBuffer& buffer) {
-    auto slot_result = buffer.read_i16();
+Result<void> PacketBlockItemSwitch::read(PacketReader& reader) {
+    auto slot_result = reader.read_i16();
     if (!slot_result) return slot_result.error();
     slot = slot_result.value();
     return Result<void>();
 }
 
-Result<void> PacketBlockItemSwitch::write(PacketBuffer& buffer) const {
-    buffer.write_i16(slot);
+Result<void> PacketBlockItemSwitch::write(PacketWriter& writer) const {
+    writer.write_i16(slot);
     return Result<void>();
 }
 
@@ -13,8 +13,8 @@ public:
     explicit PacketBlockItemSwitch(i16 slot);
 
     PacketId get_id() const override { return PacketId::BlockItemSwitch; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 2; }
 
     i16 slot = 0;  // Hotbar slot (0-8)
@@ -4,15 +4,15 @@ namespace mcserver {
 
 PacketChat::PacketChat(std::string message) : message(std::move(message)) {}
 
-Result<void> PacketChat::read(PacketBuffer& buffer) {
-    auto msg_result = buffer.read_string(119); // Max length in Beta 1.7.3
+Result<void> PacketChat::read(PacketReader& reader) {
+    auto msg_result = reader.read_string(119); // Max length in Beta 1.7.3
     if (!msg_result) return msg_result.error();
     message = msg_result.value();
     return Result<void>();
 }
 
-Result<void> PacketChat::write(PacketBuffer& buffer) const {
-    buffer.write_string(message);
+Result<void> PacketChat::write(PacketWriter& writer) const {
+    writer.write_string(message);
     return Result<void>();
 }
 
@@ -12,8 +12,8 @@ public:
     explicit PacketChat(std::string message);
 
     PacketId get_id() const override { return PacketId::Chat; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override;
 
     std::string message;
@@ -24,15 +24,15 @@ public:
         return 1; // 1 byte window_id
     }
 
-    Result<void> read(PacketBuffer& buffer) override {
-        auto wid_result = buffer.read_i8();
+    Result<void> read(PacketReader& reader) override {
+        auto wid_result = reader.read_i8();
         if (!wid_result) return wid_result.error();
         window_id = wid_result.value();
         return {};
     }
 
-    Result<void> write(PacketBuffer& buffer) const override {
-        buffer.write_i8(window_id);
+    Result<void> write(PacketWriter& writer) const override {
+        writer.write_i8(window_id);
         return {};
     }
 };
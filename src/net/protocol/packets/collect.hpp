@@ -29,21 +29,21 @@ public:
         return 8; // 4+4 = 8 bytes
     }
 
-    Result<void> read(PacketBuffer& buffer) override {
-        auto collected_result = buffer.read_i32();
+    Result<void> read(PacketReader& reader) override {
+        auto collected_result = reader.read_i32();
         if (!collected_result) return collected_result.error();
         collected_entity_id = collected_result.value();
 
-        auto collector_result = buffer.read_i32();
+        auto collector_result = reader.read_i32();
         if (!collector_result) return collector_result.error();
         collector_entity_id = collector_result.value();
 
         return {};
     }
 
-    Result<void> write(PacketBuffer& buffer) const override {
-        buffer.write_i32(collected_entity_id);
-        buffer.write_i32(collector_entity_id);
+    Result<void> write(PacketWriter& writer) const override {
+        writer.write_i32(collected_entity_id);
+        writer.write_i32(collector_entity_id);
         return {};
     }
 };
@@ -5,8 +5,8 @@ namespace mcserver {
 PacketDestroyEntity::PacketDestroyEntity(i32 entity_id)
     : entity_id(entity_id) {}
 
-Result<void> PacketDestroyEntity::read(PacketBuffer& buffer) {
-    auto entity_id_result = buffer.read_i32();
+Result<void> PacketDestroyEntity::read(PacketReader& reader) {
+    auto entity_id_result = reader.read_i32();
     if (!entity_id_result) {
         return Result<void>(entity_id_result.error());
     }
@@ -15,8 +15,8 @@ Result<void> PacketDestroyEntity::read(PacketBuffer& buffer) {
     return Result<void>();
 }
 
-Result<void> PacketDestroyEntity::write(PacketBuffer& buffer) const {
-    buffer.write_i32(entity_id);
+Result<void> PacketDestroyEntity::write(PacketWriter& writer) const {
+    writer.write_i32(entity_id);
     return Result<void>();
 }
 
@@ -13,8 +13,8 @@ public:
     explicit PacketDestroyEntity(i32 entity_id);
 
     PacketId get_id() const override { return PacketId::DestroyEntity; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 4; } // Entity ID only
 
     i32 entity_id = 0;
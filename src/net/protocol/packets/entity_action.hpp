@@ -35,21 +35,21 @@ public:
         return 5; // 1 byte ID + 4 bytes entity_id + 1 byte state
     }
 
-    Result<void> read(PacketBuffer& buffer) override {
-        auto eid_result = buffer.read_i32();
+    Result<void> read(PacketReader& reader) override {
+        auto eid_result = reader.read_i32();
         if (!eid_result) return eid_result.error();
         entity_id = eid_result.value();
 
-        auto state_result = buffer.read_i8();
+        auto state_result = reader.read_i8();
         if (!state_result) return state_result.error();
         state = static_cast<EntityActionState>(state_result.value());
 
         return {};
     }
 
-    Result<void> write(PacketBuffer& buffer) const override {
-        buffer.write_i32(entity_id);
-        buffer.write_i8(static_cast<i8>(state));
+    Result<void> write(PacketWriter& writer) const override {
+        writer.write_i32(entity_id);
+        writer.write_i8(static_cast<i8>(state));
         return {};
     }
 };
@@ -13,8 +13,8 @@ public:
     PacketEntityLook(i32 entity_id, i8 yaw, i8 pitch);
 
     PacketId get_id() const override { return PacketId::EntityLook; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 6; } // 4 + 1 + 1
 
     i32 entity_id = 0;
@@ -13,8 +13,8 @@ public:
     PacketEntityLookMove(i32 entity_id, i8 dx, i8 dy, i8 dz, i8 yaw, i8 pitch);
 
     PacketId get_id() const override { return PacketId::RelEntityMoveLook; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 9; } // 4 + 1 + 1 + 1 + 1 + 1
 
     i32 entity_id = 0;
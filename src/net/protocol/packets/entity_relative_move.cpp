@@ -8,26 +8,26 @@ PacketEntityRelativeMove::PacketEntityRelativeMove(i32 entity_id, i8 dx, i8 dy,
     , dy(dy)
     , dz(dz) {}
 
-Result<void> PacketEntityRelativeMove::read(PacketBuffer& buffer) {
-    auto entity_id_result = buffer.read_i32();
+Result<void> PacketEntityRelativeMove::read(PacketReader& reader) {
+    auto entity_id_result = reader.read_i32();
     if (!entity_id_result) {
         return Result<void>(entity_id_result.error());
     }
     entity_id = entity_id_result.value();
 
-    auto dx_result = buffer.read_i8();
+    auto dx_result = reader.read_i8();
     if (!dx_result) {
         return Result<void>(dx_result.error());
     }
     dx = dx_result.value();
 
-    auto dy_result = buffer.read_i8();
+    auto dy_result = reader.read_i8();
     if (!dy_result) {
         return Result<void>(dy_result.error());
     }
     dy = dy_result.value();
 
-    auto dz_result = buffer.read_i8();
+    auto dz_result = reader.read_i8();
     if (!dz_result) {
         return Result<void>(dz_result.error());
     }
@@ -36,11 +36,11 @@ Result<void> PacketEntityRelativeMove::read(PacketBuffer& buffer) {
     return Result<void>();
 }
 
-Result<void> PacketEntityRelativeMove::write(PacketBuffer& buffer) const {
-    buffer.write_i32(entity_id);
-    buffer.write_i8(dx);
-    buffer.write_i8(dy);
-    buffer.write_i8(dz);
+Result<void> PacketEntityRelativeMove::write(PacketWriter& writer) const {
+    writer.write_i32(entity_id);
+    writer.write_i8(dx);
+    writer.write_i8(dy);
+    writer.write_i8(dz);
 
     return Result<void>();
 }
@@ -13,8 +13,8 @@ public:
     PacketEntityRelativeMove(i32 entity_id, i8 dx, i8 dy, i8 dz);
 
     PacketId get_id() const override { return PacketId::RelEntityMove; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 7; } // 4 + 1 + 1 + 1
 
     i32 entity_id = 0;
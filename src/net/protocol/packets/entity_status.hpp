@@ -13,8 +13,8 @@ public:
     PacketEntityStatus(i32 entity_id, i8 status);
 
     PacketId get_id() const override { return PacketId::EntityStatus; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 5; }  // 4 + 1
 
     i32 entity_id = 0;
@@ -5,8 +5,8 @@ namespace mcserver {
 PacketHandshake::PacketHandshake(std::string username)
     : username(std::move(username)) {}
 
-Result<void> PacketHandshake::read(PacketBuffer& buffer) {
-    auto username_result = buffer.read_string(32);
+Result<void> PacketHandshake::read(PacketReader& reader) {
+    auto username_result = reader.read_string(32);
     if (!username_result) {
         return username_result.error();
     }
@@ -15,8 +15,8 @@ Result<void> PacketHandshake::read(PacketBuffer& buffer) {
     return Result<void>();
 }
 
-Result<void> PacketHandshake::write(PacketBuffer& buffer) const {
-    buffer.write_string(username);
+Result<void> PacketHandshake::write(PacketWriter& writer) const {
+    writer.write_string(username);
     return Result<void>();
 }
 
@@ -11,8 +11,8 @@ public:
     explicit PacketHandshake(std::string username);
 
     PacketId get_id() const override { return PacketId::Handshake; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override;
 
     std::string username;
@@ -2,15 +2,15 @@
 
 namespace mcserver {
 
-Result<void> PacketKeepAlive::read(PacketBuffer& buffer) {
+Result<void> PacketKeepAlive::read(PacketReader& reader) {
     // KeepAlive packet has no data
-    (void)buffer;
+    (void)reader;
     return Result<void>();
 }
 
-Result<void> PacketKeepAlive::write(PacketBuffer& buffer) const {
+Result<void> PacketKeepAlive::write(PacketWriter& writer) const {
     // KeepAlive packet has no data
-    (void)buffer;
+    (void)writer;
     return Result<void>();
 }
 
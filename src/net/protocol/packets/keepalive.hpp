@@ -10,8 +10,8 @@ public:
     PacketKeepAlive() = default;
 
     PacketId get_id() const override { return PacketId::KeepAlive; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 0; }
 };
 
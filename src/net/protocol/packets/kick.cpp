@@ -4,15 +4,15 @@ namespace mcserver {
 
 PacketKick::PacketKick(std::string reason) : reason(std::move(reason)) {}
 
-Result<void> PacketKick::read(PacketBuffer& buffer) {
-    auto reason_result = buffer.read_string(256);
+Result<void> PacketKick::read(PacketReader& reader) {
+    auto reason_result = reader.read_string(256);
     if (!reason_result) return reason_result.error();
     reason = reason_result.value();
     return Result<void>();
 }
 
-Result<void> PacketKick::write(PacketBuffer& buffer) const {
-    buffer.write_string(reason);
+Result<void> PacketKick::write(PacketWriter& writer) const {
+    writer.write_string(reason);
     return Result<void>();
 }
 
@@ -13,8 +13,8 @@ public:
     explicit PacketKick(std::string reason);
 
     PacketId get_id() const override { return PacketId::Kick; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override;
 
     std::string reason;
@@ -11,8 +11,8 @@ public:
     PacketLogin(std::string username, i32 protocol_version, i64 map_seed, i8 dimension);
 
     PacketId get_id() const override { return PacketId::Login; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override;
 
     i32 protocol_version = 0;
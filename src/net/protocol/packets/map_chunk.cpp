@@ -7,32 +7,32 @@ namespace mcserver {
 PacketMapChunk::PacketMapChunk(i32 x, i32 z)
     : x(x), y(0), z(z), size_x(15), size_y(127), size_z(15) {}
 
-Result<void> PacketMapChunk::read(PacketBuffer& buffer) {
-    auto x_result = buffer.read_i32();
+Result<void> PacketMapChunk::read(PacketReader& reader) {
+    auto x_result = reader.read_i32();
     if (!x_result) return x_result.error();
     x = x_result.value();
 
-    auto y_result = buffer.read_i16();
+    auto y_result = reader.read_i16();
     if (!y_result) return y_result.error();
     y = y_result.value();
 
-    auto z_result = buffer.read_i32();
+    auto z_result = reader.read_i32();
     if (!z_result) return z_result.error();
     z = z_result.value();
 
-    auto size_x_result = buffer.read_u8();
+    auto size_x_result = reader.read_u8();
     if (!size_x_result) return size_x_result.error();
     size_x = size_x_result.value();
 
-    auto size_y_result = buffer.read_u8();
+    auto size_y_result = reader.read_u8();
     if (!size_y_result) return size_y_result.error();
     size_y = size_y_result.value();
 
-    auto size_z_result = buffer.read_u8();
+    auto size_z_result = reader.read_u8();
     if (!size_z_result) return size_z_result.error();
     size_z = size_z_result.value();
 
-    auto compressed_size_result = buffer.read_i32();
+    auto compressed_size_result = reader.read_i32();
     if (!compressed_size_result) return compressed_size_result.error();
     i32 compressed_size = compressed_size_result.value();
 
@@ -41,40 +41,50 @@ Result<void> PacketMapChunk::read(PacketBuffer& buffer) {
     }
 
     // Read compressed data
-    compressed_data.resize(static_cast<usize>(compressed_size));
-    for (i32 i = 0; i < compressed_size; ++i) {
-        auto byte_result = buffer.read_u8();
-        if (!byte_result) return byte_result.error();
-        compressed_data[i] = static_cast<byte>(byte_result.value());
-    }
+    auto data_result = reader.read_bytes(static_cast<usize>(compressed_size));
+    if (!data_result) return data_result.error();
+    compressed_data = std::make_shared<const std::vector<byte>>(data_result.value().begin(),
+                                                                data_result.value().end());
+    decompressed_ = false;
 
     return Result<void>();
 }
 
-Result<void> PacketMapChunk::write(PacketBuffer& buffer) const {
-    buffer.write_i32(x);
-    buffer.write_i16(y);
-    buffer.write_i32(z);
-    buffer.write_u8(size_x);
-    buffer.write_u8(size_y);
-    buffer.write_u8(size_z);
-    buffer.write_i32(static_cast<i32>(compressed_data.size()));
-
-    // Write compressed data
-    for (byte b : compressed_data) {
-        buffer.write_u8(static_cast<u8>(b));
-    }
+Result<void> PacketMapChunk::write(PacketWriter& writer) const {
+    writer.write_i32(x);
+    writer.write_i16(y);
+    writer.write_i32(z);
+    writer.write_u8(size_x);
+    writer.write_u8(size_y);
+    writer.write_u8(size_z);
+    writer.write_i32(compressed_data ? static_cast<i32>(compressed_data->size()) : 0);
+
+    // Attached by reference, sent straight from the shared buffer
+    writer.attach(compressed_data);
 
     return Result<void>();
 }
 
 usize PacketMapChunk::estimated_size() const {
-    // 4 (x) + 2 (y) + 4 (z) + 1 (size_x) + 1 (size_y) + 1 (size_z) + 4 (compressed_size) + data
-    return 17 + compressed_data.size();
+    // 4 (x) + 2 (y) + 4 (z) + 1 (size_x) + 1 (size_y) + 1 (size_z) + 4 (compressed_size)
+    // The data itself is attached, not written into the buffer
+    return 17;
+}
+
+SharedBytes PacketMapChunk::compress_sections(const u8* blocks, const u8* metadata,
+                                              const u8* block_light, const u8* sky_light,
+                                              const CompressionSettings& settings) {
+    return ChunkCompressor::compress({
+        {blocks, BLOCKS_SIZE},
+        {metadata, METADATA_SIZE},
+        {block_light, BLOCK_LIGHT_SIZE},
+        {sky_light, SKY_LIGHT_SIZE},
+    }, settings);
 }
 
 void PacketMapChunk::set_chunk_data(const u8* blocks, const u8* metadata,
-                                    const u8* block_light, const u8* sky_light) {
+                                    const u8* block_light, const u8* sky_light,
+                                    const CompressionSettings& settings) {
     // Prepare uncompressed data buffer
     std::vector<u8> uncompressed(TOTAL_DATA_SIZE);
 
@@ -85,27 +95,56 @@ void PacketMapChunk::set_chunk_data(const u8* blocks, const u8* metadata,
     std::memcpy(uncompressed.data() + BLOCKS_SIZE + METADATA_SIZE + BLOCK_LIGHT_SIZE,
                 sky_light, SKY_LIGHT_SIZE);
 
-    // Compress using zlib
-    uLongf compressed_size = compressBound(TOTAL_DATA_SIZE);
-    compressed_data.resize(compressed_size);
+    compressed_data = compress_sections(blocks, metadata, block_light, sky_light, settings);
 
-    int result = compress(
-        reinterpret_cast<Bytef*>(compressed_data.data()),
-        &compressed_size,
-        uncompressed.data(),
-        TOTAL_DATA_SIZE
-    );
+    // Cache the uncompressed data
+    uncompressed_data_ = std::move(uncompressed);
+    decompressed_ = true;
+}
 
-    if (result == Z_OK) {
-        compressed_data.resize(compressed_size);
-    } else {
-        // Compression failed, store uncompressed (shouldn't happen)
-        compressed_data.resize(TOTAL_DATA_SIZE);
-        std::memcpy(compressed_data.data(), uncompressed.data(), TOTAL_DATA_SIZE);
+void PacketMapChunk::set_region_data(i32 chunk_x, i32 chunk_z, const ChunkBox& box,
+                                     const u8* blocks, const u8* metadata,
+                                     const u8* block_light, const u8* sky_light,
+                                     const CompressionSettings& settings) {
+    i32 min_y = box.min_y & ~1;
+    i32 max_y = box.max_y | 1;
+    i32 width = box.max_x - box.min_x + 1;
+    i32 height = max_y - min_y + 1;
+    i32 depth = box.max_z - box.min_z + 1;
+
+    x = chunk_x * CHUNK_WIDTH + box.min_x;
+    y = static_cast<i16>(min_y);
+    z = chunk_z * CHUNK_DEPTH + box.min_z;
+    size_x = static_cast<u8>(width - 1);
+    size_y = static_cast<u8>(height - 1);
+    size_z = static_cast<u8>(depth - 1);
+
+    // Same layout as a whole chunk: each array's columns for the box, x-major,
+    // then the next array
+    std::vector<u8> data(volume() * 5 / 2);
+    u8* out = data.data();
+
+    for (i32 bx = box.min_x; bx <= box.max_x; ++bx) {
+        for (i32 bz = box.min_z; bz <= box.max_z; ++bz) {
+            usize index = static_cast<usize>((bx * CHUNK_DEPTH + bz) * CHUNK_HEIGHT + min_y);
+            std::memcpy(out, blocks + index, static_cast<usize>(height));
+            out += height;
+        }
     }
 
-    // Cache the uncompressed data
-    uncompressed_data_ = std::move(uncompressed);
+    for (const u8* nibbles : {metadata, block_light, sky_light}) {
+        for (i32 bx = box.min_x; bx <= box.max_x; ++bx) {
+            for (i32 bz = box.min_z; bz <= box.max_z; ++bz) {
+                usize index = static_cast<usize>((bx * CHUNK_DEPTH + bz) * CHUNK_HEIGHT + min_y);
+                std::memcpy(out, nibbles + index / 2, static_cast<usize>(height / 2));
+                out += height / 2;
+            }
+        }
+    }
+
+    compressed_data = ChunkCompressor::compress({{data.data(), data.size()}}, settings);
+
+    uncompressed_data_ = std::move(data);
     decompressed_ = true;
 }
 
@@ -113,18 +152,22 @@ Result<void> PacketMapChunk::decompress_data() const {
     if (decompressed_) {
         return Result<void>();
     }
+    if (!compressed_data) {
+        return Result<void>(ErrorCode::ParseError);
+    }
 
-    uncompressed_data_.resize(TOTAL_DATA_SIZE);
-    uLongf uncompressed_size = TOTAL_DATA_SIZE;
+    usize expected_size = volume() * 5 / 2;
+    uncompressed_data_.resize(expected_size);
+    uLongf uncompressed_size = static_cast<uLongf>(expected_size);
 
     int result = uncompress(
         uncompressed_data_.data(),
         &uncompressed_size,
-        reinterpret_cast<const Bytef*>(compressed_data.data()),
-        static_cast<uLong>(compressed_data.size())
+        reinterpret_cast<const Bytef*>(compressed_data->data()),
+        static_cast<uLong>(compressed_data->size())
     );
 
-    if (result != Z_OK || uncompressed_size != TOTAL_DATA_SIZE) {
+    if (result != Z_OK || uncompressed_size != expected_size) {
         return Result<void>(ErrorCode::ParseError);
     }
 
@@ -145,7 +188,7 @@ Result<const u8*> PacketMapChunk::get_metadata() {
     if (!decompress_result) {
         return Result<const u8*>(decompress_result.error());
     }
-    return Result<const u8*>(uncompressed_data_.data() + BLOCKS_SIZE);
+    return Result<const u8*>(uncompressed_data_.data() + volume());
 }
 
 Result<const u8*> PacketMapChunk::get_block_light() {
@@ -153,7 +196,7 @@ Result<const u8*> PacketMapChunk::get_block_light() {
     if (!decompress_result) {
         return Result<const u8*>(decompress_result.error());
     }
-    return Result<const u8*>(uncompressed_data_.data() + BLOCKS_SIZE + METADATA_SIZE);
+    return Result<const u8*>(uncompressed_data_.data() + volume() * 3 / 2);
 }
 
 Result<const u8*> PacketMapChunk::get_sky_light() {
@@ -161,7 +204,7 @@ Result<const u8*> PacketMapChunk::get_sky_light() {
     if (!decompress_result) {
         return Result<const u8*>(decompress_result.error());
     }
-    return Result<const u8*>(uncompressed_data_.data() + BLOCKS_SIZE + METADATA_SIZE + BLOCK_LIGHT_SIZE);
+    return Result<const u8*>(uncompressed_data_.data() + volume() * 2);
 }
 
 } // namespace mcserver
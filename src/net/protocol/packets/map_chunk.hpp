@@ -1,10 +1,38 @@
 #pragma once
 
 #include "net/protocol/packet.hpp"
+#include "net/protocol/chunk_compressor.hpp"
+#include <algorithm>
 #include <vector>
 
 namespace mcserver {
 
+// Box of blocks within one chunk, in local coordinates, bounds inclusive
+// The default is the whole chunk.
+struct ChunkBox {
+    i32 min_x = 0;
+    i32 min_y = 0;
+    i32 min_z = 0;
+    i32 max_x = 15;
+    i32 max_y = 127;
+    i32 max_z = 15;
+
+    // Grow the box to contain the block
+    void include(i32 x, i32 y, i32 z) {
+        min_x = std::min(min_x, x);
+        min_y = std::min(min_y, y);
+        min_z = std::min(min_z, z);
+        max_x = std::max(max_x, x);
+        max_y = std::max(max_y, y);
+        max_z = std::max(max_z, z);
+    }
+
+    usize volume() const {
+        return static_cast<usize>(max_x - min_x + 1) * static_cast<usize>(max_y - min_y + 1) *
+               static_cast<usize>(max_z - min_z + 1);
+    }
+};
+
 // Packet 51: MapChunk
 // Sends chunk terrain data to client
 // Must be preceded by PreChunk packet with load=true
@@ -27,8 +55,8 @@ public:
     PacketMapChunk(i32 x, i32 z);
 
     PacketId get_id() const override { return PacketId::MapChunk; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override;
 
     // Set chunk data (will be compressed on write)
@@ -37,7 +65,29 @@ public:
     // block_light: 16384 bytes - 4 bits per block
     // sky_light: 16384 bytes - 4 bits per block
     void set_chunk_data(const u8* blocks, const u8* metadata,
-                       const u8* block_light, const u8* sky_light);
+                       const u8* block_light, const u8* sky_light,
+                       const CompressionSettings& settings = {});
+
+    // Set the data of just 'box' in chunk (chunk_x, chunk_z), from the chunk's full
+    // arrays, and compress it
+    // The client copies nibbles two at a time, so the box's y range is widened to
+    // start and end on even bounds.
+    void set_region_data(i32 chunk_x, i32 chunk_z, const ChunkBox& box,
+                         const u8* blocks, const u8* metadata,
+                         const u8* block_light, const u8* sky_light,
+                         const CompressionSettings& settings = {});
+
+    // Blocks covered by the packet (32768 for a whole chunk)
+    usize volume() const {
+        return static_cast<usize>(size_x + 1) * static_cast<usize>(size_y + 1) *
+               static_cast<usize>(size_z + 1);
+    }
+
+    // Compress the four sections in wire order into a shareable payload
+    // Returns nullptr if compression fails
+    static SharedBytes compress_sections(const u8* blocks, const u8* metadata,
+                                         const u8* block_light, const u8* sky_light,
+                                         const CompressionSettings& settings = {});
 
     // Get uncompressed chunk data (decompresses on first call)
     Result<const u8*> get_blocks();
@@ -45,14 +95,16 @@ public:
     Result<const u8*> get_block_light();
     Result<const u8*> get_sky_light();
 
-    i32 x = 0;          // Block X coordinate (chunk_x * 16)
-    i16 y = 0;          // Block Y coordinate (always 0 in Beta 1.7.3)
-    i32 z = 0;          // Block Z coordinate (chunk_z * 16)
-    u8 size_x = 15;     // Always 15 (16 - 1)
-    u8 size_y = 127;    // Always 127 (128 - 1)
-    u8 size_z = 15;     // Always 15 (16 - 1)
+    i32 x = 0;          // Block X coordinate (chunk_x * 16 for a whole chunk)
+    i16 y = 0;          // Block Y coordinate (0 for a whole chunk)
+    i32 z = 0;          // Block Z coordinate (chunk_z * 16 for a whole chunk)
+    u8 size_x = 15;     // Width - 1 (15 for a whole chunk)
+    u8 size_y = 127;    // Height - 1 (127 for a whole chunk)
+    u8 size_z = 15;     // Depth - 1 (15 for a whole chunk)
 
-    std::vector<byte> compressed_data;
+    // zlib-compressed block, metadata and light arrays; shared so encoding can
+    // attach it by reference instead of copying
+    SharedBytes compressed_data;
 
 private:
     // Cached uncompressed data
@@ -17,8 +17,8 @@ public:
     explicit PacketMobSpawn(const Mob* mob);
 
     PacketId get_id() const override { return PacketId::MobSpawn; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 20; }
 
     i32 entity_id = 0;
@@ -15,8 +15,8 @@ public:
                            i32 x, i32 y, i32 z, i8 yaw, i8 pitch, i16 current_item);
 
     PacketId get_id() const override { return PacketId::NamedEntitySpawn; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override {
         return 4 + 2 + player_name.length() * 2 + 4 + 4 + 4 + 1 + 1 + 2;
     }
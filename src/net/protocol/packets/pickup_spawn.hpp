@@ -55,61 +55,61 @@ public:
         return 24; // 4+2+1+2+4+4+4+1+1+1 = 24 bytes
     }
 
-    Result<void> read(PacketBuffer& buffer) override {
-        auto eid_result = buffer.read_i32();
+    Result<void> read(PacketReader& reader) override {
+        auto eid_result = reader.read_i32();
         if (!eid_result) return eid_result.error();
         entity_id = eid_result.value();
 
-        auto item_result = buffer.read_i16();
+        auto item_result = reader.read_i16();
         if (!item_result) return item_result.error();
         item_id = item_result.value();
 
-        auto count_result = buffer.read_i8();
+        auto count_result = reader.read_i8();
         if (!count_result) return count_result.error();
         count = count_result.value();
 
-        auto damage_result = buffer.read_i16();
+        auto damage_result = reader.read_i16();
         if (!damage_result) return damage_result.error();
         damage = damage_result.value();
 
-        auto x_result = buffer.read_i32();
+        auto x_result = reader.read_i32();
         if (!x_result) return x_result.error();
         x = x_result.value();
 
-        auto y_result = buffer.read_i32();
+        auto y_result = reader.read_i32();
         if (!y_result) return y_result.error();
         y = y_result.value();
 
-        auto z_result = buffer.read_i32();
+        auto z_result = reader.read_i32();
         if (!z_result) return z_result.error();
         z = z_result.value();
 
-        auto rot_result = buffer.read_i8();
+        auto rot_result = reader.read_i8();
         if (!rot_result) return rot_result.error();
         rotation = rot_result.value();
 
-        auto pitch_result = buffer.read_i8();
+        auto pitch_result = reader.read_i8();
         if (!pitch_result) return pitch_result.error();
         pitch = pitch_result.value();
 
-        auto roll_result = buffer.read_i8();
+        auto roll_result = reader.read_i8();
         if (!roll_result) return roll_result.error();
         roll = roll_result.value();
 
         return {};
     }
 
-    Result<void> write(PacketBuffer& buffer) const override {
-        buffer.write_i32(entity_id);
-        buffer.write_i16(item_id);
-        buffer.write_i8(count);
-        buffer.write_i16(damage);
-        buffer.write_i32(x);
-        buffer.write_i32(y);
-        buffer.write_i32(z);
-        buffer.write_i8(rotation);
-        buffer.write_i8(pitch);
-        buffer.write_i8(roll);
+    Result<void> write(PacketWriter& writer) const override {
+        writer.write_i32(entity_id);
+        writer.write_i16(item_id);
+        writer.write_i8(count);
+        writer.write_i16(damage);
+        writer.write_i32(x);
+        writer.write_i32(y);
+        writer.write_i32(z);
+        writer.write_i8(rotation);
+        writer.write_i8(pitch);
+        writer.write_i8(roll);
         return {};
     }
 };
@@ -13,8 +13,8 @@ public:
     PacketPlace(i32 x, i8 y, i32 z, i8 direction, i16 block_item_id, u8 amount, i16 damage);
 
     PacketId get_id() const override { return PacketId::Place; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 12; } // 4+1+4+1+2 (or more with item)
 
     i32 x = -1;      // -1 for special items
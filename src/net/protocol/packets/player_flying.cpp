@@ -4,15 +4,15 @@ namespace mcserver {
 
 PacketPlayerFlying::PacketPlayerFlying(bool on_ground) : on_ground(on_ground) {}
 
-Result<void> PacketPlayerFlying::read(PacketBuffer& buffer) {
-    auto ground_result = buffer.read_bool();
+Result<void> PacketPlayerFlying::read(PacketReader& reader) {
+    auto ground_result = reader.read_bool();
     if (!ground_result) return ground_result.error();
     on_ground = ground_result.value();
     return Result<void>();
 }
 
-Result<void> PacketPlayerFlying::write(PacketBuffer& buffer) const {
-    buffer.write_bool(on_ground);
+Result<void> PacketPlayerFlying::write(PacketWriter& writer) const {
+    writer.write_bool(on_ground);
     return Result<void>();
 }
 
@@ -13,8 +13,8 @@ public:
     explicit PacketPlayerFlying(bool on_ground);
 
     PacketId get_id() const override { return PacketId::Flying; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 1; }
 
     bool on_ground = false;
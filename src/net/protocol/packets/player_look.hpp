@@ -13,8 +13,8 @@ public:
     PacketPlayerLook(f32 yaw, f32 pitch, bool on_ground);
 
     PacketId get_id() const override { return PacketId::PlayerLook; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 9; } // 4+4+1
 
     f32 yaw = 0.0f;
@@ -13,8 +13,8 @@ public:
     PacketPlayerPosition(f64 x, f64 y, f64 stance, f64 z, bool on_ground);
 
     PacketId get_id() const override { return PacketId::PlayerPosition; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 33; } // 8+8+8+8+1
 
     f64 x = 0.0;
@@ -11,8 +11,8 @@ public:
     PacketPlayerPositionLook(f64 x, f64 y, f64 stance, f64 z, f32 yaw, f32 pitch, bool on_ground);
 
     PacketId get_id() const override { return PacketId::PlayerLookMove; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 41; }
 
     f64 x = 0.0;
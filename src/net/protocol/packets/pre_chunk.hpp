@@ -13,8 +13,8 @@ public:
     PacketPreChunk(i32 chunk_x, i32 chunk_z, bool load);
 
     PacketId get_id() const override { return PacketId::PreChunk; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 9; } // 4 + 4 + 1
 
     i32 chunk_x = 0;
@@ -13,8 +13,8 @@ public:
     PacketRespawn(i8 dimension, i8 difficulty, i8 creative_mode, i16 world_height, i64 map_seed);
 
     PacketId get_id() const override { return PacketId::Respawn; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 13; } // 1+1+1+2+8
 
     i8 dimension = 0;        // 0 = overworld, -1 = nether
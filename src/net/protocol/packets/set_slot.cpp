@@ -9,17 +9,17 @@ PacketSetSlot::PacketSetSlot(i8 window_id, i16 slot, const ItemStack* item_stack
     }
 }
 
-Result<void> PacketSetSlot::read(PacketBuffer& buffer) {
-    auto window_result = buffer.read_i8();
+Result<void> PacketSetSlot::read(PacketReader& reader) {
+    auto window_result = reader.read_i8();
     if (!window_result) return window_result.error();
     window_id = window_result.value();
 
-    auto slot_result = buffer.read_i16();
+    auto slot_result = reader.read_i16();
     if (!slot_result) return slot_result.error();
     slot = slot_result.value();
 
     // Read item stack
-    auto item_id_result = buffer.read_i16();
+    auto item_id_result = reader.read_i16();
     if (!item_id_result) return item_id_result.error();
     i16 item_id = item_id_result.value();
 
@@ -28,11 +28,11 @@ Result<void> PacketSetSlot::read(PacketBuffer& buffer) {
         item_stack = nullptr;
     } else {
         // Read count and damage
-        auto count_result = buffer.read_i8();
+        auto count_result = reader.read_i8();
         if (!count_result) return count_result.error();
         i8 count = count_result.value();
 
-        auto damage_result = buffer.read_i16();
+        auto damage_result = reader.read_i16();
         if (!damage_result) return damage_result.error();
         i16 damage = damage_result.value();
 
@@ -42,18 +42,18 @@ Result<void> PacketSetSlot::read(PacketBuffer& buffer) {
     return Result<void>();
 }
 
-Result<void> PacketSetSlot::write(PacketBuffer& buffer) const {
-    buffer.write_i8(window_id);
-    buffer.write_i16(slot);
+Result<void> PacketSetSlot::write(PacketWriter& writer) const {
+    writer.write_i8(window_id);
+    writer.write_i16(slot);
 
     if (!item_stack || item_stack->is_empty()) {
         // Empty slot
-        buffer.write_i16(-1);
+        writer.write_i16(-1);
     } else {
         // Write item data
-        buffer.write_i16(item_stack->get_item_id());
-        buffer.write_i8(item_stack->get_count());
-        buffer.write_i16(item_stack->get_damage());
+        writer.write_i16(item_stack->get_item_id());
+        writer.write_i8(item_stack->get_count());
+        writer.write_i16(item_stack->get_damage());
     }
 
     return Result<void>();
@@ -15,8 +15,8 @@ public:
     PacketSetSlot(i8 window_id, i16 slot, const ItemStack* item_stack);
 
     PacketId get_id() const override { return PacketId::SetSlot; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 8; }
 
     i8 window_id = 0;      // 0 = player inventory
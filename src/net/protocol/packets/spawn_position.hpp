@@ -11,8 +11,8 @@ public:
     PacketSpawnPosition(i32 x, i32 y, i32 z);
 
     PacketId get_id() const override { return PacketId::SpawnPosition; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 12; }
 
     i32 x = 0;
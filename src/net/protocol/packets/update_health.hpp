@@ -13,8 +13,8 @@ public:
     explicit PacketUpdateHealth(i16 health);
 
     PacketId get_id() const override { return PacketId::UpdateHealth; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 2; }
 
     i16 health = 20; // 20 = full health (10 hearts)
@@ -4,15 +4,15 @@ namespace mcserver {
 
 PacketUpdateTime::PacketUpdateTime(i64 time) : time(time) {}
 
-Result<void> PacketUpdateTime::read(PacketBuffer& buffer) {
-    auto time_result = buffer.read_i64();
+Result<void> PacketUpdateTime::read(PacketReader& reader) {
+    auto time_result = reader.read_i64();
     if (!time_result) return time_result.error();
     time = time_result.value();
     return Result<void>();
 }
 
-Result<void> PacketUpdateTime::write(PacketBuffer& buffer) const {
-    buffer.write_i64(time);
+Result<void> PacketUpdateTime::write(PacketWriter& writer) const {
+    writer.write_i64(time);
     return Result<void>();
 }
 
@@ -11,8 +11,8 @@ public:
     explicit PacketUpdateTime(i64 time);
 
     PacketId get_id() const override { return PacketId::UpdateTime; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override { return 8; }
 
     i64 time = 0;
@@ -27,26 +27,26 @@ public:
         return 9; // 4 bytes user_id + 4 bytes target_id + 1 byte left_click
     }
 
-    Result<void> read(PacketBuffer& buffer) override {
-        auto user_result = buffer.read_i32();
+    Result<void> read(PacketReader& reader) override {
+        auto user_result = reader.read_i32();
         if (!user_result) return user_result.error();
         user_id = user_result.value();
 
-        auto target_result = buffer.read_i32();
+        auto target_result = reader.read_i32();
         if (!target_result) return target_result.error();
         target_id = target_result.value();
 
-        auto click_result = buffer.read_bool();
+        auto click_result = reader.read_bool();
         if (!click_result) return click_result.error();
         left_click = click_result.value();
 
         return {};
     }
 
-    Result<void> write(PacketBuffer& buffer) const override {
-        buffer.write_i32(user_id);
-        buffer.write_i32(target_id);
-        buffer.write_bool(left_click);
+    Result<void> write(PacketWriter& writer) const override {
+        writer.write_i32(user_id);
+        writer.write_i32(target_id);
+        writer.write_bool(left_click);
         return {};
     }
 };
@@ -45,37 +45,37 @@ public:
         return 16; // Approximate size
     }
 
-    Result<void> read(PacketBuffer& buffer) override {
-        auto wid_result = buffer.read_i8();
+    Result<void> read(PacketReader& reader) override {
+        auto wid_result = reader.read_i8();
         if (!wid_result) return wid_result.error();
         window_id = wid_result.value();
 
-        auto slot_result = buffer.read_i16();
+        auto slot_result = reader.read_i16();
         if (!slot_result) return slot_result.error();
         slot = slot_result.value();
 
-        auto rc_result = buffer.read_i8();
+        auto rc_result = reader.read_i8();
         if (!rc_result) return rc_result.error();
         right_click = rc_result.value();
 
-        auto action_result = buffer.read_i16();
+        auto action_result = reader.read_i16();
         if (!action_result) return action_result.error();
         action_number = action_result.value();
 
-        auto shift_result = buffer.read_bool();
+        auto shift_result = reader.read_bool();
         if (!shift_result) return shift_result.error();
         shift = shift_result.value();
 
         // Read item stack (may be -1 for empty)
-        auto item_id_result = buffer.read_i16();
+        auto item_id_result = reader.read_i16();
         if (!item_id_result) return item_id_result.error();
         i16 item_id = item_id_result.value();
 
         if (item_id != -1) {
-            auto count_result = buffer.read_i8();
+            auto count_result = reader.read_i8();
             if (!count_result) return count_result.error();
 
-            auto damage_result = buffer.read_i16();
+            auto damage_result = reader.read_i16();
             if (!damage_result) return damage_result.error();
 
             clicked_item = std::make_unique<ItemStack>(
@@ -90,19 +90,19 @@ public:
         return {};
     }
 
-    Result<void> write(PacketBuffer& buffer) const override {
-        buffer.write_i8(window_id);
-        buffer.write_i16(slot);
-        buffer.write_i8(right_click);
-        buffer.write_i16(action_number);
-        buffer.write_bool(shift);
+    Result<void> write(PacketWriter& writer) const override {
+        writer.write_i8(window_id);
+        writer.write_i16(slot);
+        writer.write_i8(right_click);
+        writer.write_i16(action_number);
+        writer.write_bool(shift);
 
         if (clicked_item) {
-            buffer.write_i16(clicked_item->get_item_id());
-            buffer.write_i8(clicked_item->get_count());
-            buffer.write_i16(clicked_item->get_damage());
+            writer.write_i16(clicked_item->get_item_id());
+            writer.write_i8(clicked_item->get_count());
+            writer.write_i16(clicked_item->get_damage());
         } else {
-            buffer.write_i16(-1);
+            writer.write_i16(-1);
         }
 
         return {};
@@ -14,12 +14,12 @@ PacketWindowItems::PacketWindowItems(i8 window_id, const std::vector<const ItemS
     }
 }
 
-Result<void> PacketWindowItems::read(PacketBuffer& buffer) {
-    auto window_result = buffer.read_i8();
+Result<void> PacketWindowItems::read(PacketReader& reader) {
+    auto window_result = reader.read_i8();
     if (!window_result) return window_result.error();
     window_id = window_result.value();
 
-    auto count_result = buffer.read_i16();
+    auto count_result = reader.read_i16();
     if (!count_result) return count_result.error();
     i16 count = count_result.value();
 
@@ -31,7 +31,7 @@ Result<void> PacketWindowItems::read(PacketBuffer& buffer) {
     items.reserve(count);
 
     for (i16 i = 0; i < count; ++i) {
-        auto item_id_result = buffer.read_i16();
+        auto item_id_result = reader.read_i16();
         if (!item_id_result) return item_id_result.error();
         i16 item_id = item_id_result.value();
 
@@ -40,11 +40,11 @@ Result<void> PacketWindowItems::read(PacketBuffer& buffer) {
             items.push_back(std::make_unique<ItemStack>());
         } else {
             // Read count and damage
-            auto item_count_result = buffer.read_i8();
+            auto item_count_result = reader.read_i8();
             if (!item_count_result) return item_count_result.error();
             i8 item_count = item_count_result.value();
 
-            auto damage_result = buffer.read_i16();
+            auto damage_result = reader.read_i16();
             if (!damage_result) return damage_result.error();
             i16 damage = damage_result.value();
 
@@ -55,19 +55,19 @@ Result<void> PacketWindowItems::read(PacketBuffer& buffer) {
     return Result<void>();
 }
 
-Result<void> PacketWindowItems::write(PacketBuffer& buffer) const {
-    buffer.write_i8(window_id);
-    buffer.write_i16(static_cast<i16>(items.size()));
+Result<void> PacketWindowItems::write(PacketWriter& writer) const {
+    writer.write_i8(window_id);
+    writer.write_i16(static_cast<i16>(items.size()));
 
     for (const auto& item : items) {
         if (!item || item->is_empty()) {
             // Empty slot
-            buffer.write_i16(-1);
+            writer.write_i16(-1);
         } else {
             // Write item data
-            buffer.write_i16(item->get_item_id());
-            buffer.write_i8(item->get_count());
-            buffer.write_i16(item->get_damage());
+            writer.write_i16(item->get_item_id());
+            writer.write_i8(item->get_count());
+            writer.write_i16(item->get_damage());
         }
     }
 
@@ -16,8 +16,8 @@ public:
     PacketWindowItems(i8 window_id, const std::vector<const ItemStack*>& items);
 
     PacketId get_id() const override { return PacketId::WindowItems; }
-    Result<void> read(PacketBuffer& buffer) override;
-    Result<void> write(PacketBuffer& buffer) const override;
+    Result<void> read(PacketReader& reader) override;
+    Result<void> write(PacketWriter& writer) const override;
     usize estimated_size() const override {
         return 3 + items.size() * 5;  // 1 byte window + 2 bytes count + 5 bytes per item
     }
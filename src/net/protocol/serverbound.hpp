@@ -0,0 +1,175 @@
+#pragma once
+
+#include "net/protocol/packet.hpp"
+#include "net/protocol/packets/animation.hpp"
+#include "net/protocol/packets/block_dig.hpp"
+#include "net/protocol/packets/entity_action.hpp"
+#include "util/types.hpp"
+#include <string>
+#include <type_traits>
+#include <variant>
+
+namespace mcserver {
+
+// Protocol phase of a client session; decides which serverbound packets are legal
+enum class SessionState : u8 {
+    Handshake,
+    Login,
+    LoggingIn,      // Login accepted; player data and spawn chunks loading off the tick thread
+    Play,
+    Disconnected
+};
+
+// Decoded client -> server packets
+// Plain structs filled field by field from the wire, no virtual dispatch. The
+// Packet classes of the same name remain the encoders (e.g. for tests).
+namespace serverbound {
+
+// Optional item stack as sent in Place and WindowClick; count and damage are
+// only on the wire when 'id' is not -1
+struct ItemSlot {
+    i16 id = -1;
+    i8 count = 0;
+    i16 damage = 0;
+
+    bool empty() const { return id == -1; }
+};
+
+struct KeepAlive {
+    static constexpr PacketId ID = PacketId::KeepAlive;
+};
+
+struct Login {
+    static constexpr PacketId ID = PacketId::Login;
+    i32 protocol_version = 0;
+    std::string username;
+    i64 map_seed = 0;
+    i8 dimension = 0;
+};
+
+struct Handshake {
+    static constexpr PacketId ID = PacketId::Handshake;
+    std::string username;
+};
+
+struct Chat {
+    static constexpr PacketId ID = PacketId::Chat;
+    std::string message;
+};
+
+struct UseEntity {
+    static constexpr PacketId ID = PacketId::UseEntity;
+    i32 user_id = 0;
+    i32 target_id = 0;
+    bool left_click = false;    // true = attack, false = interact
+};
+
+struct Flying {
+    static constexpr PacketId ID = PacketId::Flying;
+    bool on_ground = false;
+};
+
+struct Position {
+    static constexpr PacketId ID = PacketId::PlayerPosition;
+    f64 x = 0.0;
+    f64 y = 0.0;
+    f64 stance = 0.0;
+    f64 z = 0.0;
+    bool on_ground = false;
+};
+
+struct Look {
+    static constexpr PacketId ID = PacketId::PlayerLook;
+    f32 yaw = 0.0f;
+    f32 pitch = 0.0f;
+    bool on_ground = false;
+};
+
+struct PositionLook {
+    static constexpr PacketId ID = PacketId::PlayerLookMove;
+    f64 x = 0.0;
+    f64 y = 0.0;
+    f64 stance = 0.0;
+    f64 z = 0.0;
+    f32 yaw = 0.0f;
+    f32 pitch = 0.0f;
+    bool on_ground = false;
+};
+
+struct BlockDig {
+    static constexpr PacketId ID = PacketId::BlockDig;
+    DigStatus status = DigStatus::Started;
+    i32 x = 0;
+    i8 y = 0;
+    i32 z = 0;
+    i8 face = 0;
+};
+
+struct Place {
+    static constexpr PacketId ID = PacketId::Place;
+    i32 x = -1;
+    i8 y = -1;
+    i32 z = -1;
+    i8 direction = 0;           // Face clicked (0-5: -Y, +Y, -Z, +Z, -X, +X)
+    ItemSlot item;              // Item being held
+};
+
+struct BlockItemSwitch {
+    static constexpr PacketId ID = PacketId::BlockItemSwitch;
+    i16 slot = 0;
+};
+
+struct Animation {
+    static constexpr PacketId ID = PacketId::Animation;
+    i32 entity_id = 0;
+    AnimationType animation = AnimationType::NoAnimation;
+};
+
+struct EntityAction {
+    static constexpr PacketId ID = PacketId::EntityAction;
+    i32 entity_id = 0;
+    EntityActionState state = EntityActionState::Crouch;
+};
+
+struct CloseWindow {
+    static constexpr PacketId ID = PacketId::CloseWindow;
+    i8 window_id = 0;
+};
+
+struct WindowClick {
+    static constexpr PacketId ID = PacketId::WindowClick;
+    i8 window_id = 0;           // 0 for player inventory
+    i16 slot = 0;
+    i8 right_click = 0;
+    i16 action_number = 0;
+    bool shift = false;
+    ItemSlot item;              // Item in cursor
+};
+
+} // namespace serverbound
+
+// One decoded client packet, stored by value in the inbound queues
+using ServerboundPacket = std::variant<
+    serverbound::KeepAlive,
+    serverbound::Login,
+    serverbound::Handshake,
+    serverbound::Chat,
+    serverbound::UseEntity,
+    serverbound::Flying,
+    serverbound::Position,
+    serverbound::Look,
+    serverbound::PositionLook,
+    serverbound::BlockDig,
+    serverbound::Place,
+    serverbound::BlockItemSwitch,
+    serverbound::Animation,
+    serverbound::EntityAction,
+    serverbound::CloseWindow,
+    serverbound::WindowClick>;
+
+// Packet ID of a decoded packet
+inline PacketId packet_id_of(const ServerboundPacket& packet) {
+    return std::visit([](const auto& p) { return std::decay_t<decltype(p)>::ID; }, packet);
+}
+
+} // namespace mcserver
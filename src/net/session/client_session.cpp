@@ -1,5 +1,6 @@
 #include "client_session.hpp"
 #include "net/transport/chunk_streaming_manager.hpp"
+#include "net/protocol/packet_handler.hpp"
 #include "net/protocol/packets/handshake.hpp"
 #include "net/protocol/packets/login.hpp"
 #include "net/protocol/packets/keepalive.hpp"
@@ -9,21 +10,10 @@
 #include "net/protocol/packets/map_chunk.hpp"
 #include "net/protocol/packets/chat.hpp"
 #include "net/protocol/packets/update_health.hpp"
-#include "net/protocol/packets/player_position.hpp"
-#include "net/protocol/packets/player_look.hpp"
-#include "net/protocol/packets/player_flying.hpp"
-#include "net/protocol/packets/block_dig.hpp"
-#include "net/protocol/packets/place.hpp"
-#include "net/protocol/packets/block_item_switch.hpp"
 #include "net/protocol/packets/set_slot.hpp"
 #include "net/protocol/packets/window_items.hpp"
 #include "net/protocol/packets/animation.hpp"
-#include "net/protocol/packets/entity_action.hpp"
-#include "net/protocol/packets/window_click.hpp"
-#include "net/protocol/packets/close_window.hpp"
 #include "net/protocol/packets/kick.hpp"
-#include "net/protocol/packets/use_entity.hpp"
-#include "net/protocol/packets/entity_status.hpp"
 #include "world/chunk/chunk_manager.hpp"
 #include "entity/entity_manager.hpp"
 #include "entity/mob/mob_manager.hpp"
@@ -31,7 +21,10 @@
 #include "world/block/block_manager.hpp"
 #include "storage/player/player_data_manager.hpp"
 #include "admin/admin_manager.hpp"
+#include "core/tick/tick_manager.hpp"
 #include "util/log/logger.hpp"
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 namespace mcserver {
@@ -82,7 +75,7 @@ static i32 protocol_to_internal_slot(i32 protocol_slot) {
     return -1;  // Invalid
 }
 
-ClientSession::ClientSession(Socket socket, ChunkManager* chunk_manager,
+ClientSession::ClientSession(std::shared_ptr<Connection> connection, ChunkManager* chunk_manager,
                             EntityManager* entity_manager,
                             BlockManager* block_manager,
                             MobManager* mob_manager,
@@ -92,8 +85,19 @@ ClientSession::ClientSession(Socket socket, ChunkManager* chunk_manager,
                             AdminManager* admin_manager,
                             ChatBroadcastCallback chat_callback,
                             PlayerJoinCallback join_callback,
-                            PlayerLeaveCallback leave_callback)
-    : socket_(std::move(socket))
+                            PlayerLeaveCallback leave_callback,
+                            EntityStatusCallback entity_status_callback,
+                            AnimationCallback animation_callback,
+                            usize send_budget,
+                            usize min_send_budget,
+                            const BacklogLimits& backlog_limits,
+                            const InboundLimits& inbound_limits,
+                            i64 login_timeout_ms)
+    : connection_(std::move(connection))
+    , shaper_(send_budget, min_send_budget)
+    , last_keepalive_(Clock::now())
+    , backlog_limits_(backlog_limits)
+    , last_caught_up_(Clock::now())
     , chunk_manager_(chunk_manager)
     , entity_manager_(entity_manager)
     , block_manager_(block_manager)
@@ -105,13 +109,13 @@ ClientSession::ClientSession(Socket socket, ChunkManager* chunk_manager,
     , chat_callback_(std::move(chat_callback))
     , join_callback_(std::move(join_callback))
     , leave_callback_(std::move(leave_callback))
-    , state_(SessionState::Handshake) {
-    recv_buffer_.reserve(8192);
-    send_buffer_.reserve(8192);
-
-    // Set socket to non-blocking
-    socket_.set_non_blocking(true);
-    socket_.set_tcp_nodelay(true);
+    , entity_status_callback_(std::move(entity_status_callback))
+    , animation_callback_(std::move(animation_callback))
+    , state_(SessionState::Handshake)
+    , inbound_budget_(inbound_limits)
+    , connected_at_(Clock::now())
+    , login_timeout_ms_(login_timeout_ms) {
+    inbound_packets_.reserve(64);
 }
 
 ClientSession::~ClientSession() {
@@ -126,90 +130,80 @@ ClientSession::~ClientSession() {
     disconnect();
 }
 
-void ClientSession::process() {
+u32 ClientSession::process(u32 shared_cost) {
     if (!is_connected()) {
-        return;
+        return 0;
     }
 
-    // Receive data
-    byte temp_buffer[4096];
-    auto recv_result = socket_.receive(temp_buffer, sizeof(temp_buffer));
-
-    if (recv_result) {
-        isize received = recv_result.value();
-        if (received > 0) {
-            recv_buffer_.insert(recv_buffer_.end(), temp_buffer, temp_buffer + received);
-        } else if (received == 0) {
-            // Connection closed
-            disconnect("Connection closed by client");
-            return;
-        }
-    } else if (recv_result.error() != ErrorCode::Timeout) {
-        // Real error
-        disconnect("Network error");
-        return;
+    // Only fetch more once everything held back from earlier ticks is handled;
+    // until then the connection's queue fills up and reading pauses
+    if (inbound_next_ == inbound_packets_.size()) {
+        inbound_packets_.clear();
+        inbound_next_ = 0;
+        connection_->drain_inbound(inbound_packets_);
     }
 
-    // Process packets
-    while (recv_buffer_.size() > 0) {
-        // Need at least packet ID
-        if (recv_buffer_.size() < 1) {
+    inbound_budget_.begin_tick(shared_cost);
+    while (inbound_next_ < inbound_packets_.size() && is_connected()) {
+        const auto& packet = inbound_packets_[inbound_next_];
+        PacketId packet_id = packet_id_of(packet);
+        if (!inbound_budget_.try_take(packet_id)) {
             break;
         }
+        ++inbound_next_;
 
-        u8 packet_id = static_cast<u8>(recv_buffer_[0]);
-
-        // Create packet buffer (skip the ID byte for now)
-        PacketBuffer buffer(std::vector<byte>(recv_buffer_.begin() + 1, recv_buffer_.end()));
-
-        bool packet_processed = false;
-
-        // Handle based on state
-        if (state_ == SessionState::Handshake) {
-            if (packet_id == static_cast<u8>(PacketId::Handshake)) {
-                handle_handshake(buffer);
-                packet_processed = true;
-            } else {
-                disconnect("Invalid packet in handshake state");
-                return;
+        if (!PacketHandler::is_legal(packet_id, state_)) {
+            // Sent before the login finished (e.g. early movement); there is no
+            // player to apply it to yet
+            if (state_ == SessionState::LoggingIn && PacketHandler::is_legal(packet_id, SessionState::Play)) {
+                continue;
             }
-        } else if (state_ == SessionState::Login) {
-            if (packet_id == static_cast<u8>(PacketId::Login)) {
-                handle_login(buffer);
-                packet_processed = true;
-            } else {
-                disconnect("Invalid packet in login state");
-                return;
+
+            if (state_ != SessionState::Play) {
+                disconnect("Invalid packet in " +
+                           std::string(state_ == SessionState::Handshake ? "handshake" : "login") +
+                           " state");
+                break;
             }
-        } else if (state_ == SessionState::Play) {
-            packet_processed = handle_play_packet(packet_id, buffer);
+
+            // Decoded but not handled in play state (e.g. a stray Handshake)
+            LOG_DEBUG_CAT("Unhandled packet ID: " + std::to_string(static_cast<u8>(packet_id)),
+                          LogCategory::Network);
+            continue;
         }
 
-        // Only remove bytes if packet was successfully processed
-        if (packet_processed) {
-            // Remove processed bytes (ID + consumed data)
-            usize bytes_consumed = 1 + buffer.position();
-            if (bytes_consumed <= recv_buffer_.size()) {
-                recv_buffer_.erase(recv_buffer_.begin(), recv_buffer_.begin() + bytes_consumed);
-            } else {
-                // Packet read more than available - this should never happen
-                // but if it does, it indicates a bug. Disconnect to prevent corruption.
-                disconnect("Packet buffer overflow");
-                return;
-            }
+        std::visit([this](const auto& p) { handle(p); }, packet);
+    }
+
+    // The I/O thread saw EOF, a socket error or an undecodable stream. Handle
+    // what arrived first, so a client's last packets (e.g. a chat message right
+    // before quitting) aren't lost
+    if (is_connected() && connection_->is_closed() && pending_inbound() == 0 &&
+        !connection_->has_inbound()) {
+        disconnect(connection_->close_reason());
+    }
+
+    // Connections that never get as far as logging in are dropped quietly; a
+    // flood of them shouldn't fill the log either. A login stuck loading its
+    // player data or spawn area is the server's problem and worth a warning
+    if (is_connected() && state_ != SessionState::Play &&
+        Clock::elapsed_ms(connected_at_) >= login_timeout_ms_) {
+        if (state_ == SessionState::LoggingIn) {
+            LOG_WARNING_CAT("Login of " + username_ + " timed out loading the player and spawn area",
+                            LogCategory::Network);
         } else {
-            // Packet wasn't processed (either partial or unknown)
-            // Check if this looks like an unknown packet ID (desync)
-            if (recv_buffer_.size() >= 10) {
-                // We have enough data, but packet wasn't recognized - desync!
-                disconnect("Invalid packet ID: " + std::to_string(packet_id) + " (possible desynchronization)");
-                return;
-            } else {
-                // Not enough data yet, wait for more
-                break;
-            }
+            LOG_DEBUG_CAT("Login timed out", LogCategory::Network);
         }
+        PacketKick kick_packet("Took too long to log in");
+        send_packet(kick_packet);
+        disconnect();
+    }
+
+    if (state_ == SessionState::LoggingIn) {
+        advance_login();
     }
+
+    return inbound_budget_.cost_used();
 }
 
 void ClientSession::send_packet(const Packet& packet) {
@@ -217,28 +211,97 @@ void ClientSession::send_packet(const Packet& packet) {
         return;
     }
 
-    PacketBuffer buffer;
-
-    // Write packet ID
-    buffer.write_u8(static_cast<u8>(packet.get_id()));
-
-    // Write packet data
-    auto write_result = packet.write(buffer);
+    // Encoded into a reused scratch writer; the lane copies the bytes and keeps
+    // attached payloads by reference
+    encode_buffer_.clear();
+    auto write_result = packet.encode(encode_buffer_);
     if (!write_result) {
         LOG_ERROR_CAT("Failed to serialize packet", LogCategory::Network);
         return;
     }
 
-    // Send data
-    const auto& data = buffer.data();
-    auto send_result = socket_.send(data.data(), data.size());
+    // Released to the network I/O thread by flush_output()
+    shaper_.append(traffic_class_of(packet.get_id()), encode_buffer_);
+}
+
+void ClientSession::send_encoded(const EncodedPacket& packet) {
+    if (!is_connected() || !packet || packet->empty()) {
+        return;
+    }
+
+    auto packet_id = static_cast<PacketId>((*packet)[0]);
+    shaper_.append(traffic_class_of(packet_id), packet);
+}
+
+void ClientSession::send_encoded(const PacketWriter& packet) {
+    if (!is_connected() || packet.data().empty()) {
+        return;
+    }
+
+    auto packet_id = static_cast<PacketId>(packet.data()[0]);
+    shaper_.append(traffic_class_of(packet_id), packet);
+}
+
+void ClientSession::flush_output() {
+    if (!is_connected()) {
+        return;
+    }
+
+    // Keeps the connection busy enough for the kernel to time its round trips
+    // even when the player is idle
+    if (state_ == SessionState::Play && Clock::elapsed_ms(last_keepalive_) >= KEEPALIVE_INTERVAL_MS) {
+        PacketKeepAlive keepalive;
+        send_packet(keepalive);
+        last_keepalive_ = Clock::now();
+    }
+
+    u64 bytes_sent = connection_->bytes_sent();
+    usize drained = static_cast<usize>(bytes_sent - last_bytes_sent_);
+    last_bytes_sent_ = bytes_sent;
+
+    OutboundQueue batch;
+    shaper_.release(batch, drained, connection_->queued_bytes());
+    connection_->queue_outbound(batch);
+
+    check_backlog(drained);
+}
+
+usize ClientSession::drain_rate() const {
+    return shaper_.drain_estimate() * static_cast<usize>(1000 / TickManager::TARGET_MS_PER_TICK);
+}
+
+std::vector<i32> ClientSession::take_dropped_movement() {
+    std::vector<i32> entity_ids(dropped_movement_.begin(), dropped_movement_.end());
+    std::sort(entity_ids.begin(), entity_ids.end());
+    dropped_movement_.clear();
+    return entity_ids;
+}
+
+void ClientSession::check_backlog(usize drained) {
+    // Keeping up: the socket takes data (or has none waiting) and the backlog is
+    // under the soft limit. A client trickling a few bytes through a full backlog isn't.
+    usize backlog = outbound_queue_bytes();
+    if (backlog <= backlog_limits_.soft_bytes && (drained > 0 || connection_->queued_bytes() == 0)) {
+        last_caught_up_ = Clock::now();
+    }
 
-    if (!send_result) {
-        LOG_ERROR_CAT("Failed to send packet", LogCategory::Network);
-        disconnect("Send error");
+    if (backlog >= backlog_limits_.hard_bytes) {
+        evict(std::to_string(backlog / 1024) + " KB of unread data");
+    } else if (Clock::elapsed_ms(last_caught_up_) >= backlog_limits_.stall_timeout_ms) {
+        evict("not keeping up for " + std::to_string(Clock::elapsed_ms(last_caught_up_) / 1000) +
+              " s (" + std::to_string(backlog / 1024) + " KB queued)");
     }
 }
 
+void ClientSession::evict(const std::string& reason) {
+    LOG_WARNING_CAT("Kicking slow client " + username_ + ": " + reason, LogCategory::Network);
+
+    evicted_ = true;
+    PacketKick kick_packet("Connection too slow");
+    send_packet(kick_packet);
+    disconnect("Slow client (" + reason + ")");
+}
+
 void ClientSession::disconnect(const std::string& reason) {
     if (state_ == SessionState::Disconnected) {
         return;
@@ -251,16 +314,22 @@ void ClientSession::disconnect(const std::string& reason) {
     // Mark as disconnected FIRST to prevent recursive disconnect calls
     // This stops send_packet from attempting to send during cleanup
     state_ = SessionState::Disconnected;
-    socket_.close();
+
+    // The I/O thread flushes what is already queued (e.g. a kick) and closes the socket;
+    // control traffic skips the budget, the rest is dropped
+    OutboundQueue batch;
+    shaper_.release_lane(TrafficClass::Control, batch);
+    connection_->queue_outbound(batch);
+    connection_->request_close();
 
     // Remove player from chunk streaming (this may try to send PreChunk packets, but send_packet will now bail early)
     if (chunk_streaming_manager_) {
         chunk_streaming_manager_->remove_player(this);
     }
 
-    // Despawn player from all other clients and remove from entity manager
+    // Remove from entity manager; the entity tracker despawns the player for
+    // other clients when the session is dropped
     if (player_ && entity_manager_) {
-        entity_manager_->despawn_entity_for_all(player_->get_entity_id());
         entity_manager_->remove_player(player_->get_entity_id());
     }
 
@@ -268,17 +337,21 @@ void ClientSession::disconnect(const std::string& reason) {
     if (player_ && leave_callback_) {
         leave_callback_(username_);
     }
-}
-
-void ClientSession::handle_handshake(PacketBuffer& buffer) {
-    PacketHandshake packet;
-    auto read_result = packet.read(buffer);
 
-    if (!read_result) {
-        disconnect("Failed to parse handshake");
-        return;
+    // Left while still logging in: the load job may still hold the player, but its ID is free
+    if (pending_login_) {
+        if (entity_manager_) {
+            entity_manager_->get_id_manager()->free(pending_login_->player->get_entity_id());
+        }
+        pending_login_.reset();
     }
+}
+
+usize ClientSession::outbound_queue_bytes() const {
+    return connection_->queued_bytes() + shaper_.pending_bytes();
+}
 
+void ClientSession::handle(const serverbound::Handshake& packet) {
     username_ = packet.username;
 
     LOG_INFO_CAT(std::string("Handshake from: ") + username_, LogCategory::Network);
@@ -290,18 +363,85 @@ void ClientSession::handle_handshake(PacketBuffer& buffer) {
     state_ = SessionState::Login;
 }
 
-void ClientSession::handle_login(PacketBuffer& buffer) {
-    PacketLogin packet;
-    auto read_result = packet.read(buffer);
+void ClientSession::handle(const serverbound::Login& packet) {
+    LOG_INFO_CAT(std::string("Login from: ") + packet.username, LogCategory::Network);
 
-    if (!read_result) {
-        disconnect("Failed to parse login");
+    // Check for duplicate username
+    if (entity_manager_) {
+        auto existing_players = entity_manager_->get_all_players();
+        for (const auto* existing_player : existing_players) {
+            if (existing_player->get_username() == username_) {
+                LOG_WARNING_CAT("Duplicate username detected: " + username_ + " - rejecting login", LogCategory::Network);
+                PacketKick kick_packet("A player with that name is already connected");
+                send_packet(kick_packet);
+                disconnect("Duplicate username");
+                return;
+            }
+        }
+    }
+
+    // Create player entity with unique ID from entity manager
+    i32 entity_id = 1;
+    if (entity_manager_) {
+        entity_id = entity_manager_->get_id_manager()->allocate();
+    }
+
+    // The client waits for the login response while its data and spawn area load;
+    // process() polls for them every tick
+    state_ = SessionState::LoggingIn;
+    pending_login_ = std::make_shared<PendingLogin>();
+    pending_login_->player = std::make_unique<Player>(username_, entity_id);
+
+    if (!player_data_manager_) {
+        pending_login_->loaded.store(true, std::memory_order_release);
         return;
     }
 
-    LOG_INFO_CAT(std::string("Login from: ") + packet.username, LogCategory::Network);
+    player_data_manager_->load_player_async(*pending_login_->player,
+        [pending = pending_login_, username = username_](Result<bool> load_result) {
+            if (!load_result) {
+                LOG_ERROR_CAT("Failed to load player data for " + username, LogCategory::Storage);
+            } else {
+                pending->found_data = load_result.value();
+            }
+            pending->loaded.store(true, std::memory_order_release);
+        });
+}
 
-    // Check for duplicate username
+void ClientSession::advance_login() {
+    if (!pending_login_->loaded.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // New players spawn at the origin; returning ones where they left
+    if (chunk_manager_) {
+        const Player& player = *pending_login_->player;
+        i32 center_x = 0;
+        i32 center_z = 0;
+        if (pending_login_->found_data) {
+            center_x = static_cast<i32>(std::floor(player.get_x())) >> 4;
+            center_z = static_cast<i32>(std::floor(player.get_z())) >> 4;
+        }
+
+        bool ready = true;
+        for (i32 dx = -SPAWN_AREA_RADIUS; dx <= SPAWN_AREA_RADIUS; ++dx) {
+            for (i32 dz = -SPAWN_AREA_RADIUS; dz <= SPAWN_AREA_RADIUS; ++dz) {
+                if (!chunk_manager_->is_chunk_loaded(center_x + dx, center_z + dz)) {
+                    chunk_manager_->prepare_chunk_async(center_x + dx, center_z + dz);
+                    ready = false;
+                }
+            }
+        }
+        if (!ready) {
+            return;
+        }
+    }
+
+    finish_login();
+}
+
+void ClientSession::finish_login() {
+    // Another session with this name may have finished logging in meanwhile
     if (entity_manager_) {
         auto existing_players = entity_manager_->get_all_players();
         for (const auto* existing_player : existing_players) {
@@ -315,42 +455,26 @@ void ClientSession::handle_login(PacketBuffer& buffer) {
         }
     }
 
+    bool loaded_data = pending_login_->found_data;
+    player_ = std::move(pending_login_->player);
+    pending_login_.reset();
+
     // Send login response
-    PacketLogin response(packet.username, 14, 0, 0);
+    PacketLogin response(username_, 14, 0, 0);
     send_packet(response);
 
     state_ = SessionState::Play;
 
     LOG_INFO_CAT(std::string("Client logged in: ") + username_, LogCategory::Network);
 
-    // Create player entity with unique ID from entity manager
-    i32 entity_id = 1;
-    if (entity_manager_) {
-        entity_id = entity_manager_->get_id_manager()->allocate();
-    }
-    player_ = std::make_unique<Player>(username_, entity_id);
-
-    // Try to load existing player data
-    bool loaded_data = false;
-    if (player_data_manager_) {
-        auto load_result = player_data_manager_->load_player(*player_);
-        if (!load_result) {
-            LOG_ERROR_CAT("Failed to load player data for " + username_,
-                         LogCategory::Storage);
-        } else {
-            loaded_data = load_result.value();
-        }
-    }
-
     // If no saved data, set default spawn position
     if (!loaded_data) {
         LOG_INFO_CAT("Setting default spawn position for " + username_, LogCategory::Entity);
         // Find spawn surface height at (0, 0)
         f64 spawn_y = 64.0; // Default fallback
         if (chunk_manager_) {
-            LOG_INFO_CAT("Getting spawn chunk (0, 0) for " + username_, LogCategory::Entity);
+            // Part of the spawn area, so already in memory
             Chunk* spawn_chunk = chunk_manager_->get_chunk(0, 0);
-            LOG_INFO_CAT("Got spawn chunk, searching for surface for " + username_, LogCategory::Entity);
             if (spawn_chunk) {
                 // Implement findTopSolidBlock algorithm from original Minecraft
                 // Start from top (127) and search downward for first non-air block
@@ -394,546 +518,402 @@ void ClientSession::handle_login(PacketBuffer& buffer) {
     // Send initial inventory to client
     send_full_inventory();
 
-    // Spawn existing entities for this player
-    if (entity_manager_) {
-        entity_manager_->spawn_existing_entities_for(this);
-    }
+    // Players, mobs and items in range are spawned both ways by the network
+    // manager's entity tracker once the session is in Play state
+}
 
-    // Spawn existing mobs for this player
-    if (mob_manager_) {
-        mob_manager_->spawn_existing_mobs_for(this);
+void ClientSession::handle(const serverbound::KeepAlive&) {
+    // Nothing to answer: flush_output() sends the server's own every second
+}
+
+void ClientSession::handle(const serverbound::Chat& chat) {
+    // Check if this is a command (starts with '/')
+    if (!chat.message.empty() && chat.message[0] == '/') {
+        handle_command(chat.message);
+        return;
     }
 
-    // Spawn this player to other nearby players
-    if (entity_manager_) {
-        entity_manager_->spawn_entity_for_nearby_players(player_.get(), this);
+    if (chat_callback_) {
+        // Broadcast chat message to all players
+        chat_callback_(chat.message, username_);
+        LOG_INFO_CAT(username_ + ": " + chat.message, LogCategory::General);
     }
 }
 
-bool ClientSession::handle_play_packet(u8 packet_id, PacketBuffer& buffer) {
-    PacketId pid = static_cast<PacketId>(packet_id);
+void ClientSession::handle(const serverbound::Flying& packet) {
+    if (player_) {
+        player_->set_on_ground(packet.on_ground);
+    }
+}
 
-    switch (pid) {
-        case PacketId::KeepAlive: {
-            // Echo keep-alive back
-            PacketKeepAlive response;
-            send_packet(response);
-            return true;
-        }
+void ClientSession::handle(const serverbound::Position& packet) {
+    if (player_) {
+        player_->set_position(packet.x, packet.y, packet.z);
+        player_->set_on_ground(packet.on_ground);
+    }
+}
 
-        case PacketId::Chat: {
-            PacketChat chat;
-            auto read_result = chat.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data, wait for more
-            }
+void ClientSession::handle(const serverbound::Look& packet) {
+    if (player_) {
+        player_->set_rotation(packet.yaw, packet.pitch);
+        player_->set_on_ground(packet.on_ground);
+    }
+}
 
-            // Check if this is a command (starts with '/')
-            if (!chat.message.empty() && chat.message[0] == '/') {
-                handle_command(chat.message);
-                return true;
-            }
+void ClientSession::handle(const serverbound::PositionLook& packet) {
+    // This is packet 13 - already handled as PlayerPositionLook
+    if (player_) {
+        player_->set_position(packet.x, packet.y, packet.z);
+        player_->set_rotation(packet.yaw, packet.pitch);
+        player_->set_on_ground(packet.on_ground);
+    }
+}
 
-            if (chat_callback_) {
-                // Broadcast chat message to all players
-                chat_callback_(chat.message, username_);
-                LOG_INFO_CAT(username_ + ": " + chat.message, LogCategory::General);
+void ClientSession::handle(const serverbound::BlockDig& packet) {
+    if (block_manager_) {
+        // Only handle finished digging for now
+        if (packet.status == DigStatus::Finished) {
+            auto result = block_manager_->break_block(packet.x, packet.y, packet.z);
+            if (!result) {
+                LOG_DEBUG_CAT("Failed to break block at (" +
+                             std::to_string(packet.x) + ", " +
+                             std::to_string(packet.y) + ", " +
+                             std::to_string(packet.z) + ")",
+                             LogCategory::World);
             }
-            return true;
         }
+    }
+}
 
-        case PacketId::Flying: {
-            PacketPlayerFlying packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
-            }
-            if (player_) {
-                player_->set_on_ground(packet.on_ground);
+void ClientSession::handle(const serverbound::Place& packet) {
+    if (block_manager_ && player_) {
+        // Only handle block placement (not items)
+        if (packet.item.id > 0 && packet.item.id < 256) {
+            // Calculate placement position based on clicked face
+            i32 place_x = packet.x;
+            i8 place_y = packet.y;
+            i32 place_z = packet.z;
+
+            // Adjust position based on face clicked
+            switch (packet.direction) {
+                case 0: place_y--; break; // -Y
+                case 1: place_y++; break; // +Y
+                case 2: place_z--; break; // -Z
+                case 3: place_z++; break; // +Z
+                case 4: place_x--; break; // -X
+                case 5: place_x++; break; // +X
             }
-            return true;
-        }
 
-        case PacketId::PlayerPosition: {
-            PacketPlayerPosition packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
+            // Check if block would collide with player bounding box
+            // Player bounding box: 0.6 wide (x/z) x 1.8 tall (y)
+            // Block bounding box: 1x1x1 from (place_x, place_y, place_z) to (place_x+1, place_y+1, place_z+1)
+            f64 player_x = player_->get_x();
+            f64 player_y = player_->get_y();
+            f64 player_z = player_->get_z();
+
+            // Player bounding box (AABB)
+            f64 player_min_x = player_x - 0.3;
+            f64 player_max_x = player_x + 0.3;
+            f64 player_min_y = player_y;
+            f64 player_max_y = player_y + 1.8;
+            f64 player_min_z = player_z - 0.3;
+            f64 player_max_z = player_z + 0.3;
+
+            // Block bounding box
+            f64 block_min_x = static_cast<f64>(place_x);
+            f64 block_max_x = static_cast<f64>(place_x + 1);
+            f64 block_min_y = static_cast<f64>(place_y);
+            f64 block_max_y = static_cast<f64>(place_y + 1);
+            f64 block_min_z = static_cast<f64>(place_z);
+            f64 block_max_z = static_cast<f64>(place_z + 1);
+
+            // Check AABB collision
+            bool collides = !(player_max_x <= block_min_x || player_min_x >= block_max_x ||
+                             player_max_y <= block_min_y || player_min_y >= block_max_y ||
+                             player_max_z <= block_min_z || player_min_z >= block_max_z);
+
+            if (collides) {
+                LOG_DEBUG_CAT("Cannot place block at (" + std::to_string(place_x) + ", " +
+                             std::to_string(place_y) + ", " + std::to_string(place_z) +
+                             ") - would collide with player", LogCategory::World);
+                // Send block update to client to cancel the placement
+                return;
             }
-            if (player_) {
-                player_->set_position(packet.x, packet.y, packet.z);
-                player_->set_on_ground(packet.on_ground);
+
+            auto result = block_manager_->place_block(place_x, place_y, place_z,
+                                                     static_cast<u8>(packet.item.id), 0);
+            if (!result) {
+                LOG_DEBUG_CAT("Failed to place block at (" +
+                             std::to_string(place_x) + ", " +
+                             std::to_string(place_y) + ", " +
+                             std::to_string(place_z) + ")",
+                             LogCategory::World);
             }
-            return true;
         }
+    }
+}
 
-        case PacketId::PlayerLook: {
-            PacketPlayerLook packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
-            }
-            if (player_) {
-                player_->set_rotation(packet.yaw, packet.pitch);
-                player_->set_on_ground(packet.on_ground);
-            }
-            return true;
+void ClientSession::handle(const serverbound::BlockItemSwitch& packet) {
+    if (player_) {
+        // Switch held item in hotbar (slots 0-8)
+        if (packet.slot >= 0 && packet.slot < 9) {
+            player_->get_inventory()->set_current_slot(static_cast<i32>(packet.slot));
+            LOG_DEBUG_CAT("Player " + username_ + " switched to hotbar slot " +
+                         std::to_string(packet.slot), LogCategory::Network);
         }
+    }
+}
 
-        case PacketId::PlayerLookMove: {
-            // This is packet 13 - already handled as PlayerPositionLook
-            PacketPlayerPositionLook packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
-            }
-            if (player_) {
-                player_->set_position(packet.x, packet.y, packet.z);
-                player_->set_rotation(packet.yaw, packet.pitch);
-                player_->set_on_ground(packet.on_ground);
-            }
-            return true;
+void ClientSession::handle(const serverbound::Animation& packet) {
+    // Broadcast animation to the players that can see this one
+    if (animation_callback_) {
+        animation_callback_(player_->get_entity_id(), packet.animation);
+    }
+    LOG_DEBUG_CAT("Player " + username_ + " animated: " +
+                 std::to_string(static_cast<i8>(packet.animation)), LogCategory::Network);
+}
+
+void ClientSession::handle(const serverbound::UseEntity& packet) {
+    // Handle entity interaction (attack or right-click)
+    if (packet.left_click) {
+        // Attack/damage entity
+        LOG_DEBUG_CAT("Player " + username_ + " attacked entity " +
+                     std::to_string(packet.target_id), LogCategory::Network);
+
+        // Broadcast arm swing animation to the players that can see this one
+        if (animation_callback_) {
+            animation_callback_(player_->get_entity_id(), AnimationType::SwingArm);
         }
 
-        case PacketId::BlockDig: {
-            PacketBlockDig packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
+        // Calculate damage based on held item
+        i16 damage = 1;  // Base unarmed damage
+        i32 current_slot = player_->get_inventory()->get_current_slot();
+        const ItemStack* held_item = player_->get_inventory()->get_slot(current_slot);
+        if (held_item && !held_item->is_empty()) {
+            i16 item_id = held_item->get_item_id();
+            // Calculate damage based on item type
+            // Swords
+            if (item_id == 268) damage = 5;  // Wooden Sword
+            else if (item_id == 272) damage = 6;  // Stone Sword
+            else if (item_id == 267) damage = 7;  // Iron Sword
+            else if (item_id == 283) damage = 8;  // Gold Sword
+            else if (item_id == 276) damage = 9;  // Diamond Sword
+            // Axes (less damage than swords but still effective)
+            else if (item_id == 271) damage = 4;  // Wooden Axe
+            else if (item_id == 275) damage = 5;  // Stone Axe
+            else if (item_id == 258) damage = 6;  // Iron Axe
+            else if (item_id == 286) damage = 5;  // Gold Axe
+            else if (item_id == 279) damage = 7;  // Diamond Axe
+            // Pickaxes (minimal bonus)
+            else if (item_id == 270 || item_id == 274 || item_id == 257 || item_id == 285 || item_id == 278) {
+                damage = 3;  // All pickaxes give small bonus
             }
-            if (block_manager_) {
-                // Only handle finished digging for now
-                if (packet.status == DigStatus::Finished) {
-                    auto result = block_manager_->break_block(packet.x, packet.y, packet.z);
-                    if (!result) {
-                        LOG_DEBUG_CAT("Failed to break block at (" +
-                                     std::to_string(packet.x) + ", " +
-                                     std::to_string(packet.y) + ", " +
-                                     std::to_string(packet.z) + ")",
-                                     LogCategory::World);
-                    }
-                }
+            // Shovels (minimal bonus)
+            else if (item_id == 269 || item_id == 273 || item_id == 256 || item_id == 284 || item_id == 277) {
+                damage = 2;  // All shovels give tiny bonus
             }
-            return true;
         }
+        bool target_died = false;
+
+        // Check if target is a mob
+        if (mob_manager_) {
+            Mob* target_mob = mob_manager_->get_mob(packet.target_id);
+            if (target_mob) {
+                // Apply knockback from player position
+                target_mob->apply_knockback(player_->get_x(), player_->get_z(), 0.4f);
+
+                // Trigger panic mode for passive mobs
+                target_mob->on_attacked_by(player_->get_x(), player_->get_z());
+
+                i16 new_health = target_mob->get_health() - damage;
+                target_mob->set_health(new_health);
+
+                LOG_DEBUG_CAT("Mob " + std::to_string(packet.target_id) +
+                             " took " + std::to_string(damage) + " damage (health: " +
+                             std::to_string(new_health) + "/" +
+                             std::to_string(target_mob->get_max_health()) + ")",
+                             LogCategory::Entity);
+
+                // Broadcast hurt animation to the players that can see the mob
+                if (entity_status_callback_) {
+                    entity_status_callback_(packet.target_id, 2);  // Status 2 = hurt
+                }
 
-        case PacketId::Place: {
-            PacketPlace packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
-            }
-            if (block_manager_ && player_) {
-                // Only handle block placement (not items)
-                if (packet.block_item_id > 0 && packet.block_item_id < 256) {
-                    // Calculate placement position based on clicked face
-                    i32 place_x = packet.x;
-                    i8 place_y = packet.y;
-                    i32 place_z = packet.z;
-
-                    // Adjust position based on face clicked
-                    switch (packet.direction) {
-                        case 0: place_y--; break; // -Y
-                        case 1: place_y++; break; // +Y
-                        case 2: place_z--; break; // -Z
-                        case 3: place_z++; break; // +Z
-                        case 4: place_x--; break; // -X
-                        case 5: place_x++; break; // +X
-                    }
+                // Check if mob died
+                if (target_mob->is_dead()) {
+                    target_died = true;
+                    LOG_INFO_CAT("Mob " + target_mob->get_name() + " (ID: " +
+                                std::to_string(packet.target_id) + ") was killed by " + username_,
+                                LogCategory::Entity);
 
-                    // Check if block would collide with player bounding box
-                    // Player bounding box: 0.6 wide (x/z) x 1.8 tall (y)
-                    // Block bounding box: 1x1x1 from (place_x, place_y, place_z) to (place_x+1, place_y+1, place_z+1)
-                    f64 player_x = player_->get_x();
-                    f64 player_y = player_->get_y();
-                    f64 player_z = player_->get_z();
-
-                    // Player bounding box (AABB)
-                    f64 player_min_x = player_x - 0.3;
-                    f64 player_max_x = player_x + 0.3;
-                    f64 player_min_y = player_y;
-                    f64 player_max_y = player_y + 1.8;
-                    f64 player_min_z = player_z - 0.3;
-                    f64 player_max_z = player_z + 0.3;
-
-                    // Block bounding box
-                    f64 block_min_x = static_cast<f64>(place_x);
-                    f64 block_max_x = static_cast<f64>(place_x + 1);
-                    f64 block_min_y = static_cast<f64>(place_y);
-                    f64 block_max_y = static_cast<f64>(place_y + 1);
-                    f64 block_min_z = static_cast<f64>(place_z);
-                    f64 block_max_z = static_cast<f64>(place_z + 1);
-
-                    // Check AABB collision
-                    bool collides = !(player_max_x <= block_min_x || player_min_x >= block_max_x ||
-                                     player_max_y <= block_min_y || player_min_y >= block_max_y ||
-                                     player_max_z <= block_min_z || player_min_z >= block_max_z);
-
-                    if (collides) {
-                        LOG_DEBUG_CAT("Cannot place block at (" + std::to_string(place_x) + ", " +
-                                     std::to_string(place_y) + ", " + std::to_string(place_z) +
-                                     ") - would collide with player", LogCategory::World);
-                        // Send block update to client to cancel the placement
-                        return true;
+                    // Broadcast death animation
+                    if (entity_status_callback_) {
+                        entity_status_callback_(packet.target_id, 3);  // Status 3 = dead
                     }
 
-                    auto result = block_manager_->place_block(place_x, place_y, place_z,
-                                                             static_cast<u8>(packet.block_item_id), 0);
-                    if (!result) {
-                        LOG_DEBUG_CAT("Failed to place block at (" +
-                                     std::to_string(place_x) + ", " +
-                                     std::to_string(place_y) + ", " +
-                                     std::to_string(place_z) + ")",
-                                     LogCategory::World);
+                    // Spawn death drops
+                    auto drops = target_mob->get_death_drops();
+                    for (const auto& [item_id, count] : drops) {
+                        if (count > 0 && item_entity_manager_) {
+                            // Create item stack and spawn at mob's position
+                            ItemStack drop_item(item_id, count, 0);
+                            item_entity_manager_->spawn_item(
+                                drop_item,
+                                target_mob->get_x(),
+                                target_mob->get_y(),
+                                target_mob->get_z()
+                            );
+                        }
                     }
-                }
-            }
-            return true;
-        }
 
-        case PacketId::BlockItemSwitch: {
-            PacketBlockItemSwitch packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
-            }
-            if (player_) {
-                // Switch held item in hotbar (slots 0-8)
-                if (packet.slot >= 0 && packet.slot < 9) {
-                    player_->get_inventory()->set_current_slot(static_cast<i32>(packet.slot));
-                    LOG_DEBUG_CAT("Player " + username_ + " switched to hotbar slot " +
-                                 std::to_string(packet.slot), LogCategory::Network);
+                    // Note: Mob will be removed by mob_manager after death animation completes
+                    // (when should_despawn() returns true)
                 }
             }
-            return true;
         }
 
-        case PacketId::Animation: {
-            PacketAnimation packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
-            }
-            // Broadcast animation to other players
-            if (entity_manager_) {
-                auto other_players = entity_manager_->get_other_players(player_->get_entity_id());
-                for (auto* other_player : other_players) {
-                    ClientSession* session = entity_manager_->get_player_session(other_player->get_entity_id());
-                    if (session) {
-                        PacketAnimation broadcast(player_->get_entity_id(), packet.animation);
-                        session->send_packet(broadcast);
-                    }
+        // Check if target is a player (PvP)
+        if (!target_died && entity_manager_) {
+            Player* target_player = entity_manager_->get_player(packet.target_id);
+            if (target_player) {
+                i16 new_health = target_player->get_health() - damage;
+                target_player->set_health(new_health);
+
+                LOG_DEBUG_CAT("Player " + target_player->get_username() +
+                             " took " + std::to_string(damage) + " damage (health: " +
+                             std::to_string(new_health) + "/20)",
+                             LogCategory::Entity);
+
+                // Broadcast hurt animation to the players that can see the target, and the target
+                if (entity_status_callback_) {
+                    entity_status_callback_(packet.target_id, 2);  // Status 2 = hurt
                 }
-            }
-            LOG_DEBUG_CAT("Player " + username_ + " animated: " +
-                         std::to_string(static_cast<i8>(packet.animation)), LogCategory::Network);
-            return true;
-        }
-
-        case PacketId::UseEntity: {
-            PacketUseEntity packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
-            }
 
-            // Handle entity interaction (attack or right-click)
-            if (packet.left_click) {
-                // Attack/damage entity
-                LOG_DEBUG_CAT("Player " + username_ + " attacked entity " +
-                             std::to_string(packet.target_id), LogCategory::Network);
-
-                // Broadcast arm swing animation to other players
-                if (entity_manager_) {
-                    auto other_players = entity_manager_->get_other_players(player_->get_entity_id());
-                    for (auto* other_player : other_players) {
-                        ClientSession* session = entity_manager_->get_player_session(other_player->get_entity_id());
-                        if (session) {
-                            PacketAnimation anim_packet(player_->get_entity_id(), AnimationType::SwingArm);
-                            session->send_packet(anim_packet);
-                        }
-                    }
+                // Update health for target player
+                ClientSession* target_session = entity_manager_->get_player_session(packet.target_id);
+                if (target_session) {
+                    PacketUpdateHealth health_packet(new_health);
+                    target_session->send_packet(health_packet);
                 }
 
-                // Calculate damage based on held item
-                i16 damage = 1;  // Base unarmed damage
-                i32 current_slot = player_->get_inventory()->get_current_slot();
-                const ItemStack* held_item = player_->get_inventory()->get_slot(current_slot);
-                if (held_item && !held_item->is_empty()) {
-                    i16 item_id = held_item->get_item_id();
-                    // Calculate damage based on item type
-                    // Swords
-                    if (item_id == 268) damage = 5;  // Wooden Sword
-                    else if (item_id == 272) damage = 6;  // Stone Sword
-                    else if (item_id == 267) damage = 7;  // Iron Sword
-                    else if (item_id == 283) damage = 8;  // Gold Sword
-                    else if (item_id == 276) damage = 9;  // Diamond Sword
-                    // Axes (less damage than swords but still effective)
-                    else if (item_id == 271) damage = 4;  // Wooden Axe
-                    else if (item_id == 275) damage = 5;  // Stone Axe
-                    else if (item_id == 258) damage = 6;  // Iron Axe
-                    else if (item_id == 286) damage = 5;  // Gold Axe
-                    else if (item_id == 279) damage = 7;  // Diamond Axe
-                    // Pickaxes (minimal bonus)
-                    else if (item_id == 270 || item_id == 274 || item_id == 257 || item_id == 285 || item_id == 278) {
-                        damage = 3;  // All pickaxes give small bonus
-                    }
-                    // Shovels (minimal bonus)
-                    else if (item_id == 269 || item_id == 273 || item_id == 256 || item_id == 284 || item_id == 277) {
-                        damage = 2;  // All shovels give tiny bonus
-                    }
-                }
-                bool target_died = false;
-
-                // Check if target is a mob
-                if (mob_manager_) {
-                    Mob* target_mob = mob_manager_->get_mob(packet.target_id);
-                    if (target_mob) {
-                        // Apply knockback from player position
-                        target_mob->apply_knockback(player_->get_x(), player_->get_z(), 0.4f);
-
-                        // Trigger panic mode for passive mobs
-                        target_mob->on_attacked_by(player_->get_x(), player_->get_z());
-
-                        i16 new_health = target_mob->get_health() - damage;
-                        target_mob->set_health(new_health);
-
-                        LOG_DEBUG_CAT("Mob " + std::to_string(packet.target_id) +
-                                     " took " + std::to_string(damage) + " damage (health: " +
-                                     std::to_string(new_health) + "/" +
-                                     std::to_string(target_mob->get_max_health()) + ")",
-                                     LogCategory::Entity);
-
-                        // Broadcast hurt animation to all players
-                        if (entity_manager_) {
-                            PacketEntityStatus hurt_packet(packet.target_id, 2);  // Status 2 = hurt
-                            auto all_players = entity_manager_->get_all_players();
-                            for (auto* player : all_players) {
-                                ClientSession* session = entity_manager_->get_player_session(player->get_entity_id());
-                                if (session) {
-                                    session->send_packet(hurt_packet);
-                                }
-                            }
-                        }
+                // Check if player died
+                if (target_player->is_dead()) {
+                    LOG_INFO_CAT("Player " + target_player->get_username() +
+                                " was killed by " + username_,
+                                LogCategory::Entity);
 
-                        // Check if mob died
-                        if (target_mob->is_dead()) {
-                            target_died = true;
-                            LOG_INFO_CAT("Mob " + target_mob->get_name() + " (ID: " +
-                                        std::to_string(packet.target_id) + ") was killed by " + username_,
-                                        LogCategory::Entity);
-
-                            // Broadcast death animation
-                            if (entity_manager_) {
-                                PacketEntityStatus death_packet(packet.target_id, 3);  // Status 3 = dead
-                                auto all_players = entity_manager_->get_all_players();
-                                for (auto* player : all_players) {
-                                    ClientSession* session = entity_manager_->get_player_session(player->get_entity_id());
-                                    if (session) {
-                                        session->send_packet(death_packet);
-                                    }
-                                }
-                            }
-
-                            // Spawn death drops
-                            auto drops = target_mob->get_death_drops();
-                            for (const auto& [item_id, count] : drops) {
-                                if (count > 0 && item_entity_manager_) {
-                                    // Create item stack and spawn at mob's position
-                                    ItemStack drop_item(item_id, count, 0);
-                                    item_entity_manager_->spawn_item(
-                                        drop_item,
-                                        target_mob->get_x(),
-                                        target_mob->get_y(),
-                                        target_mob->get_z()
-                                    );
-                                }
-                            }
-
-                            // Note: Mob will be removed by mob_manager after death animation completes
-                            // (when should_despawn() returns true)
-                        }
+                    // Broadcast death animation
+                    if (entity_status_callback_) {
+                        entity_status_callback_(packet.target_id, 3);  // Status 3 = dead
                     }
-                }
-
-                // Check if target is a player (PvP)
-                if (!target_died && entity_manager_) {
-                    Player* target_player = entity_manager_->get_player(packet.target_id);
-                    if (target_player) {
-                        i16 new_health = target_player->get_health() - damage;
-                        target_player->set_health(new_health);
-
-                        LOG_DEBUG_CAT("Player " + target_player->get_username() +
-                                     " took " + std::to_string(damage) + " damage (health: " +
-                                     std::to_string(new_health) + "/20)",
-                                     LogCategory::Entity);
-
-                        // Broadcast hurt animation to all players
-                        PacketEntityStatus hurt_packet(packet.target_id, 2);  // Status 2 = hurt
-                        auto all_players = entity_manager_->get_all_players();
-                        for (auto* player : all_players) {
-                            ClientSession* session = entity_manager_->get_player_session(player->get_entity_id());
-                            if (session) {
-                                session->send_packet(hurt_packet);
-                            }
-                        }
 
-                        // Update health for target player
-                        ClientSession* target_session = entity_manager_->get_player_session(packet.target_id);
-                        if (target_session) {
-                            PacketUpdateHealth health_packet(new_health);
-                            target_session->send_packet(health_packet);
-                        }
-
-                        // Check if player died
-                        if (target_player->is_dead()) {
-                            LOG_INFO_CAT("Player " + target_player->get_username() +
-                                        " was killed by " + username_,
-                                        LogCategory::Entity);
-
-                            // Broadcast death animation
-                            PacketEntityStatus death_packet(packet.target_id, 3);  // Status 3 = dead
-                            for (auto* player : all_players) {
-                                ClientSession* session = entity_manager_->get_player_session(player->get_entity_id());
-                                if (session) {
-                                    session->send_packet(death_packet);
-                                }
-                            }
-
-                            // Reset player health and respawn
-                            if (target_session) {
-                                target_player->set_health(20);
-                                PacketUpdateHealth respawn_health(20);
-                                target_session->send_packet(respawn_health);
-                                // TODO: Implement full respawn with position reset
-                            }
-                        }
+                    // Reset player health and respawn
+                    if (target_session) {
+                        target_player->set_health(20);
+                        PacketUpdateHealth respawn_health(20);
+                        target_session->send_packet(respawn_health);
+                        // TODO: Implement full respawn with position reset
                     }
                 }
-            } else {
-                // Right-click interaction (e.g., open trade window, ride entity)
-                LOG_DEBUG_CAT("Player " + username_ + " interacted with entity " +
-                             std::to_string(packet.target_id), LogCategory::Network);
-                // TODO: Handle entity interactions
             }
-
-            return true;
         }
+    } else {
+        // Right-click interaction (e.g., open trade window, ride entity)
+        LOG_DEBUG_CAT("Player " + username_ + " interacted with entity " +
+                     std::to_string(packet.target_id), LogCategory::Network);
+        // TODO: Handle entity interactions
+    }
+}
 
-        case PacketId::EntityAction: {
-            PacketEntityAction packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
-            }
-            if (player_) {
-                // Handle entity actions (sneaking, etc.)
-                switch (packet.state) {
-                    case EntityActionState::Crouch:
-                        player_->set_sneaking(true);
-                        LOG_DEBUG_CAT("Player " + username_ + " started sneaking", LogCategory::Network);
-                        break;
-                    case EntityActionState::Uncrouch:
-                        player_->set_sneaking(false);
-                        LOG_DEBUG_CAT("Player " + username_ + " stopped sneaking", LogCategory::Network);
-                        break;
-                    case EntityActionState::LeaveBed:
-                        // TODO: Implement bed leaving
-                        LOG_DEBUG_CAT("Player " + username_ + " left bed", LogCategory::Network);
-                        break;
-                    case EntityActionState::StartSprinting:
-                        player_->set_sprinting(true);
-                        LOG_DEBUG_CAT("Player " + username_ + " started sprinting", LogCategory::Network);
-                        break;
-                    case EntityActionState::StopSprinting:
-                        player_->set_sprinting(false);
-                        LOG_DEBUG_CAT("Player " + username_ + " stopped sprinting", LogCategory::Network);
-                        break;
-                }
-            }
-            return true;
+void ClientSession::handle(const serverbound::EntityAction& packet) {
+    if (player_) {
+        // Handle entity actions (sneaking, etc.)
+        switch (packet.state) {
+            case EntityActionState::Crouch:
+                player_->set_sneaking(true);
+                LOG_DEBUG_CAT("Player " + username_ + " started sneaking", LogCategory::Network);
+                break;
+            case EntityActionState::Uncrouch:
+                player_->set_sneaking(false);
+                LOG_DEBUG_CAT("Player " + username_ + " stopped sneaking", LogCategory::Network);
+                break;
+            case EntityActionState::LeaveBed:
+                // TODO: Implement bed leaving
+                LOG_DEBUG_CAT("Player " + username_ + " left bed", LogCategory::Network);
+                break;
+            case EntityActionState::StartSprinting:
+                player_->set_sprinting(true);
+                LOG_DEBUG_CAT("Player " + username_ + " started sprinting", LogCategory::Network);
+                break;
+            case EntityActionState::StopSprinting:
+                player_->set_sprinting(false);
+                LOG_DEBUG_CAT("Player " + username_ + " stopped sprinting", LogCategory::Network);
+                break;
         }
+    }
+}
 
-        case PacketId::WindowClick: {
-            PacketWindowClick packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
-            }
-            if (player_) {
-                LOG_DEBUG_CAT("Player " + username_ + " clicked window " +
-                             std::to_string(packet.window_id) + " protocol slot " +
-                             std::to_string(packet.slot) + " (action: " +
-                             std::to_string(packet.action_number) + ")", LogCategory::Network);
-
-                // Handle player inventory window (window_id 0)
-                if (packet.window_id == 0) {
-                    // Protocol slot 0 is the crafting output
-                    if (packet.slot == 0) {
-                        // Get the crafting result
-                        const ItemStack* result = player_->get_inventory()->get_crafting_result();
-                        if (result && !result->is_empty()) {
-                            // Try to add the result to the player's inventory
-                            auto result_copy = std::make_unique<ItemStack>(*result);
-                            i8 remaining = player_->get_inventory()->add_item(std::move(result_copy));
-
-                            if (remaining == 0) {
-                                // Successfully added - consume crafting materials
-                                player_->get_inventory()->take_crafting_result();
-
-                                // Update crafting result based on new grid
-                                // (need access to recipe manager - will be null for now)
-                                player_->get_inventory()->update_crafting_result(nullptr);
-
-                                LOG_DEBUG_CAT("Player " + username_ + " crafted item", LogCategory::Entity);
-                            } else {
-                                LOG_DEBUG_CAT("Player " + username_ + " inventory full, cannot craft",
-                                            LogCategory::Entity);
-                            }
-
-                            // Send full inventory update to sync everything
-                            send_full_inventory();
-                        }
+void ClientSession::handle(const serverbound::WindowClick& packet) {
+    if (player_) {
+        LOG_DEBUG_CAT("Player " + username_ + " clicked window " +
+                     std::to_string(packet.window_id) + " protocol slot " +
+                     std::to_string(packet.slot) + " (action: " +
+                     std::to_string(packet.action_number) + ")", LogCategory::Network);
+
+        // Handle player inventory window (window_id 0)
+        if (packet.window_id == 0) {
+            // Protocol slot 0 is the crafting output
+            if (packet.slot == 0) {
+                // Get the crafting result
+                const ItemStack* result = player_->get_inventory()->get_crafting_result();
+                if (result && !result->is_empty()) {
+                    // Try to add the result to the player's inventory
+                    auto result_copy = std::make_unique<ItemStack>(*result);
+                    i8 remaining = player_->get_inventory()->add_item(std::move(result_copy));
+
+                    if (remaining == 0) {
+                        // Successfully added - consume crafting materials
+                        player_->get_inventory()->take_crafting_result();
+
+                        // Update crafting result based on new grid
+                        // (need access to recipe manager - will be null for now)
+                        player_->get_inventory()->update_crafting_result(nullptr);
+
+                        LOG_DEBUG_CAT("Player " + username_ + " crafted item", LogCategory::Entity);
                     } else {
-                        // Convert protocol slot to internal slot for other slots
-                        i32 internal_slot = protocol_to_internal_slot(packet.slot);
-                        if (internal_slot >= 0 && internal_slot < 45) {
-                            // For now, just acknowledge by sending the slot back
-                            // TODO: Implement full click logic (swap, split stack, etc.)
-                            send_inventory_update(internal_slot);
-
-                            // If clicking in crafting grid, update crafting result
-                            if (internal_slot >= 40 && internal_slot <= 43) {
-                                player_->get_inventory()->update_crafting_result(nullptr);
-                                send_inventory_update(44);  // Update crafting output
-                            }
-                        }
+                        LOG_DEBUG_CAT("Player " + username_ + " inventory full, cannot craft",
+                                    LogCategory::Entity);
                     }
-                }
-            }
-            return true;
-        }
 
-        case PacketId::CloseWindow: {
-            PacketCloseWindow packet;
-            auto read_result = packet.read(buffer);
-            if (!read_result) {
-                return false; // Insufficient data
+                    // Send full inventory update to sync everything
+                    send_full_inventory();
+                }
+            } else {
+                // Convert protocol slot to internal slot for other slots
+                i32 internal_slot = protocol_to_internal_slot(packet.slot);
+                if (internal_slot >= 0 && internal_slot < 45) {
+                    // For now, just acknowledge by sending the slot back
+                    // TODO: Implement full click logic (swap, split stack, etc.)
+                    send_inventory_update(internal_slot);
+
+                    // If clicking in crafting grid, update crafting result
+                    if (internal_slot >= 40 && internal_slot <= 43) {
+                        player_->get_inventory()->update_crafting_result(nullptr);
+                        send_inventory_update(44);  // Update crafting output
+                    }
+                }
             }
-            // Player closed a window (inventory, chest, etc.)
-            LOG_DEBUG_CAT("Player " + username_ + " closed window " +
-                         std::to_string(packet.window_id), LogCategory::Network);
-            // No action needed - just acknowledge
-            return true;
         }
-
-        default:
-            // Unknown packet - return false to indicate it wasn't recognized
-            LOG_DEBUG_CAT("Unhandled packet ID: " + std::to_string(packet_id), LogCategory::Network);
-            return false;
     }
 }
 
+void ClientSession::handle(const serverbound::CloseWindow& packet) {
+    // Player closed a window (inventory, chest, etc.)
+    LOG_DEBUG_CAT("Player " + username_ + " closed window " +
+                 std::to_string(packet.window_id), LogCategory::Network);
+    // No action needed - just acknowledge
+}
+
 void ClientSession::send_initial_chunks() {
     if (!chunk_streaming_manager_) {
         LOG_ERROR_CAT("ChunkStreamingManager not available for chunk sending", LogCategory::Network);
@@ -951,17 +931,20 @@ void ClientSession::send_initial_chunks() {
 
     LOG_INFO_CAT("Sending initial chunks to " + username_, LogCategory::Network);
 
-    // Use ChunkStreamingManager to send chunks in spiral pattern
-    chunk_streaming_manager_->add_player(this,
-                                          static_cast<f64>(spawn_x),
-                                          static_cast<f64>(spawn_z));
+    // Stream around where the player is: the spawn area prepared during login
+    f64 player_x = player_ ? player_->get_x() : static_cast<f64>(spawn_x) + 0.5;
+    f64 player_y = player_ ? player_->get_y() : static_cast<f64>(spawn_y);
+    f64 player_z = player_ ? player_->get_z() : static_cast<f64>(spawn_z) + 0.5;
+
+    // Queued nearest first; sent over the next ticks as they are ready
+    chunk_streaming_manager_->add_player(this, player_x, player_z);
 
-    // Send player position (spawn + slight offset above ground)
+    // Send player position (slight offset above ground)
     PacketPlayerPositionLook pos_packet;
-    pos_packet.x = static_cast<f64>(spawn_x) + 0.5;
-    pos_packet.y = static_cast<f64>(spawn_y) + 1.62; // Eye height
-    pos_packet.stance = static_cast<f64>(spawn_y) + 1.62;
-    pos_packet.z = static_cast<f64>(spawn_z) + 0.5;
+    pos_packet.x = player_x;
+    pos_packet.y = player_y + 1.62; // Eye height
+    pos_packet.stance = player_y + 1.62;
+    pos_packet.z = player_z;
     pos_packet.yaw = 0.0f;
     pos_packet.pitch = 0.0f;
     pos_packet.on_ground = false;
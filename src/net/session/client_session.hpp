@@ -1,9 +1,15 @@
 #pragma once
 
-#include "platform/net/socket.hpp"
+#include "net/session/connection.hpp"
+#include "net/session/traffic_shaper.hpp"
+#include "net/session/inbound_budget.hpp"
 #include "net/protocol/packet.hpp"
+#include "net/protocol/serverbound.hpp"
 #include "entity/player.hpp"
+#include "platform/time/clock.hpp"
 #include "util/result.hpp"
+#include <atomic>
+#include <unordered_set>
 #include <vector>
 #include <memory>
 #include <string>
@@ -20,21 +26,27 @@ class ChunkStreamingManager;
 class PlayerDataManager;
 class AdminManager;
 
-enum class SessionState {
-    Handshake,
-    Login,
-    Play,
-    Disconnected
-};
-
 // Callback type for broadcasting chat messages
 using ChatBroadcastCallback = std::function<void(const std::string& message, const std::string& sender)>;
 using PlayerJoinCallback = std::function<void(const std::string& username)>;
 using PlayerLeaveCallback = std::function<void(const std::string& username)>;
+using EntityStatusCallback = std::function<void(i32 entity_id, i8 status)>;
+using AnimationCallback = std::function<void(i32 entity_id, AnimationType animation)>;
+
+// How much outbound data a client may leave unread
+// Past the soft limit chunk sends wait and distant entity moves are dropped until
+// the client catches up.
+// The client is kicked at the hard limit, or once it has gone the stall timeout
+// without its socket draining and its backlog back under the soft limit.
+struct BacklogLimits {
+    usize soft_bytes = 1024 * 1024;
+    usize hard_bytes = 8 * 1024 * 1024;
+    i64 stall_timeout_ms = 30000;
+};
 
 class ClientSession {
 public:
-    explicit ClientSession(Socket socket, ChunkManager* chunk_manager,
+    explicit ClientSession(std::shared_ptr<Connection> connection, ChunkManager* chunk_manager,
                           EntityManager* entity_manager,
                           BlockManager* block_manager,
                           MobManager* mob_manager,
@@ -44,18 +56,64 @@ public:
                           AdminManager* admin_manager,
                           ChatBroadcastCallback chat_callback,
                           PlayerJoinCallback join_callback,
-                          PlayerLeaveCallback leave_callback);
+                          PlayerLeaveCallback leave_callback,
+                          EntityStatusCallback entity_status_callback,
+                          AnimationCallback animation_callback,
+                          usize send_budget,
+                          usize min_send_budget,
+                          const BacklogLimits& backlog_limits = {},
+                          const InboundLimits& inbound_limits = {},
+                          i64 login_timeout_ms = 30000);
     ~ClientSession();
 
-    // Process incoming data
-    void process();
+    // Handle packets decoded by the network I/O thread, as far as this tick's
+    // budget goes; the rest wait for the next call. 'shared_cost' is what is
+    // left of the server-wide budget. Returns the cost used
+    u32 process(u32 shared_cost);
+
+    // Decoded packets held back by the budget
+    usize pending_inbound() const { return inbound_packets_.size() - inbound_next_; }
 
-    // Send packet
+    // Encode a packet and queue it in its traffic class lane
     void send_packet(const Packet& packet);
 
+    // Queue a packet already encoded for several sessions (see Packet::encode)
+    void send_encoded(const EncodedPacket& packet);
+
+    // Queue a copy of a packet encoded by the caller (e.g. with the clientbound
+    // encoders); attachments are kept by reference
+    void send_encoded(const PacketWriter& packet);
+
+    // Hand this tick's share of queued output to the network I/O thread
+    void flush_output();
+
     // Disconnect client
     void disconnect(const std::string& reason = "");
 
+    // Encoded bytes waiting to be written to this client's socket (lanes + connection)
+    usize outbound_queue_bytes() const;
+
+    // Past the soft backlog limit: hold back low-priority traffic
+    bool is_backlogged() const { return outbound_queue_bytes() > backlog_limits_.soft_bytes; }
+
+    // Kicked for not reading its data
+    bool was_evicted() const { return evicted_; }
+
+    // Updates of the entity were left out while backlogged (see
+    // EntityMovementTracker::droppable); it needs an EntityTeleport once caught up
+    void drop_movement(i32 entity_id) { dropped_movement_.insert(entity_id); }
+    bool has_dropped_movement() const { return !dropped_movement_.empty(); }
+
+    // Entities to put back in place, sorted; clears the list
+    std::vector<i32> take_dropped_movement();
+
+    // Round-trip time of the client's connection in microseconds; 0 until measured
+    u32 round_trip_us() const { return connection_->round_trip_us(); }
+
+    // Bytes per second the client's link takes when the server has more to send
+    // than it drains; 0 until that has happened
+    usize drain_rate() const;
+
     // Getters
     bool is_connected() const { return state_ != SessionState::Disconnected; }
     SessionState get_state() const { return state_; }
@@ -67,7 +125,15 @@ public:
     void send_full_inventory();
 
 private:
-    Socket socket_;
+    std::shared_ptr<Connection> connection_;
+    TrafficShaper shaper_;
+    PacketWriter encode_buffer_;    // Scratch space for send_packet()
+    u64 last_bytes_sent_ = 0;       // Connection::bytes_sent() at the previous flush
+    Clock::time_point last_keepalive_;
+    BacklogLimits backlog_limits_;
+    Clock::time_point last_caught_up_;  // Last flush under the soft limit with the socket draining
+    bool evicted_ = false;
+    std::unordered_set<i32> dropped_movement_;
     ChunkManager* chunk_manager_;
     EntityManager* entity_manager_;
     BlockManager* block_manager_;
@@ -79,15 +145,58 @@ private:
     ChatBroadcastCallback chat_callback_;
     PlayerJoinCallback join_callback_;
     PlayerLeaveCallback leave_callback_;
+    EntityStatusCallback entity_status_callback_;   // Hurt and death animations, to the entity's viewers
+    AnimationCallback animation_callback_;          // Arm swings and the like, to the player's viewers
     SessionState state_;
     std::string username_;
     std::unique_ptr<Player> player_;
-    std::vector<byte> recv_buffer_;
-    std::vector<byte> send_buffer_;
-
-    void handle_handshake(PacketBuffer& buffer);
-    void handle_login(PacketBuffer& buffer);
-    bool handle_play_packet(u8 packet_id, PacketBuffer& buffer);
+    std::vector<ServerboundPacket> inbound_packets_;   // Reused drain buffer
+    usize inbound_next_ = 0;        // First packet in inbound_packets_ not handled yet
+    InboundBudget inbound_budget_;
+    Clock::time_point connected_at_;
+    i64 login_timeout_ms_;          // Play must be reached within this
+
+    // A login whose player data is loading on the job system (LoggingIn state)
+    // Shared with the load job, which may finish after the session is gone
+    struct PendingLogin {
+        std::unique_ptr<Player> player;
+        bool found_data = false;            // Written by the job before 'loaded'
+        std::atomic<bool> loaded{false};
+    };
+    std::shared_ptr<PendingLogin> pending_login_;
+
+    // Server keep-alives in Play state, as vanilla sends them
+    static constexpr i64 KEEPALIVE_INTERVAL_MS = 1000;
+
+    // Chunks around the spawn point that must be in memory before Play
+    static constexpr i32 SPAWN_AREA_RADIUS = 1;
+
+    // Serverbound packet handlers, picked by the decoded packet's type once
+    // PacketHandler::is_legal() has accepted it for the current state
+    void handle(const serverbound::Handshake& packet);
+    void handle(const serverbound::Login& packet);
+    void handle(const serverbound::KeepAlive& packet);
+    void handle(const serverbound::Chat& packet);
+    void handle(const serverbound::UseEntity& packet);
+    void handle(const serverbound::Flying& packet);
+    void handle(const serverbound::Position& packet);
+    void handle(const serverbound::Look& packet);
+    void handle(const serverbound::PositionLook& packet);
+    void handle(const serverbound::BlockDig& packet);
+    void handle(const serverbound::Place& packet);
+    void handle(const serverbound::BlockItemSwitch& packet);
+    void handle(const serverbound::Animation& packet);
+    void handle(const serverbound::EntityAction& packet);
+    void handle(const serverbound::CloseWindow& packet);
+    void handle(const serverbound::WindowClick& packet);
+
+    // Kick the client if its backlog hit the hard limit or its socket stalled
+    void check_backlog(usize drained);
+    void evict(const std::string& reason);
+
+    // LoggingIn: once the player data and spawn area are ready, finish the login
+    void advance_login();
+    void finish_login();
 
     // Helper to send initial chunks after login
     void send_initial_chunks();
@@ -0,0 +1,214 @@
+#include "connection.hpp"
+#include "net/protocol/packet_handler.hpp"
+
+namespace mcserver {
+
+Connection::Connection(Socket socket)
+    : socket_(std::move(socket)) {
+    socket_.set_non_blocking(true);
+    socket_.set_tcp_nodelay(true);
+}
+
+bool Connection::drain_inbound(std::vector<ServerboundPacket>& out) {
+    if (!has_inbound()) {
+        return false;
+    }
+
+    LockGuard<Mutex> lock(mutex_);
+    for (auto& packet : inbound_) {
+        out.push_back(std::move(packet));
+    }
+    inbound_.clear();
+    inbound_count_.store(0, std::memory_order_release);
+    return true;
+}
+
+void Connection::queue_outbound(OutboundQueue& batch) {
+    if (batch.empty()) {
+        return;
+    }
+
+    LockGuard<Mutex> lock(mutex_);
+    queued_bytes_.fetch_add(batch.size(), std::memory_order_relaxed);
+    outbound_.splice(batch);
+    has_output_.store(true, std::memory_order_release);
+}
+
+std::string Connection::close_reason() const {
+    LockGuard<Mutex> lock(mutex_);
+    return close_reason_;
+}
+
+void Connection::mark_closed(std::string reason) {
+    if (is_closed()) {
+        return;
+    }
+
+    {
+        LockGuard<Mutex> lock(mutex_);
+        close_reason_ = std::move(reason);
+    }
+    closed_.store(true, std::memory_order_release);
+}
+
+void Connection::receive() {
+    if (is_closed()) {
+        return;
+    }
+
+    usize total_read = 0;
+
+    while (total_read < MAX_READ_PER_EVENT) {
+        // Read straight into the receive buffer, no intermediate copy
+        ByteSpan target = recv_buffer_.writable(RECV_CHUNK_SIZE);
+        auto recv_result = socket_.receive(target.data(), target.size());
+
+        if (!recv_result) {
+            if (recv_result.error() != ErrorCode::Timeout) {
+                mark_closed("Network error");
+            }
+            break;
+        }
+
+        isize received = recv_result.value();
+        if (received == 0) {
+            mark_closed("Connection closed by client");
+            break;
+        }
+
+        recv_buffer_.commit(static_cast<usize>(received));
+        total_read += static_cast<usize>(received);
+
+        if (static_cast<usize>(received) < target.size()) {
+            break;  // Socket drained
+        }
+    }
+
+    // Packets that arrived before an EOF are still delivered
+    decode_buffered();
+}
+
+void Connection::on_received(const byte* data, usize size) {
+    if (is_closed()) {
+        return;
+    }
+
+    ConstByteSpan incoming(data, size);
+
+    // Common case: nothing left over from earlier, decode in place
+    if (recv_buffer_.empty()) {
+        usize used = decode(incoming);
+        recv_buffer_.append(incoming.subspan(used));
+        return;
+    }
+
+    recv_buffer_.append(incoming);
+    decode_buffered();
+}
+
+void Connection::decode_buffered() {
+    // The partial frame at the front still isn't complete, nothing to scan
+    if (recv_buffer_.size() < pending_frame_size_) {
+        return;
+    }
+
+    recv_buffer_.consume(decode(recv_buffer_.readable()));
+}
+
+usize Connection::decode(ConstByteSpan data) {
+    usize offset = 0;
+    pending_frame_size_ = 0;
+
+    while (offset < data.size() &&
+           inbound_count() + decoded_.size() < MAX_QUEUED_INBOUND) {
+        ServerboundPacket packet;
+        usize frame_size = 0;
+
+        DecodeStatus status = PacketHandler::decode(data.subspan(offset), packet, frame_size);
+        if (status == DecodeStatus::NeedMoreData) {
+            pending_frame_size_ = frame_size;
+            break;
+        }
+
+        if (status != DecodeStatus::Complete) {
+            u8 packet_id = static_cast<u8>(data[offset]);
+            mark_closed((status == DecodeStatus::UnknownPacket ? "Invalid packet ID: "
+                                                               : "Malformed packet ID: ") +
+                        std::to_string(packet_id));
+            break;
+        }
+
+        decoded_.push_back(std::move(packet));
+        offset += frame_size;
+    }
+
+    if (!decoded_.empty()) {
+        LockGuard<Mutex> lock(mutex_);
+        for (auto& packet : decoded_) {
+            inbound_.push_back(std::move(packet));
+        }
+        inbound_count_.store(inbound_.size(), std::memory_order_release);
+        decoded_.clear();
+    }
+
+    return offset;
+}
+
+void Connection::sample_round_trip(Clock::time_point now) {
+    if (now < next_rtt_sample_) {
+        return;
+    }
+    next_rtt_sample_ = now + std::chrono::milliseconds(RTT_SAMPLE_INTERVAL_MS);
+
+    // Nothing acknowledged yet reads as 0, which is "unknown" as well
+    auto rtt = socket_.round_trip_time_us();
+    if (rtt) {
+        round_trip_us_.store(rtt.value(), std::memory_order_relaxed);
+    }
+}
+
+bool Connection::stage_output() {
+    if (has_output()) {
+        // Segments move over as-is, the bytes stay where they were encoded
+        LockGuard<Mutex> lock(mutex_);
+        sending_.splice(outbound_);
+        has_output_.store(false, std::memory_order_release);
+    }
+
+    return has_unsent();
+}
+
+const IoSlice* Connection::gather_unsent(usize& count) {
+    count = sending_.gather(send_slices_.data(), send_slices_.size());
+    return send_slices_.data();
+}
+
+void Connection::complete_send(usize sent) {
+    sending_.consume(sent);
+    queued_bytes_.fetch_sub(sent, std::memory_order_relaxed);
+    bytes_sent_.fetch_add(sent, std::memory_order_relaxed);
+}
+
+Connection::FlushStatus Connection::flush() {
+    stage_output();
+
+    while (has_unsent()) {
+        usize count = 0;
+        const IoSlice* slices = gather_unsent(count);
+
+        auto send_result = socket_.send_vectored(slices, count);
+        if (!send_result) {
+            // A full socket buffer is back-pressure, not a failure
+            if (send_result.error() == ErrorCode::Timeout) {
+                return FlushStatus::Pending;
+            }
+            mark_closed("Send error");
+            return FlushStatus::Error;
+        }
+        complete_send(static_cast<usize>(send_result.value()));
+    }
+
+    return FlushStatus::Drained;
+}
+
+} // namespace mcserver
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "platform/net/socket.hpp"
+#include "net/session/receive_buffer.hpp"
+#include "net/session/outbound_queue.hpp"
+#include "platform/thread/mutex.hpp"
+#include "platform/time/clock.hpp"
+#include "net/protocol/serverbound.hpp"
+#include "util/types.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mcserver {
+
+// Transport half of a client session
+// Shared between the tick thread (ClientSession) and the network I/O thread that
+// owns the socket. The socket and the receive/send buffers are only touched by the
+// I/O thread; decoded packets and encoded output are handed over under a mutex.
+// Output is written with vectored sends straight from the queued segments; a
+// write the socket only partly accepts keeps its remainder for the next flush.
+class Connection {
+public:
+    // Stop reading from the socket while this many decoded packets are waiting
+    static constexpr usize MAX_QUEUED_INBOUND = 1024;
+
+    // Upper bound on bytes read per readiness event, so one busy client can't
+    // starve the rest of its shard
+    static constexpr usize MAX_READ_PER_EVENT = 64 * 1024;
+
+    // Free space requested from the receive buffer for each recv call
+    static constexpr usize RECV_CHUNK_SIZE = 4096;
+
+    // How often the I/O thread reads the kernel's round-trip estimate
+    static constexpr i64 RTT_SAMPLE_INTERVAL_MS = 1000;
+
+    enum class FlushStatus {
+        Drained,    // Everything queued has been written
+        Pending,    // Socket buffer full, retry when writable
+        Error       // Connection failed and has been marked closed
+    };
+
+    explicit Connection(Socket socket);
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    // ---- Tick thread ----
+
+    // Append all decoded packets to 'out'. Returns false if none were waiting
+    bool drain_inbound(std::vector<ServerboundPacket>& out);
+
+    // Cheap check before taking the inbound lock
+    bool has_inbound() const { return inbound_count_.load(std::memory_order_acquire) > 0; }
+
+    // Move a tick's released output to the outbound queue; written on the next flush
+    void queue_outbound(OutboundQueue& batch);
+
+    // Bytes queued or staged but not yet accepted by the socket
+    usize queued_bytes() const { return queued_bytes_.load(std::memory_order_relaxed); }
+
+    // Total bytes the socket has accepted
+    u64 bytes_sent() const { return bytes_sent_.load(std::memory_order_relaxed); }
+
+    // Last round-trip time sampled from the socket, in microseconds; 0 until known
+    u32 round_trip_us() const { return round_trip_us_.load(std::memory_order_relaxed); }
+
+    // Ask the I/O thread to flush queued output and close the socket
+    void request_close() { close_requested_.store(true, std::memory_order_release); }
+
+    // True once the I/O thread saw EOF, a socket error or a malformed stream
+    bool is_closed() const { return closed_.load(std::memory_order_acquire); }
+    std::string close_reason() const;
+
+    // ---- I/O thread ----
+
+    Socket& socket() { return socket_; }
+
+    // Read what the socket has and decode complete packets into the inbound queue
+    // Marks the connection closed on EOF, socket errors or unknown packet IDs
+    void receive();
+
+    // Decode bytes received by a completion-based backend into its own buffer
+    // Only an incomplete trailing packet is copied into the receive buffer
+    void on_received(const byte* data, usize size);
+
+    // Decode packets already buffered (e.g. after reading was paused)
+    void decode_buffered();
+
+    // Write queued output until done or the socket would block
+    FlushStatus flush();
+
+    // Refresh round_trip_us() if the last sample is RTT_SAMPLE_INTERVAL_MS old
+    void sample_round_trip(Clock::time_point now);
+
+    // Move queued output behind any unsent bytes. Returns true if there is
+    // something to send. Must not be called while a send is in flight
+    bool stage_output();
+
+    // Describe unsent output for a completion-based send; the slices stay valid
+    // until complete_send()
+    const IoSlice* gather_unsent(usize& count);
+
+    // Account for bytes written by a completion-based send
+    void complete_send(usize sent);
+
+    bool has_output() const { return has_output_.load(std::memory_order_acquire); }
+    bool has_unsent() const { return !sending_.empty(); }
+    bool close_requested() const { return close_requested_.load(std::memory_order_acquire); }
+    usize inbound_count() const { return inbound_count_.load(std::memory_order_acquire); }
+
+    void mark_closed(std::string reason);
+
+private:
+    friend class NetworkIoThread;
+
+    Socket socket_;
+
+    // Backend bookkeeping owned by the I/O thread
+    u32 registered_interest_ = 0;   // Poller interest flags
+    bool reading_paused_ = false;
+    bool recv_armed_ = false;       // io_uring: multishot receive in flight
+    bool send_in_flight_ = false;   // io_uring: sending_ segments owned by the kernel
+    bool io_shut_down_ = false;     // io_uring: socket shut down, waiting for requests to finish
+
+    // I/O thread only
+    ReceiveBuffer recv_buffer_;
+    usize pending_frame_size_ = 0;  // Size of the partial frame at the front of recv_buffer_
+    OutboundQueue sending_;         // Staged output, written from the front
+    std::vector<ServerboundPacket> decoded_;    // Scratch for decode()
+    Clock::time_point next_rtt_sample_{};
+    std::array<IoSlice, OutboundQueue::MAX_SLICES> send_slices_{};
+
+    // Handed over between threads
+    mutable Mutex mutex_;
+    std::vector<ServerboundPacket> inbound_;
+    OutboundQueue outbound_;
+    std::string close_reason_;
+
+    std::atomic<usize> inbound_count_{0};
+    std::atomic<usize> queued_bytes_{0};
+    std::atomic<u64> bytes_sent_{0};
+    std::atomic<u32> round_trip_us_{0};
+    std::atomic<bool> has_output_{false};
+    std::atomic<bool> close_requested_{false};
+    std::atomic<bool> closed_{false};
+
+    // Decode complete packets from the front of 'data', returns the bytes used
+    usize decode(ConstByteSpan data);
+};
+
+} // namespace mcserver
@@ -0,0 +1,43 @@
+#include "inbound_budget.hpp"
+#include <algorithm>
+
+namespace mcserver {
+
+u32 inbound_cost_of(PacketId id) {
+    switch (id) {
+        case PacketId::BlockDig:
+        case PacketId::Place:
+        case PacketId::Login:
+            return 8;
+
+        case PacketId::Chat:
+        case PacketId::UseEntity:
+            return 4;
+
+        case PacketId::Animation:
+        case PacketId::WindowClick:
+            return 2;
+
+        default:
+            return 1;
+    }
+}
+
+void InboundBudget::begin_tick(u32 shared_cost) {
+    max_cost_ = std::min(limits_.max_cost, shared_cost);
+    packets_ = 0;
+    cost_used_ = 0;
+}
+
+bool InboundBudget::try_take(PacketId id) {
+    u32 cost = inbound_cost_of(id);
+    if (packets_ > 0 && (packets_ >= limits_.max_packets || cost_used_ + cost > max_cost_)) {
+        return false;
+    }
+
+    ++packets_;
+    cost_used_ += cost;
+    return true;
+}
+
+} // namespace mcserver
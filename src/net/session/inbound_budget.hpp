@@ -0,0 +1,43 @@
+#pragma once
+
+#include "net/protocol/packet.hpp"
+#include "util/types.hpp"
+
+namespace mcserver {
+
+// Work a serverbound packet costs the tick thread, in budget units
+// Movement and keep-alives cost 1; digging, placing and chat cost more because
+// they touch the world or are broadcast to every client.
+u32 inbound_cost_of(PacketId id);
+
+// How much inbound work one session may do per tick
+struct InboundLimits {
+    u32 max_packets = 64;
+    u32 max_cost = 64;
+};
+
+// Per-tick inbound packet budget of one session
+// Packets over the budget stay queued in the session for the next tick. The
+// first packet of a tick is always taken, so every session keeps making progress
+// even when the server-wide budget is spent.
+class InboundBudget {
+public:
+    explicit InboundBudget(const InboundLimits& limits) : limits_(limits) {}
+
+    // Start a tick with at most 'shared_cost' left of the server-wide budget
+    void begin_tick(u32 shared_cost);
+
+    // Account for the packet if this tick's budget still allows it
+    bool try_take(PacketId id);
+
+    // Cost taken since begin_tick()
+    u32 cost_used() const { return cost_used_; }
+
+private:
+    InboundLimits limits_;
+    u32 max_cost_ = 0;      // This tick's cost limit
+    u32 packets_ = 0;
+    u32 cost_used_ = 0;
+};
+
+} // namespace mcserver
@@ -0,0 +1,155 @@
+#include "outbound_queue.hpp"
+
+namespace mcserver {
+
+void OutboundQueue::append(const byte* data, usize size) {
+    if (size == 0) {
+        return;
+    }
+
+    if (size >= LARGE_PACKET_SIZE) {
+        Segment segment;
+        segment.owned.assign(data, data + size);
+        segments_.push_back(std::move(segment));
+        tail_open_ = false;
+    } else {
+        if (!tail_open_ || segments_.back().owned.size() + size > BLOCK_SIZE) {
+            Segment block;
+            block.owned.reserve(BLOCK_SIZE);
+            segments_.push_back(std::move(block));
+            tail_open_ = true;
+        }
+        auto& block = segments_.back().owned;
+        block.insert(block.end(), data, data + size);
+    }
+
+    size_ += size;
+}
+
+void OutboundQueue::append(const EncodedPacket& packet) {
+    if (!packet || packet->empty()) {
+        return;
+    }
+
+    if (packet->size() < SHARED_SEGMENT_SIZE) {
+        append(packet->data(), packet->size());
+        return;
+    }
+
+    Segment segment;
+    segment.shared = packet;
+    segments_.push_back(std::move(segment));
+    size_ += packet->size();
+    tail_open_ = false;
+}
+
+void OutboundQueue::append(const PacketWriter& writer) {
+    const byte* data = writer.data().data();
+    usize offset = 0;
+    bool started = false;
+
+    // Every piece after the first that opens a segment leaves the previous one
+    // continued, so the packet is never split between lanes or sends
+    auto append_piece = [&](auto&&... piece) {
+        usize segments_before = segments_.size();
+        usize size_before = size_;
+        append(piece...);
+        if (size_ == size_before) {
+            return;
+        }
+        if (started && segments_.size() > segments_before) {
+            segments_[segments_before - 1].continued = true;
+        }
+        started = true;
+    };
+
+    for (const auto& attachment : writer.attachments()) {
+        append_piece(data + offset, attachment.offset - offset);
+        append_piece(attachment.bytes);
+        offset = attachment.offset;
+    }
+
+    append_piece(data + offset, writer.data().size() - offset);
+}
+
+void OutboundQueue::splice(OutboundQueue& other) {
+    if (other.segments_.empty()) {
+        return;
+    }
+
+    if (segments_.empty()) {
+        segments_.swap(other.segments_);
+    } else {
+        for (auto& segment : other.segments_) {
+            segments_.push_back(std::move(segment));
+        }
+        other.segments_.clear();
+    }
+
+    size_ += other.size_;
+    tail_open_ = other.tail_open_;
+    other.size_ = 0;
+    other.tail_open_ = false;
+}
+
+usize OutboundQueue::splice_front(OutboundQueue& other, usize max_size) {
+    usize moved = 0;
+    bool continued = false;
+    while ((moved < max_size || continued) && !other.segments_.empty()) {
+        Segment& front = other.segments_.front();
+        usize size = front.size() - front.offset;
+        continued = front.continued;
+        segments_.push_back(std::move(front));
+        other.segments_.pop_front();
+        moved += size;
+    }
+
+    size_ += moved;
+    other.size_ -= moved;
+    tail_open_ = false;
+    if (other.segments_.empty()) {
+        other.tail_open_ = false;
+    }
+    return moved;
+}
+
+usize OutboundQueue::gather(IoSlice* slices, usize max_slices) const {
+    usize count = 0;
+    for (const auto& segment : segments_) {
+        if (count == max_slices) {
+            break;
+        }
+        slices[count].data = segment.data() + segment.offset;
+        slices[count].size = segment.size() - segment.offset;
+        ++count;
+    }
+    return count;
+}
+
+void OutboundQueue::consume(usize size) {
+    size = size < size_ ? size : size_;
+    size_ -= size;
+
+    while (size > 0) {
+        Segment& front = segments_.front();
+        usize remaining = front.size() - front.offset;
+        if (size < remaining) {
+            front.offset += size;
+            return;
+        }
+        size -= remaining;
+        segments_.pop_front();
+    }
+
+    if (segments_.empty()) {
+        tail_open_ = false;
+    }
+}
+
+void OutboundQueue::clear() {
+    segments_.clear();
+    size_ = 0;
+    tail_open_ = false;
+}
+
+} // namespace mcserver
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "platform/net/socket.hpp"
+#include "net/protocol/packet.hpp"
+#include "util/types.hpp"
+#include <deque>
+#include <vector>
+
+namespace mcserver {
+
+// Encoded output waiting to be written to one socket
+// Small packets are coalesced into blocks of up to BLOCK_SIZE bytes, so a tick's
+// worth of updates turns into a handful of segments; large payloads such as map
+// chunks get a segment of their own instead of being copied into a block.
+// Broadcast encodings are referenced rather than copied, so every recipient's
+// queue points at the same bytes.
+// A written packet with attachments spans several segments; those are marked so
+// splice_front() only ever stops on a packet boundary.
+// gather() hands the front segments to a vectored send and consume() drops
+// whatever the socket accepted, keeping the unsent tail of a partial write.
+class OutboundQueue {
+public:
+    // Capacity of a coalescing block
+    static constexpr usize BLOCK_SIZE = 16 * 1024;
+
+    // Packets at least this large are queued as their own segment
+    static constexpr usize LARGE_PACKET_SIZE = BLOCK_SIZE / 2;
+
+    // Shared encodings at least this large are referenced instead of copied;
+    // smaller ones are cheaper to copy than to spend a send slice on
+    static constexpr usize SHARED_SEGMENT_SIZE = 256;
+
+    // Most slices handed to a single send
+    static constexpr usize MAX_SLICES = 64;
+
+    OutboundQueue() = default;
+
+    OutboundQueue(OutboundQueue&&) = default;
+    OutboundQueue& operator=(OutboundQueue&&) = default;
+
+    // Queue a copy of an encoded packet
+    void append(const byte* data, usize size);
+
+    // Queue a shared encoding (e.g. one broadcast to many sessions)
+    void append(const EncodedPacket& packet);
+
+    // Queue a written packet: its bytes are copied, its attachments referenced
+    void append(const PacketWriter& writer);
+
+    // Move every segment of 'other' to the back of this queue (no byte copies)
+    void splice(OutboundQueue& other);
+
+    // Move whole segments from the front of 'other' until at least 'max_size'
+    // bytes moved or it is empty, never splitting a packet. Returns the bytes moved
+    usize splice_front(OutboundQueue& other, usize max_size);
+
+    // Describe up to 'max_slices' unsent segments from the front, returns the count
+    usize gather(IoSlice* slices, usize max_slices) const;
+
+    // Drop 'size' bytes from the front after a (possibly partial) write
+    void consume(usize size);
+
+    void clear();
+
+    // Unsent bytes
+    usize size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    usize segment_count() const { return segments_.size(); }
+
+private:
+    struct Segment {
+        std::vector<byte> owned;    // Coalescing block or a copied large packet
+        EncodedPacket shared;       // Set instead of 'owned' for shared encodings
+        usize offset = 0;           // Bytes already written
+        bool continued = false;     // The next segment carries the rest of a packet
+
+        const byte* data() const { return shared ? shared->data() : owned.data(); }
+        usize size() const { return shared ? shared->size() : owned.size(); }
+    };
+
+    std::deque<Segment> segments_;
+    usize size_ = 0;
+    bool tail_open_ = false;    // Back segment is a block that still accepts appends
+};
+
+} // namespace mcserver
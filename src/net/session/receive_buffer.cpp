@@ -0,0 +1,58 @@
+#include "receive_buffer.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace mcserver {
+
+ReceiveBuffer::ReceiveBuffer(usize capacity)
+    : initial_capacity_(capacity) {}
+
+ByteSpan ReceiveBuffer::writable(usize min_size) {
+    if (storage_.empty()) {
+        storage_.resize(std::max(initial_capacity_, min_size));
+    }
+
+    if (storage_.size() - write_pos_ < min_size) {
+        // Move the unread tail (usually a partial packet) back to the front
+        usize unread = size();
+        if (read_pos_ > 0) {
+            if (unread > 0) {
+                std::memmove(storage_.data(), storage_.data() + read_pos_, unread);
+            }
+            read_pos_ = 0;
+            write_pos_ = unread;
+        }
+
+        if (storage_.size() - write_pos_ < min_size) {
+            storage_.resize(std::max(storage_.size() * 2, write_pos_ + min_size));
+        }
+    }
+
+    return {storage_.data() + write_pos_, storage_.size() - write_pos_};
+}
+
+void ReceiveBuffer::commit(usize size) {
+    write_pos_ = std::min(write_pos_ + size, storage_.size());
+}
+
+void ReceiveBuffer::append(ConstByteSpan data) {
+    if (data.empty()) {
+        return;
+    }
+
+    ByteSpan target = writable(data.size());
+    std::memcpy(target.data(), data.data(), data.size());
+    commit(data.size());
+}
+
+void ReceiveBuffer::consume(usize size) {
+    read_pos_ = std::min(read_pos_ + size, write_pos_);
+
+    // Fully drained: start over at the front without moving anything
+    if (read_pos_ == write_pos_) {
+        read_pos_ = 0;
+        write_pos_ = 0;
+    }
+}
+
+} // namespace mcserver
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "util/span_util.hpp"
+#include <vector>
+
+namespace mcserver {
+
+// Receive buffer with read and write cursors
+// The socket writes straight into the free tail (writable + commit), packets are
+// decoded in place from readable(), and consume() just advances the read cursor.
+// Unread bytes are moved back to the front only when the tail runs out of room,
+// so consuming a packet never shifts the bytes behind it.
+// Nothing is allocated until the first write, so connections that never send
+// anything cost no buffer.
+class ReceiveBuffer {
+public:
+    static constexpr usize DEFAULT_CAPACITY = 16 * 1024;
+
+    explicit ReceiveBuffer(usize capacity = DEFAULT_CAPACITY);
+
+    // Free space of at least 'min_size' bytes after the unread data
+    // Compacts first; only grows when a single partial frame needs more room
+    ByteSpan writable(usize min_size);
+
+    // Mark 'size' bytes of the span returned by writable() as received
+    void commit(usize size);
+
+    // Append a copy of 'data' (for bytes that arrived in someone else's buffer)
+    void append(ConstByteSpan data);
+
+    // Unread bytes; invalidated by writable() and append()
+    ConstByteSpan readable() const { return {storage_.data() + read_pos_, write_pos_ - read_pos_}; }
+
+    // Drop 'size' bytes from the front of readable()
+    void consume(usize size);
+
+    usize size() const { return write_pos_ - read_pos_; }
+    bool empty() const { return read_pos_ == write_pos_; }
+    usize capacity() const { return storage_.size(); }
+
+private:
+    std::vector<byte> storage_;
+    usize initial_capacity_;
+    usize read_pos_ = 0;
+    usize write_pos_ = 0;
+};
+
+} // namespace mcserver
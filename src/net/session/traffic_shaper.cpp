@@ -0,0 +1,120 @@
+#include "traffic_shaper.hpp"
+#include <algorithm>
+
+namespace mcserver {
+
+TrafficClass traffic_class_of(PacketId id) {
+    switch (id) {
+        case PacketId::PreChunk:
+        case PacketId::MapChunk:
+            return TrafficClass::Chunk;
+
+        case PacketId::BlockChange:
+        case PacketId::MultiBlockChange:
+        case PacketId::PlayNoteBlock:
+        case PacketId::Explosion:
+        case PacketId::DoorChange:
+        case PacketId::UpdateSign:
+        case PacketId::NamedEntitySpawn:
+        case PacketId::PickupSpawn:
+        case PacketId::VehicleSpawn:
+        case PacketId::MobSpawn:
+        case PacketId::EntityPainting:
+        case PacketId::Collect:
+        case PacketId::DestroyEntity:
+            return TrafficClass::World;
+
+        case PacketId::Animation:
+        case PacketId::EntityVelocity:
+        case PacketId::Entity:
+        case PacketId::RelEntityMove:
+        case PacketId::EntityLook:
+        case PacketId::RelEntityMoveLook:
+        case PacketId::EntityTeleport:
+        case PacketId::EntityStatus:
+        case PacketId::AttachEntity:
+        case PacketId::EntityMetadata:
+        case PacketId::Sleep:
+            return TrafficClass::Entity;
+
+        default:
+            return TrafficClass::Control;
+    }
+}
+
+TrafficShaper::TrafficShaper(usize max_budget, usize min_budget)
+    : max_budget_(std::max<usize>(max_budget, 1))
+    , min_budget_(std::clamp<usize>(min_budget, 1, max_budget_))
+    , budget_(max_budget_) {}
+
+OutboundQueue& TrafficShaper::lane_for(TrafficClass traffic_class) {
+    bool chunks_pending = !lanes_[static_cast<usize>(TrafficClass::Chunk)].empty();
+    if (!chunks_pending) {
+        world_behind_chunks_ = false;
+    }
+
+    if (traffic_class == TrafficClass::World && chunks_pending) {
+        world_behind_chunks_ = true;
+        traffic_class = TrafficClass::Chunk;
+    } else if (traffic_class == TrafficClass::Entity) {
+        // Follow the world packets still queued, which may spawn the entity this is about
+        if (world_behind_chunks_) {
+            traffic_class = TrafficClass::Chunk;
+        } else if (!lanes_[static_cast<usize>(TrafficClass::World)].empty()) {
+            traffic_class = TrafficClass::World;
+        }
+    }
+    return lanes_[static_cast<usize>(traffic_class)];
+}
+
+void TrafficShaper::append(TrafficClass traffic_class, const byte* data, usize size) {
+    lane_for(traffic_class).append(data, size);
+}
+
+void TrafficShaper::append(TrafficClass traffic_class, const EncodedPacket& packet) {
+    lane_for(traffic_class).append(packet);
+}
+
+void TrafficShaper::append(TrafficClass traffic_class, const PacketWriter& writer) {
+    lane_for(traffic_class).append(writer);
+}
+
+void TrafficShaper::release(OutboundQueue& out, usize drained, usize backlog) {
+    if (backlog > budget_) {
+        // The socket is behind: release no more than it actually drains. Only
+        // then is 'drained' the link's rate rather than how much there was to send
+        budget_ = std::clamp(drained, min_budget_, budget_);
+        drain_estimate_ = drain_estimate_ == 0 ? drained : (drain_estimate_ * 7 + drained) / 8;
+    } else {
+        budget_ = std::min(max_budget_, budget_ + budget_ / 4 + 1);
+    }
+
+    // Unused budget doesn't carry over, an overshoot does
+    credit_ = std::min<isize>(credit_, 0) + static_cast<isize>(budget_);
+
+    for (usize lane = 0; lane < LANE_COUNT; ++lane) {
+        if (lane == static_cast<usize>(TrafficClass::Control)) {
+            credit_ -= static_cast<isize>(lanes_[lane].size());
+            out.splice(lanes_[lane]);
+            continue;
+        }
+
+        while (credit_ > 0 && !lanes_[lane].empty()) {
+            credit_ -= static_cast<isize>(out.splice_front(lanes_[lane], static_cast<usize>(credit_)));
+        }
+    }
+}
+
+void TrafficShaper::release_lane(TrafficClass traffic_class, OutboundQueue& out) {
+    out.splice(lanes_[static_cast<usize>(traffic_class)]);
+}
+
+usize TrafficShaper::pending_bytes() const {
+    usize total = 0;
+    for (const auto& lane : lanes_) {
+        total += lane.size();
+    }
+    return total;
+}
+
+} // namespace mcserver
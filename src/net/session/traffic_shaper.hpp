@@ -0,0 +1,78 @@
+#pragma once
+
+#include "net/session/outbound_queue.hpp"
+#include "net/protocol/packet.hpp"
+#include "util/types.hpp"
+#include <array>
+
+namespace mcserver {
+
+// Priority class of a clientbound packet; lower classes are released first
+enum class TrafficClass : u8 {
+    Control,    // Keep-alive, login, chat, health, inventory, position corrections
+    Entity,     // Entity movement, velocity, status and metadata
+    World,      // Block changes and entity spawn/destroy; refer to chunk data
+    Chunk,      // PreChunk / MapChunk, sent from whatever budget is left
+    Count
+};
+
+// Traffic class a clientbound packet is queued in
+TrafficClass traffic_class_of(PacketId id);
+
+// Per-session outbound byte budget with priority lanes
+// Packets are queued per traffic class during the tick and release() hands them
+// to the connection once per tick in priority order until the budget is spent.
+// Control traffic is always released; chunk data only gets what is left over.
+// Whole segments are released, so a tick can overshoot; the excess is paid back
+// from the next tick's budget.
+// World packets queue behind pending chunk data, so a block change or spawn never
+// reaches the client before the chunk it belongs to. Entity packets in turn queue
+// behind pending world packets, so a move never overtakes the spawn of its entity.
+// The budget follows the socket: while more than a tick's budget is still waiting
+// in the connection it drops to the measured drain rate, and while the socket
+// keeps up it grows by a quarter per tick back to the configured maximum.
+class TrafficShaper {
+public:
+    static constexpr usize LANE_COUNT = static_cast<usize>(TrafficClass::Count);
+
+    TrafficShaper(usize max_budget, usize min_budget);
+
+    // Queue an encoded packet in its lane
+    void append(TrafficClass traffic_class, const byte* data, usize size);
+    void append(TrafficClass traffic_class, const EncodedPacket& packet);
+    void append(TrafficClass traffic_class, const PacketWriter& writer);
+
+    // Move this tick's share of queued output to 'out'
+    // drained: bytes the socket accepted since the last call
+    // backlog: bytes released earlier that are still waiting to be written
+    void release(OutboundQueue& out, usize drained, usize backlog);
+
+    // Move everything in one lane to 'out', ignoring the budget (e.g. a kick)
+    void release_lane(TrafficClass traffic_class, OutboundQueue& out);
+
+    // Current per-tick budget in bytes
+    usize budget() const { return budget_; }
+
+    // Bytes per tick the socket drains while it is behind, smoothed over recent
+    // ticks; 0 until the socket has been the bottleneck
+    usize drain_estimate() const { return drain_estimate_; }
+
+    // Bytes waiting in the lanes
+    usize pending_bytes() const;
+    usize pending_bytes(TrafficClass traffic_class) const {
+        return lanes_[static_cast<usize>(traffic_class)].size();
+    }
+
+private:
+    std::array<OutboundQueue, LANE_COUNT> lanes_;
+    usize max_budget_;
+    usize min_budget_;
+    usize budget_;
+    isize credit_ = 0;      // Bytes this tick may still release; negative after an overshoot
+    usize drain_estimate_ = 0;
+    bool world_behind_chunks_ = false;     // The chunk lane holds world packets
+
+    OutboundQueue& lane_for(TrafficClass traffic_class);
+};
+
+} // namespace mcserver
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "net/protocol/clientbound.hpp"
+#include "net/protocol/packets/map_chunk.hpp"
+#include "net/transport/chunk_streaming_manager.hpp"
+#include "util/types.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace mcserver {
+
+// Block changes made during one tick, grouped by chunk
+// NetworkManager sends each chunk's batch once at the end of the tick: a single
+// BlockChange, one MultiBlockChange, or a MapChunk of the changed box once too
+// much changed.
+class BlockChangeAccumulator {
+public:
+    // Past this many distinct blocks in a tick, resending the box around them is
+    // cheaper for the client than applying the changes one by one
+    static constexpr usize MAX_CHANGES_PER_CHUNK = 64;
+
+    struct ChunkChanges {
+        std::vector<clientbound::LocalBlockChange> changes;   // One per position, latest wins
+        ChunkBox bounds{16, 128, 16, -1, -1, -1};             // Every block changed (empty at first)
+        bool overflow = false;                                // Send 'bounds' as a MapChunk instead
+        bool resend = false;                                  // Send the whole chunk instead
+    };
+
+    void record(i32 x, i8 y, i32 z, u8 block_type, u8 metadata) {
+        ChunkChanges& chunk = chunks_[ChunkCoord(x >> 4, z >> 4)];
+        if (chunk.resend) {
+            return;
+        }
+
+        chunk.bounds.include(x & 15, y, z & 15);
+        if (chunk.overflow) {
+            return;
+        }
+
+        u16 position = clientbound::LocalBlockChange::pack(x, y, z);
+        for (auto& change : chunk.changes) {
+            if (change.position == position) {
+                change.block_type = block_type;
+                change.metadata = metadata;
+                return;
+            }
+        }
+
+        if (chunk.changes.size() == MAX_CHANGES_PER_CHUNK) {
+            chunk.overflow = true;
+            chunk.changes.clear();
+            return;
+        }
+        chunk.changes.push_back({position, block_type, metadata});
+    }
+
+    // The whole chunk has to be sent again (e.g. its lighting changed)
+    void record_resend(i32 chunk_x, i32 chunk_z) {
+        mark_resend(chunks_[ChunkCoord(chunk_x, chunk_z)]);
+    }
+
+    bool empty() const { return chunks_.empty(); }
+
+    // Call fn(ChunkCoord, const ChunkChanges&) for every changed chunk, then forget them
+    template<typename Fn>
+    void drain(Fn&& fn) {
+        for (const auto& [coord, chunk] : chunks_) {
+            fn(coord, chunk);
+        }
+        chunks_.clear();
+    }
+
+private:
+    static void mark_resend(ChunkChanges& chunk) {
+        chunk.resend = true;
+        chunk.overflow = false;
+        chunk.changes.clear();
+    }
+
+    std::unordered_map<ChunkCoord, ChunkChanges, ChunkCoordHash> chunks_;
+};
+
+} // namespace mcserver
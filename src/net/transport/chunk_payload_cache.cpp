@@ -0,0 +1,37 @@
+#include "chunk_streaming_manager.hpp"
+#include "net/protocol/packets/map_chunk.hpp"
+#include "world/chunk/chunk.hpp"
+
+// ChunkPayloadCache only needs the world and protocol layers, so it lives apart
+// from ChunkStreamingManager and its session dependencies
+
+namespace mcserver {
+
+SharedBytes ChunkPayloadCache::get(const Chunk& chunk) {
+    Entry& entry = entries_[ChunkCoord(chunk.get_x(), chunk.get_z())];
+    if (entry.payload && entry.version == chunk.get_version()) {
+        ++hits_;
+        return entry.payload;
+    }
+
+    ++misses_;
+    entry.version = chunk.get_version();
+    entry.payload = PacketMapChunk::compress_sections(chunk.get_blocks_data(),
+                                                      chunk.get_metadata_data(),
+                                                      chunk.get_block_light_data(),
+                                                      chunk.get_sky_light_data(),
+                                                      compression_);
+    return entry.payload;
+}
+
+SharedBytes ChunkPayloadCache::find(const Chunk& chunk) {
+    auto it = entries_.find(ChunkCoord(chunk.get_x(), chunk.get_z()));
+    if (it == entries_.end() || it->second.version != chunk.get_version()) {
+        return nullptr;
+    }
+
+    ++hits_;
+    return it->second.payload;
+}
+
+} // namespace mcserver
@@ -4,14 +4,20 @@
 #include "net/protocol/packets/map_chunk.hpp"
 #include "world/chunk/chunk_manager.hpp"
 #include "world/chunk/chunk.hpp"
+#include "core/scheduler/job_system.hpp"
 #include "util/log/logger.hpp"
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace mcserver {
 
-ChunkStreamingManager::ChunkStreamingManager(ChunkManager* chunk_manager, i32 view_distance)
+ChunkStreamingManager::ChunkStreamingManager(ChunkManager* chunk_manager, i32 view_distance,
+                                             JobSystem* job_system)
     : chunk_manager_(chunk_manager)
-    , view_distance_(view_distance) {
+    , view_distance_(view_distance)
+    , job_system_(job_system)
+    , compressed_(std::make_shared<CompressedChunks>()) {
 
     // Validate view distance
     if (view_distance_ < 3) {
@@ -35,7 +41,13 @@ ChunkStreamingManager::~ChunkStreamingManager() {
     player_states_.clear();
 }
 
-void ChunkStreamingManager::add_player(ClientSession* session, f64 x, f64 z) {
+// Degrees between two yaws, 0-180
+static f32 yaw_difference(f32 a, f32 b) {
+    f32 difference = std::fmod(std::abs(a - b), 360.0f);
+    return difference > 180.0f ? 360.0f - difference : difference;
+}
+
+void ChunkStreamingManager::add_player(ClientSession* session, f64 x, f64 z, f32 yaw) {
     if (!session) {
         return;
     }
@@ -44,8 +56,25 @@ void ChunkStreamingManager::add_player(ClientSession* session, f64 x, f64 z) {
     i32 chunk_x = static_cast<i32>(std::floor(x)) >> 4;
     i32 chunk_z = static_cast<i32>(std::floor(z)) >> 4;
 
-    // Create player state
-    PlayerChunkState state(session);
+    // A player added again starts over
+    if (player_states_.find(session) != player_states_.end()) {
+        remove_player(session);
+    }
+
+    // Create player state with a free viewer slot
+
+    u32 slot;
+    if (!free_viewer_slots_.empty()) {
+        slot = free_viewer_slots_.back();
+        free_viewer_slots_.pop_back();
+        viewer_sessions_[slot] = session;
+    } else {
+        slot = static_cast<u32>(viewer_sessions_.size());
+        viewer_sessions_.push_back(session);
+    }
+
+    PlayerChunkState& state = player_states_[session];
+    state = PlayerChunkState(session, slot);
     state.last_update_x = x;
     state.last_update_z = z;
 
@@ -53,57 +82,16 @@ void ChunkStreamingManager::add_player(ClientSession* session, f64 x, f64 z) {
                  std::to_string(chunk_x) + ", " + std::to_string(chunk_z) + ")",
                  LogCategory::Network);
 
-    // Send chunks in spiral pattern (Beta 1.7.3 algorithm)
-    // Start with center chunk
-    send_chunk(session, chunk_x, chunk_z);
-    state.loaded_chunks.insert(ChunkCoord(chunk_x, chunk_z));
-
-    // Spiral outward from center
-    i32 offset_x = 0;
-    i32 offset_z = 0;
-    i32 dir_idx = 0;
-
-    // For each ring distance from center (1 to view_distance*2)
-    for (i32 ring = 1; ring <= view_distance_ * 2; ++ring) {
-        // Each ring has 2 iterations per direction
-        for (i32 iter = 0; iter < 2; ++iter) {
-            const i32* dir = spiral_dirs_[dir_idx % 4];
-
-            // Move 'ring' steps in current direction
-            for (i32 step = 0; step < ring; ++step) {
-                offset_x += dir[0];
-                offset_z += dir[1];
-
-                i32 cx = chunk_x + offset_x;
-                i32 cz = chunk_z + offset_z;
-
-                send_chunk(session, cx, cz);
-                state.loaded_chunks.insert(ChunkCoord(cx, cz));
-            }
-
-            ++dir_idx;
+    // Everything in view, sent nearest and in front first
+    for (i32 cx = chunk_x - view_distance_; cx <= chunk_x + view_distance_; ++cx) {
+        for (i32 cz = chunk_z - view_distance_; cz <= chunk_z + view_distance_; ++cz) {
+            load_chunk(state, ChunkCoord(cx, cz));
         }
     }
+    prioritize(state, x, z, yaw);
 
-    // Final strip to complete the square
-    dir_idx %= 4;
-    const i32* final_dir = spiral_dirs_[dir_idx];
-    for (i32 step = 0; step < view_distance_ * 2; ++step) {
-        offset_x += final_dir[0];
-        offset_z += final_dir[1];
-
-        i32 cx = chunk_x + offset_x;
-        i32 cz = chunk_z + offset_z;
-
-        send_chunk(session, cx, cz);
-        state.loaded_chunks.insert(ChunkCoord(cx, cz));
-    }
-
-    // Store player state
-    player_states_[session] = std::move(state);
-
-    LOG_INFO_CAT("Sent " + std::to_string(player_states_[session].loaded_chunks.size()) +
-                 " initial chunks to player", LogCategory::Network);
+    LOG_INFO_CAT("Queued " + std::to_string(state.loaded_chunks.size()) +
+                 " initial chunks for player", LogCategory::Network);
 }
 
 void ChunkStreamingManager::remove_player(ClientSession* session) {
@@ -116,15 +104,18 @@ void ChunkStreamingManager::remove_player(ClientSession* session) {
                  std::to_string(it->second.loaded_chunks.size()) + " chunks loaded)",
                  LogCategory::Network);
 
-    // Unload all chunks for this player
+    // Unload all chunks for this player; queued ones were never sent
+    it->second.pending_chunks.clear();
     for (const auto& coord : it->second.loaded_chunks) {
-        unload_chunk(session, coord.x, coord.z);
+        release_chunk(it->second, coord);
     }
 
+    viewer_sessions_[it->second.viewer_slot] = nullptr;
+    free_viewer_slots_.push_back(it->second.viewer_slot);
     player_states_.erase(it);
 }
 
-void ChunkStreamingManager::update_player_chunks(ClientSession* session, f64 x, f64 z) {
+void ChunkStreamingManager::update_player_chunks(ClientSession* session, f64 x, f64 z, f32 yaw) {
     auto it = player_states_.find(session);
     if (it == player_states_.end()) {
         return;
@@ -132,6 +123,11 @@ void ChunkStreamingManager::update_player_chunks(ClientSession* session, f64 x,
 
     PlayerChunkState& state = it->second;
 
+    // What is still queued follows the view, also when the player only turns
+    if (!state.pending_chunks.empty() && yaw_difference(yaw, state.sorted_yaw) > RESORT_YAW_DEGREES) {
+        prioritize(state, x, z, yaw);
+    }
+
     // Check if player has moved significantly (8+ blocks)
     f64 dx = state.last_update_x - x;
     f64 dz = state.last_update_z - z;
@@ -186,18 +182,20 @@ void ChunkStreamingManager::update_player_chunks(ClientSession* session, f64 x,
         }
     }
 
-    // Send new chunks
+    // Queue new chunks
     for (const auto& coord : chunks_to_add) {
-        send_chunk(session, coord.x, coord.z);
-        state.loaded_chunks.insert(coord);
+        load_chunk(state, coord);
     }
 
-    // Unload far chunks
+    // Unload far chunks; queued ones are just dropped
     for (const auto& coord : chunks_to_remove) {
-        unload_chunk(session, coord.x, coord.z);
+        release_chunk(state, coord);
         state.loaded_chunks.erase(coord);
     }
 
+    // The queue was ordered around the old position
+    prioritize(state, x, z, yaw);
+
     if (!chunks_to_add.empty() || !chunks_to_remove.empty()) {
         LOG_DEBUG_CAT("Chunk update: +" + std::to_string(chunks_to_add.size()) +
                       " -" + std::to_string(chunks_to_remove.size()) +
@@ -210,6 +208,14 @@ void ChunkStreamingManager::update_player_chunks(ClientSession* session, f64 x,
     state.last_update_z = z;
 }
 
+void ChunkStreamingManager::tick() {
+    collect_compressed();
+
+    for (auto& [session, state] : player_states_) {
+        stream_chunks(state);
+    }
+}
+
 void ChunkStreamingManager::set_view_distance(i32 distance) {
     if (distance < 3 || distance > 15) {
         LOG_WARNING_CAT("Invalid view distance: " + std::to_string(distance), LogCategory::Network);
@@ -222,35 +228,268 @@ void ChunkStreamingManager::set_view_distance(i32 distance) {
                  LogCategory::Network);
 }
 
-void ChunkStreamingManager::send_chunk(ClientSession* session, i32 chunk_x, i32 chunk_z) {
-    if (!session || !chunk_manager_) {
+const ChunkViewers* ChunkStreamingManager::get_viewers(i32 chunk_x, i32 chunk_z) const {
+    auto it = chunk_viewers_.find(ChunkCoord(chunk_x, chunk_z));
+    return it != chunk_viewers_.end() ? &it->second : nullptr;
+}
+
+void ChunkStreamingManager::set_compression(const CompressionSettings& settings, bool adaptive) {
+    compression_ = settings;
+    payload_cache_.set_compression(settings);
+
+    adaptive_level_.reset();
+    if (adaptive) {
+        adaptive_level_.emplace(CompressionSettings::MIN_LEVEL, settings.level);
+    }
+}
+
+void ChunkStreamingManager::report_tick_time(f64 tick_ms, f64 budget_ms) {
+    if (!adaptive_level_) {
+        return;
+    }
+
+    i32 level = adaptive_level_->update(tick_ms, budget_ms);
+    if (level != compression_.level) {
+        LOG_DEBUG_CAT("Chunk compression level " + std::to_string(compression_.level) + " -> " +
+                      std::to_string(level), LogCategory::Performance);
+        compression_.level = level;
+        payload_cache_.set_compression(compression_);
+    }
+}
+
+bool ChunkStreamingManager::has_sent_chunk(ClientSession* session, i32 chunk_x, i32 chunk_z) const {
+    auto state = player_states_.find(session);
+    const ChunkViewers* viewers = get_viewers(chunk_x, chunk_z);
+    return state != player_states_.end() && viewers && viewers->contains(state->second.viewer_slot);
+}
+
+void ChunkStreamingManager::load_chunk(PlayerChunkState& state, ChunkCoord coord) {
+    state.loaded_chunks.insert(coord);
+    state.pending_chunks.push_back(coord);
+}
+
+void ChunkStreamingManager::prioritize(PlayerChunkState& state, f64 x, f64 z, f32 yaw) {
+    state.sorted_yaw = yaw;
+    if (state.pending_chunks.size() < 2) {
+        return;
+    }
+
+    // Beta yaw: 0 faces +Z, 90 faces -X
+    f64 yaw_radians = static_cast<f64>(yaw) * 3.14159265358979323846 / 180.0;
+    f64 facing_x = -std::sin(yaw_radians);
+    f64 facing_z = std::cos(yaw_radians);
+    ChunkCoord own(static_cast<i32>(std::floor(x)) >> 4, static_cast<i32>(std::floor(z)) >> 4);
+
+    priority_scratch_.clear();
+    for (ChunkCoord coord : state.pending_chunks) {
+        f64 dx = coord.x * 16.0 + 8.0 - x;
+        f64 dz = coord.z * 16.0 + 8.0 - z;
+        f64 distance = std::sqrt(dx * dx + dz * dz);
+        f64 facing = distance > 0.0 ? (dx * facing_x + dz * facing_z) / distance : 0.0;
+        f64 priority = coord == own ? -1.0 : distance * (1.0 - FACING_BIAS * facing);
+        priority_scratch_.emplace_back(priority, coord);
+    }
+
+    std::stable_sort(priority_scratch_.begin(), priority_scratch_.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (usize i = 0; i < priority_scratch_.size(); ++i) {
+        state.pending_chunks[i] = priority_scratch_[i].second;
+    }
+}
+
+void ChunkStreamingManager::release_chunk(PlayerChunkState& state, ChunkCoord coord) {
+    auto it = chunk_viewers_.find(coord);
+    if (it == chunk_viewers_.end() || !it->second.contains(state.viewer_slot)) {
+        // Still queued: the client never heard of it
+        std::erase(state.pending_chunks, coord);
+        if (it == chunk_viewers_.end()) {
+            payload_cache_.erase(coord);
+            stale_compressions_.erase(coord);
+        }
+        return;
+    }
+
+    unload_chunk(state.session, coord.x, coord.z);
+
+    it->second.erase(state.viewer_slot);
+    if (it->second.empty()) {
+        chunk_viewers_.erase(it);
+        payload_cache_.erase(coord);
+    }
+
+    if (chunk_released_callback_) {
+        chunk_released_callback_(state.session, coord.x, coord.z);
+    }
+}
+
+void ChunkStreamingManager::collect_compressed() {
+    {
+        std::lock_guard<std::mutex> lock(compressed_->mutex);
+        compressed_scratch_.swap(compressed_->done);
+    }
+
+    for (CompressedChunk& result : compressed_scratch_) {
+        compressing_.erase(result.coord);
+        if (!result.payload) {
+            LOG_ERROR_CAT("Failed to compress chunk (" + std::to_string(result.coord.x) + ", " +
+                          std::to_string(result.coord.z) + ")", LogCategory::Network);
+            continue;
+        }
+
+        // Released while it was compressing: nobody would ever take it out of the cache
+        if (!chunk_viewers_.contains(result.coord) && !is_queued(result.coord)) {
+            stale_compressions_.erase(result.coord);
+            continue;
+        }
+
+        // Changed since the snapshot; a chunk edited every tick would never catch up
+        Chunk* chunk = chunk_manager_->get_chunk_if_loaded(result.coord.x, result.coord.z);
+        if (chunk && chunk->get_version() != result.version) {
+            ++stale_compressions_[result.coord];
+        } else {
+            stale_compressions_.erase(result.coord);
+        }
+        payload_cache_.store(result.coord, result.version, std::move(result.payload));
+    }
+    compressed_scratch_.clear();
+}
+
+bool ChunkStreamingManager::compresses_inline(ChunkCoord coord) const {
+    if (!job_system_) {
+        return true;
+    }
+    auto it = stale_compressions_.find(coord);
+    return it != stale_compressions_.end() && it->second >= MAX_STALE_COMPRESSIONS;
+}
+
+bool ChunkStreamingManager::is_queued(ChunkCoord coord) const {
+    for (const auto& [session, state] : player_states_) {
+        if (std::find(state.pending_chunks.begin(), state.pending_chunks.end(), coord) !=
+            state.pending_chunks.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ChunkStreamingManager::stream_chunks(PlayerChunkState& state) {
+    if (!chunk_manager_) {
         return;
     }
 
+    // Keep the workers busy on the chunks this player needs next: loading or
+    // generating the ones that aren't in memory yet, compressing the rest
+    if (job_system_) {
+        usize window = std::min(state.pending_chunks.size(), MAX_COMPRESS_JOBS_PER_PLAYER);
+        for (usize i = 0; i < window && compressing_.size() < MAX_COMPRESS_JOBS; ++i) {
+            ChunkCoord coord = state.pending_chunks[i];
+            if (compressing_.contains(coord)) {
+                continue;
+            }
+
+            Chunk* chunk = chunk_manager_->get_chunk_if_loaded(coord.x, coord.z);
+            if (!chunk) {
+                chunk_manager_->prepare_chunk_async(coord.x, coord.z);
+            } else if (!compresses_inline(coord) && !payload_cache_.find(*chunk)) {
+                submit_compress(*chunk);
+            }
+        }
+    }
+
+    // Send in queue order, stopping at the first chunk that isn't ready or once
+    // this tick's share is out. A payload is only used if it matches the chunk's
+    // current version, so a block changed while it was compressing is never lost;
+    // a chunk whose payloads keep coming back stale is compressed here instead.
+    u32 sent = 0;
+    while (!state.pending_chunks.empty() && sent < chunks_per_tick_) {
+        ChunkCoord coord = state.pending_chunks.front();
+        if (compressing_.contains(coord)) {
+            break;
+        }
+
+        // The client isn't keeping up: leave the rest queued here rather than in its lanes
+        if (state.session->is_backlogged()) {
+            break;
+        }
+
+        Chunk* chunk;
+        if (job_system_) {
+            chunk = chunk_manager_->get_chunk_if_loaded(coord.x, coord.z);
+            if (!chunk) {
+                break;  // Still being prepared
+            }
+        } else {
+            chunk = chunk_manager_->get_chunk(coord.x, coord.z);
+        }
+        if (!chunk) {
+            LOG_WARNING_CAT("Failed to load chunk (" + std::to_string(coord.x) + ", " +
+                            std::to_string(coord.z) + ")", LogCategory::World);
+            state.pending_chunks.pop_front();
+            continue;
+        }
+
+        SharedBytes payload = compresses_inline(coord) ? payload_cache_.get(*chunk)
+                                                       : payload_cache_.find(*chunk);
+        if (!payload) {
+            break;  // Compressed on a later tick
+        }
+
+        state.pending_chunks.pop_front();
+        send_chunk(state, coord, std::move(payload));
+        ++sent;
+    }
+}
+
+void ChunkStreamingManager::submit_compress(const Chunk& chunk) {
+    using Layout = PacketMapChunk;
+
+    // The tick thread keeps changing the chunk, so the worker gets a copy
+    std::vector<u8> snapshot(Layout::TOTAL_DATA_SIZE);
+    u8* out = snapshot.data();
+    std::memcpy(out, chunk.get_blocks_data(), Layout::BLOCKS_SIZE);
+    out += Layout::BLOCKS_SIZE;
+    std::memcpy(out, chunk.get_metadata_data(), Layout::METADATA_SIZE);
+    out += Layout::METADATA_SIZE;
+    std::memcpy(out, chunk.get_block_light_data(), Layout::BLOCK_LIGHT_SIZE);
+    out += Layout::BLOCK_LIGHT_SIZE;
+    std::memcpy(out, chunk.get_sky_light_data(), Layout::SKY_LIGHT_SIZE);
+
+    ChunkCoord coord(chunk.get_x(), chunk.get_z());
+    u64 version = chunk.get_version();
+    compressing_[coord] = version;
+
+    job_system_->submit([done = compressed_, coord, version, settings = compression_,
+                         snapshot = std::move(snapshot)]() {
+        const u8* blocks = snapshot.data();
+        const u8* metadata = blocks + Layout::BLOCKS_SIZE;
+        const u8* block_light = metadata + Layout::METADATA_SIZE;
+        const u8* sky_light = block_light + Layout::BLOCK_LIGHT_SIZE;
+        SharedBytes payload = Layout::compress_sections(blocks, metadata, block_light, sky_light,
+                                                        settings);
+
+        std::lock_guard<std::mutex> lock(done->mutex);
+        done->done.push_back({coord, version, std::move(payload)});
+    });
+}
+
+void ChunkStreamingManager::send_chunk(PlayerChunkState& state, ChunkCoord coord,
+                                       SharedBytes payload) {
     // Send PreChunk packet to tell client to load this chunk
-    PacketPreChunk pre_chunk(chunk_x, chunk_z, true);
-    session->send_packet(pre_chunk);
+    PacketPreChunk pre_chunk(coord.x, coord.z, true);
+    state.session->send_packet(pre_chunk);
 
-    // Load/generate the chunk
-    Chunk* chunk = chunk_manager_->get_chunk(chunk_x, chunk_z);
-    if (chunk) {
-        // Create MapChunk packet with compressed data
-        PacketMapChunk map_chunk(chunk_x * 16, chunk_z * 16);
-        map_chunk.set_chunk_data(
-            chunk->get_blocks_data(),
-            chunk->get_metadata_data(),
-            chunk->get_block_light_data(),
-            chunk->get_sky_light_data()
-        );
-
-        session->send_packet(map_chunk);
-
-        // LOG_DEBUG_CAT("Sent chunk (" + std::to_string(chunk_x) + ", " +
-        //               std::to_string(chunk_z) + ") to player",
-        //               LogCategory::Network);
-    } else {
-        LOG_WARNING_CAT("Failed to load chunk (" + std::to_string(chunk_x) + ", " +
-                        std::to_string(chunk_z) + ")", LogCategory::World);
+    // Compressed once per chunk version, then shared by every player loading it
+    PacketMapChunk map_chunk(coord.x * 16, coord.z * 16);
+    map_chunk.compressed_data = std::move(payload);
+    state.session->send_packet(map_chunk);
+
+    // Broadcasts for this chunk reach the player from now on
+    chunk_viewers_[coord].insert(state.viewer_slot);
+    stale_compressions_.erase(coord);
+
+    if (chunk_sent_callback_) {
+        chunk_sent_callback_(state.session, coord.x, coord.z);
     }
 }
 
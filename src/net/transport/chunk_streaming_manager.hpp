@@ -1,6 +1,15 @@
 #pragma once
 
+#include "net/protocol/packet.hpp"
+#include "net/protocol/chunk_compressor.hpp"
 #include "util/types.hpp"
+#include <algorithm>
+#include <bit>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -10,6 +19,7 @@ namespace mcserver {
 class ClientSession;
 class ChunkManager;
 class Chunk;
+class JobSystem;
 
 // Represents a chunk coordinate pair (x, z)
 struct ChunkCoord {
@@ -37,54 +47,273 @@ struct ChunkCoordHash {
     }
 };
 
+// Players that have one chunk loaded, as a bitset over dense viewer slots
+class ChunkViewers {
+public:
+    void insert(u32 slot) {
+        if (slot / 64 >= words_.size()) {
+            words_.resize(slot / 64 + 1, 0);
+        }
+        u64 bit = u64{1} << (slot % 64);
+        count_ += (words_[slot / 64] & bit) ? 0 : 1;
+        words_[slot / 64] |= bit;
+    }
+
+    void erase(u32 slot) {
+        if (contains(slot)) {
+            words_[slot / 64] &= ~(u64{1} << (slot % 64));
+            --count_;
+        }
+    }
+
+    bool contains(u32 slot) const {
+        return slot / 64 < words_.size() && (words_[slot / 64] >> (slot % 64)) & 1;
+    }
+
+    bool empty() const { return count_ == 0; }
+    u32 size() const { return count_; }
+
+    // Call fn(slot) for every viewer, in slot order
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (usize word = 0; word < words_.size(); ++word) {
+            u64 bits = words_[word];
+            while (bits != 0) {
+                fn(static_cast<u32>(word * 64 + static_cast<usize>(std::countr_zero(bits))));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+private:
+    std::vector<u64> words_;
+    u32 count_ = 0;
+};
+
+// Compressed MapChunk payloads, shared by every session that loads the same chunk
+// Each entry remembers the chunk version it was built from, so a payload is only
+// compressed again after the chunk's data actually changed.
+class ChunkPayloadCache {
+public:
+    // Payload for the chunk's current contents (nullptr if compression failed)
+    SharedBytes get(const Chunk& chunk);
+
+    // Cached payload if it is still current, without compressing on a miss
+    SharedBytes find(const Chunk& chunk);
+
+    // Add a payload compressed elsewhere from the chunk at 'version'
+    void store(ChunkCoord coord, u64 version, SharedBytes payload) {
+        entries_[coord] = Entry{version, std::move(payload)};
+    }
+
+    // Forget a chunk, e.g. once no player has it loaded
+    void erase(ChunkCoord coord) { entries_.erase(coord); }
+
+    // Engine and level for payloads compressed on a miss
+    void set_compression(const CompressionSettings& settings) { compression_ = settings; }
+
+    usize size() const { return entries_.size(); }
+    u64 hits() const { return hits_; }
+    u64 misses() const { return misses_; }
+
+private:
+    struct Entry {
+        u64 version = 0;
+        SharedBytes payload;
+    };
+
+    std::unordered_map<ChunkCoord, Entry, ChunkCoordHash> entries_;
+    CompressionSettings compression_;
+    u64 hits_ = 0;
+    u64 misses_ = 0;
+};
+
 // Per-player chunk streaming state
 struct PlayerChunkState {
     ClientSession* session;
+    u32 viewer_slot;    // Bit index in ChunkViewers
     f64 last_update_x;  // Last position where chunks were updated
     f64 last_update_z;
+    f32 sorted_yaw;     // Facing pending_chunks was last ordered for
     std::unordered_set<ChunkCoord, ChunkCoordHash> loaded_chunks;
+    std::deque<ChunkCoord> pending_chunks;  // Loaded but not sent yet, in send order
 
-    PlayerChunkState() : session(nullptr), last_update_x(0.0), last_update_z(0.0) {}
-    PlayerChunkState(ClientSession* sess)
-        : session(sess), last_update_x(0.0), last_update_z(0.0) {}
+    PlayerChunkState()
+        : session(nullptr), viewer_slot(0), last_update_x(0.0), last_update_z(0.0), sorted_yaw(0.0f) {}
+    PlayerChunkState(ClientSession* sess, u32 slot)
+        : session(sess), viewer_slot(slot), last_update_x(0.0), last_update_z(0.0), sorted_yaw(0.0f) {}
 };
 
+// Called after a chunk has been sent to a player
+using ChunkSentCallback = std::function<void(ClientSession* session, i32 chunk_x, i32 chunk_z)>;
+
+// Called after a sent chunk has been unloaded from a player
+using ChunkReleasedCallback = std::function<void(ClientSession* session, i32 chunk_x, i32 chunk_z)>;
+
 // Manages chunk streaming for all connected players
 // Implements Minecraft Beta 1.7.3 PlayerManager logic
 class ChunkStreamingManager {
 public:
-    explicit ChunkStreamingManager(ChunkManager* chunk_manager, i32 view_distance = 10);
+    // Without a job system, chunks are compressed on the calling thread
+    explicit ChunkStreamingManager(ChunkManager* chunk_manager, i32 view_distance = 10,
+                                   JobSystem* job_system = nullptr);
     ~ChunkStreamingManager();
 
-    // Add player and send initial chunks in spiral pattern
-    void add_player(ClientSession* session, f64 x, f64 z);
+    // Add player and queue the chunks in view, nearest and in front first
+    void add_player(ClientSession* session, f64 x, f64 z, f32 yaw = 0.0f);
 
     // Remove player and unload all their chunks
     void remove_player(ClientSession* session);
 
-    // Update chunks for player if they've moved significantly (8+ blocks)
+    // Update chunks for player if they've moved significantly (8+ blocks); chunks
+    // still queued are re-ordered after a move or a turn, and dropped once out of view
     // Should be called every tick for active players
-    void update_player_chunks(ClientSession* session, f64 x, f64 z);
+    void update_player_chunks(ClientSession* session, f64 x, f64 z, f32 yaw);
+
+    // Send queued chunks whose payloads are ready and start compressing the next
+    // ones; call once per tick
+    void tick();
 
     // Set view distance (3-15 chunks, default 10)
     void set_view_distance(i32 distance);
     i32 get_view_distance() const { return view_distance_; }
 
+    // Chunks sent to each player per tick at most; the rest wait in its queue
+    void set_chunks_per_tick(u32 count) { chunks_per_tick_ = std::max<u32>(count, 1); }
+    u32 get_chunks_per_tick() const { return chunks_per_tick_; }
+
+    // Set callback for chunks sent to a player (e.g. to spawn the entities in them)
+    void set_chunk_sent_callback(ChunkSentCallback callback) {
+        chunk_sent_callback_ = std::move(callback);
+    }
+
+    // Set callback for chunks unloaded from a player (e.g. to destroy the entities in them)
+    void set_chunk_released_callback(ChunkReleasedCallback callback) {
+        chunk_released_callback_ = std::move(callback);
+    }
+
+    // True if the chunk has been sent to the player and not unloaded since
+    bool has_sent_chunk(ClientSession* session, i32 chunk_x, i32 chunk_z) const;
+
+    // Players that have a chunk loaded; nullptr if nobody does
+    const ChunkViewers* get_viewers(i32 chunk_x, i32 chunk_z) const;
+
+    // Session behind a viewer slot reported by ChunkViewers
+    ClientSession* get_viewer_session(u32 slot) const { return viewer_sessions_[slot]; }
+
+    // Wire-ready compressed payload of a chunk's current contents, cached while
+    // any player has the chunk loaded
+    SharedBytes get_chunk_payload(const Chunk& chunk) { return payload_cache_.get(chunk); }
+
+    // Call fn(ClientSession*) for every player that has the chunk loaded
+    template<typename Fn>
+    void for_each_viewer(i32 chunk_x, i32 chunk_z, Fn&& fn) const {
+        if (const ChunkViewers* viewers = get_viewers(chunk_x, chunk_z)) {
+            viewers->for_each([&](u32 slot) { fn(viewer_sessions_[slot]); });
+        }
+    }
+
+    // Compression jobs running on the job system
+    usize compress_jobs_in_flight() const { return compressing_.size(); }
+
+    // Compressed payloads held for chunks that are loaded or queued
+    usize cached_payload_count() const { return payload_cache_.size(); }
+
+    // Engine and level for chunk payloads; the level is the ceiling when adaptive
+    void set_compression(const CompressionSettings& settings, bool adaptive = false);
+    const CompressionSettings& get_compression() const { return compression_; }
+
+    // Account for the last tick's duration; with adaptive compression the level
+    // drops while ticks run close to 'budget_ms' and recovers once they don't
+    void report_tick_time(f64 tick_ms, f64 budget_ms);
+
+    // Bounds on compression jobs in flight: for the front of one player's queue,
+    // and across all players
+    static constexpr usize MAX_COMPRESS_JOBS_PER_PLAYER = 16;
+    static constexpr usize MAX_COMPRESS_JOBS = 64;
+
+    // Payloads of a chunk that came back from the workers already out of date
+    // before it is compressed on the tick thread instead (one retry)
+    static constexpr u32 MAX_STALE_COMPRESSIONS = 2;
+
+    static constexpr u32 DEFAULT_CHUNKS_PER_TICK = 5;
+
+    // Send order bias towards where the player looks: a chunk straight ahead ranks
+    // as if it were this fraction of its distance closer, one behind that much further
+    static constexpr f64 FACING_BIAS = 0.25;
+
+    // Turning further than this re-orders the chunks still queued
+    static constexpr f32 RESORT_YAW_DEGREES = 45.0f;
+
 private:
+    // Payload finished by a job system worker
+    struct CompressedChunk {
+        ChunkCoord coord;
+        u64 version;
+        SharedBytes payload;
+    };
+
+    // Handoff from the workers to the tick thread; shared with the jobs so it
+    // outlives any still running
+    struct CompressedChunks {
+        std::mutex mutex;
+        std::vector<CompressedChunk> done;
+    };
+
     ChunkManager* chunk_manager_;
     i32 view_distance_;  // In chunks (default 10 = 160 blocks radius)
+    u32 chunks_per_tick_ = DEFAULT_CHUNKS_PER_TICK;
+    JobSystem* job_system_;
+    CompressionSettings compression_;
+    std::optional<AdaptiveCompressionLevel> adaptive_level_;
 
     // Track player states
     std::unordered_map<ClientSession*, PlayerChunkState> player_states_;
 
-    // Spiral pattern for loading chunks (closest first)
-    // Directions: {1,0}, {0,1}, {-1,0}, {0,-1} (right, down, left, up)
-    static constexpr i32 spiral_dirs_[4][2] = {
-        {1, 0}, {0, 1}, {-1, 0}, {0, -1}
-    };
+    // Inverse of loaded_chunks, so broadcasts only reach players that have the chunk
+    std::unordered_map<ChunkCoord, ChunkViewers, ChunkCoordHash> chunk_viewers_;
+    std::vector<ClientSession*> viewer_sessions_;   // Indexed by viewer slot
+    std::vector<u32> free_viewer_slots_;
+    ChunkPayloadCache payload_cache_;
+
+    // Chunks being compressed, with the version that was snapshotted
+    std::unordered_map<ChunkCoord, u64, ChunkCoordHash> compressing_;
+    std::unordered_map<ChunkCoord, u32, ChunkCoordHash> stale_compressions_;  // Changed while compressing
+    std::shared_ptr<CompressedChunks> compressed_;
+    std::vector<CompressedChunk> compressed_scratch_;
+    std::vector<std::pair<f64, ChunkCoord>> priority_scratch_;   // Reused by prioritize()
+
+    ChunkSentCallback chunk_sent_callback_;
+    ChunkReleasedCallback chunk_released_callback_;
+
+    // Record a chunk as loaded and queue it for sending
+    void load_chunk(PlayerChunkState& state, ChunkCoord coord);
+
+    // Order the player's queue for a player at (x, z) facing 'yaw': the chunk it
+    // stands in first, then by distance, weighted by FACING_BIAS
+    void prioritize(PlayerChunkState& state, f64 x, f64 z, f32 yaw);
+
+    // Unload a chunk from the player and forget it (does not touch loaded_chunks)
+    void release_chunk(PlayerChunkState& state, ChunkCoord coord);
+
+    // Move finished payloads from the workers into the cache
+    void collect_compressed();
+
+    // True if the chunk waits in any player's queue
+    bool is_queued(ChunkCoord coord) const;
+
+    // True if the chunk is compressed on the tick thread: without a job system, or
+    // once it keeps changing faster than the workers compress it
+    bool compresses_inline(ChunkCoord coord) const;
+
+    // Compress the front of the player's queue and send what is ready, in order
+    void stream_chunks(PlayerChunkState& state);
+
+    // Snapshot the chunk and compress the copy on the job system
+    void submit_compress(const Chunk& chunk);
 
-    // Send a chunk to the client (PreChunk + MapChunk)
-    void send_chunk(ClientSession* session, i32 chunk_x, i32 chunk_z);
+    // Send a chunk to the client (PreChunk + MapChunk) and make it a viewer
+    void send_chunk(PlayerChunkState& state, ChunkCoord coord, SharedBytes payload);
 
     // Unload a chunk from the client (PreChunk with load=false)
     void unload_chunk(ClientSession* session, i32 chunk_x, i32 chunk_z);
@@ -0,0 +1,47 @@
+#include "connection_throttle.hpp"
+#include <algorithm>
+
+namespace mcserver {
+
+ConnectionThrottle::ConnectionThrottle(u32 burst, u32 per_minute)
+    : burst_(static_cast<f64>(burst))
+    , tokens_per_ms_(static_cast<f64>(per_minute) / 60000.0) {}
+
+void ConnectionThrottle::refill(Bucket& bucket, Clock::time_point now) const {
+    if (now > bucket.updated) {
+        f64 elapsed_ms = static_cast<f64>(Clock::to_us(now - bucket.updated)) / 1000.0;
+        bucket.tokens = std::min(burst_, bucket.tokens + elapsed_ms * tokens_per_ms_);
+        bucket.updated = now;
+    }
+}
+
+bool ConnectionThrottle::allow(const std::string& address, Clock::time_point now) {
+    if (!enabled()) {
+        return true;
+    }
+
+    auto [it, inserted] = buckets_.try_emplace(address, Bucket{burst_, now});
+    Bucket& bucket = it->second;
+    if (!inserted) {
+        refill(bucket, now);
+    }
+
+    if (bucket.tokens < 1.0) {
+        return false;
+    }
+    bucket.tokens -= 1.0;
+    return true;
+}
+
+void ConnectionThrottle::prune(Clock::time_point now) {
+    for (auto it = buckets_.begin(); it != buckets_.end();) {
+        refill(it->second, now);
+        if (it->second.tokens >= burst_) {
+            it = buckets_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace mcserver
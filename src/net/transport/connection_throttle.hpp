@@ -0,0 +1,41 @@
+#pragma once
+
+#include "platform/time/clock.hpp"
+#include "util/types.hpp"
+#include <string>
+#include <unordered_map>
+
+namespace mcserver {
+
+// Per-address connection rate limit
+// Every address has a token bucket holding up to 'burst' connections that refills
+// at 'per_minute'; a connection is let in while its bucket has a token. A burst
+// of 0 turns the limit off.
+class ConnectionThrottle {
+public:
+    ConnectionThrottle(u32 burst, u32 per_minute);
+
+    // Take a token for a new connection from 'address'. Returns false if it has none
+    bool allow(const std::string& address, Clock::time_point now);
+
+    // Forget addresses whose bucket is full again
+    void prune(Clock::time_point now);
+
+    bool enabled() const { return burst_ > 0.0; }
+    usize tracked_addresses() const { return buckets_.size(); }
+
+private:
+    struct Bucket {
+        f64 tokens;
+        Clock::time_point updated;
+    };
+
+    std::unordered_map<std::string, Bucket> buckets_;
+    f64 burst_;
+    f64 tokens_per_ms_;
+
+    // Add what 'bucket' earned since it was last updated
+    void refill(Bucket& bucket, Clock::time_point now) const;
+};
+
+} // namespace mcserver
@@ -0,0 +1,66 @@
+#include "entity_movement_tracker.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace mcserver {
+
+static bool fits_in_byte(i32 delta) {
+    return delta >= -128 && delta <= 127;
+}
+
+void EntityMovementTracker::track(i32 entity_id, const clientbound::EntityPosition& position,
+                                  u32 update_interval) {
+    Entry& entry = entries_[entity_id];
+    entry = Entry{};
+    entry.sent = position;
+    entry.update_interval = update_interval > 0 ? update_interval : 1;
+}
+
+bool EntityMovementTracker::update(i32 entity_id, const clientbound::EntityPosition& current,
+                                   PacketWriter& writer, clientbound::EntityPosition& previous) {
+    auto it = entries_.find(entity_id);
+    if (it == entries_.end()) {
+        return false;
+    }
+
+    Entry& entry = it->second;
+    ++entry.ticks_since_resync;
+    if (++entry.ticks % entry.update_interval != 0 || current == entry.sent) {
+        return false;
+    }
+
+    i32 dx = current.x - entry.sent.x;
+    i32 dy = current.y - entry.sent.y;
+    i32 dz = current.z - entry.sent.z;
+    bool moved = dx != 0 || dy != 0 || dz != 0;
+    bool rotated = current.yaw != entry.sent.yaw || current.pitch != entry.sent.pitch;
+
+    if (!fits_in_byte(dx) || !fits_in_byte(dy) || !fits_in_byte(dz) ||
+        entry.ticks_since_resync >= RESYNC_INTERVAL) {
+        clientbound::entity_teleport(writer, entity_id, current);
+        entry.ticks_since_resync = 0;
+    } else if (moved && rotated) {
+        clientbound::entity_look_move(writer, entity_id, static_cast<i8>(dx), static_cast<i8>(dy),
+                                      static_cast<i8>(dz), current.yaw, current.pitch);
+    } else if (moved) {
+        clientbound::entity_relative_move(writer, entity_id, static_cast<i8>(dx),
+                                          static_cast<i8>(dy), static_cast<i8>(dz));
+    } else {
+        clientbound::entity_look(writer, entity_id, current.yaw, current.pitch);
+    }
+
+    previous = entry.sent;
+    entry.sent = current;
+    return true;
+}
+
+bool EntityMovementTracker::droppable(const PacketWriter& update,
+                                      const clientbound::EntityPosition& entity,
+                                      const clientbound::EntityPosition& viewer) {
+    if (update.data().empty() || static_cast<PacketId>(update.data()[0]) == PacketId::EntityTeleport) {
+        return false;
+    }
+    return std::max(std::abs(entity.x - viewer.x), std::abs(entity.z - viewer.z)) > DROPPABLE_DISTANCE;
+}
+
+} // namespace mcserver
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "net/protocol/clientbound.hpp"
+#include "util/types.hpp"
+#include <unordered_map>
+
+namespace mcserver {
+
+// Last position and rotation sent to clients for each moving entity
+// Deltas are taken between the fixed-point values clients actually hold, not
+// between doubles, so a client's copy never drifts however many moves it applies.
+// Each entity is checked every 'update_interval' ticks and a packet goes out only
+// if its fixed-point state changed. EntityTeleport replaces the relative move when
+// a delta doesn't fit in a byte, and at most every RESYNC_INTERVAL ticks.
+class EntityMovementTracker {
+public:
+    static constexpr u32 RESYNC_INTERVAL = 400;
+
+    // Backlogged clients may skip updates of entities further away than this
+    static constexpr i32 DROPPABLE_DISTANCE = 32 * 32;  // 32 blocks, in 1/32 block units
+
+    // Start tracking from the position clients were spawned with
+    void track(i32 entity_id, const clientbound::EntityPosition& position, u32 update_interval);
+
+    void untrack(i32 entity_id) { entries_.erase(entity_id); }
+
+    // Position clients last received; nullptr if the entity isn't tracked
+    const clientbound::EntityPosition* find(i32 entity_id) const {
+        auto it = entries_.find(entity_id);
+        return it != entries_.end() ? &it->second.sent : nullptr;
+    }
+
+    // Advance the entity by one tick. If clients need an update, encode it into
+    // 'writer', set 'previous' to the position they had before and return true.
+    bool update(i32 entity_id, const clientbound::EntityPosition& current,
+                PacketWriter& writer, clientbound::EntityPosition& previous);
+
+    // True if an update encoded by update() may be left out for a backlogged client
+    // whose player is at 'viewer': relative moves and looks of entities beyond
+    // DROPPABLE_DISTANCE. Teleports are absolute and always sent
+    static bool droppable(const PacketWriter& update, const clientbound::EntityPosition& entity,
+                          const clientbound::EntityPosition& viewer);
+
+    usize size() const { return entries_.size(); }
+
+private:
+    struct Entry {
+        clientbound::EntityPosition sent;
+        u32 update_interval = 1;
+        u32 ticks = 0;
+        u32 ticks_since_resync = 0;
+    };
+
+    std::unordered_map<i32, Entry> entries_;
+};
+
+} // namespace mcserver
@@ -0,0 +1,203 @@
+#include "entity_tracker.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace mcserver {
+
+// Chunk coordinate containing a world position
+static i32 to_chunk_coord(f64 position) {
+    return static_cast<i32>(std::floor(position)) >> 4;
+}
+
+bool EntityTracker::Checked::move(f64 new_x, f64 new_z) {
+    x = new_x;
+    z = new_z;
+    if (dirty) {
+        return false;
+    }
+    return std::abs(x - checked_x) >= RECHECK_DISTANCE ||
+           std::abs(z - checked_z) >= RECHECK_DISTANCE ||
+           to_chunk_coord(x) != to_chunk_coord(checked_x) ||
+           to_chunk_coord(z) != to_chunk_coord(checked_z);
+}
+
+void EntityTracker::add_viewer(ClientSession* session, i32 self_id, f64 x, f64 z) {
+    if (has_viewer(session)) {
+        remove_viewer(session);
+    }
+
+    u32 slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = static_cast<u32>(viewers_.size());
+        viewers_.emplace_back();
+    }
+    slots_[session] = slot;
+
+    Viewer& viewer = viewers_[slot];
+    viewer = Viewer{};
+    viewer.session = session;
+    viewer.self_id = self_id;
+    viewer.position.x = x;
+    viewer.position.z = z;
+    mark_viewer(slot);
+}
+
+void EntityTracker::remove_viewer(ClientSession* session) {
+    auto it = slots_.find(session);
+    if (it == slots_.end()) {
+        return;
+    }
+    u32 slot = it->second;
+    slots_.erase(it);
+
+    // The client is gone, so nothing is sent to it
+    Viewer& viewer = viewers_[slot];
+    for (i32 entity_id : viewer.visible) {
+        auto entity = entities_.find(entity_id);
+        if (entity != entities_.end()) {
+            entity->second.viewers.erase(slot);
+        }
+    }
+    i32 self_id = viewer.self_id;
+    viewer = Viewer{};
+    free_slots_.push_back(slot);
+
+    remove_entity(self_id);
+}
+
+void EntityTracker::move_viewer(ClientSession* session, f64 x, f64 z) {
+    auto it = slots_.find(session);
+    if (it != slots_.end() && viewers_[it->second].position.move(x, z)) {
+        mark_viewer(it->second);
+    }
+}
+
+void EntityTracker::chunks_changed(ClientSession* session) {
+    auto it = slots_.find(session);
+    if (it != slots_.end() && !viewers_[it->second].position.dirty) {
+        mark_viewer(it->second);
+    }
+}
+
+void EntityTracker::add_entity(i32 entity_id, TrackedEntityKind kind, f64 x, f64 z, f64 range) {
+    // An ID can be freed and handed out again before the old entity was removed
+    if (has_entity(entity_id)) {
+        remove_entity(entity_id);
+    }
+
+    Entity& entity = entities_[entity_id];
+    entity.kind = kind;
+    entity.range = range;
+    entity.position.x = x;
+    entity.position.z = z;
+    mark_entity(entity_id, entity);
+}
+
+void EntityTracker::remove_entity(i32 entity_id) {
+    auto it = entities_.find(entity_id);
+    if (it == entities_.end()) {
+        return;
+    }
+
+    it->second.viewers.for_each([&](u32 slot) {
+        viewers_[slot].visible.erase(entity_id);
+        if (destroy_callback_) {
+            destroy_callback_(viewers_[slot].session, entity_id);
+        }
+    });
+    entities_.erase(it);
+}
+
+void EntityTracker::move_entity(i32 entity_id, f64 x, f64 z) {
+    auto it = entities_.find(entity_id);
+    if (it != entities_.end() && it->second.position.move(x, z)) {
+        mark_entity(entity_id, it->second);
+    }
+}
+
+void EntityTracker::update() {
+    // Viewers that moved: every entity against them
+    for (u32 slot : dirty_viewers_) {
+        Viewer& viewer = viewers_[slot];
+        if (!viewer.session) {
+            continue;
+        }
+        viewer.position.dirty = false;
+        viewer.position.checked_x = viewer.position.x;
+        viewer.position.checked_z = viewer.position.z;
+        for (auto& [entity_id, entity] : entities_) {
+            check(slot, entity_id, entity);
+        }
+    }
+    dirty_viewers_.clear();
+
+    // Entities that moved: them against every viewer
+    for (i32 entity_id : dirty_entities_) {
+        auto it = entities_.find(entity_id);
+        if (it == entities_.end()) {
+            continue;
+        }
+        Entity& entity = it->second;
+        entity.position.dirty = false;
+        entity.position.checked_x = entity.position.x;
+        entity.position.checked_z = entity.position.z;
+        for (const auto& [session, slot] : slots_) {
+            check(slot, entity_id, entity);
+        }
+    }
+    dirty_entities_.clear();
+}
+
+usize EntityTracker::visible_count(ClientSession* session) const {
+    auto it = slots_.find(session);
+    return it != slots_.end() ? viewers_[it->second].visible.size() : 0;
+}
+
+bool EntityTracker::is_visible(ClientSession* session, i32 entity_id) const {
+    auto it = slots_.find(session);
+    return it != slots_.end() && viewers_[it->second].visible.contains(entity_id);
+}
+
+void EntityTracker::check(u32 slot, i32 entity_id, Entity& entity) {
+    Viewer& viewer = viewers_[slot];
+    if (entity_id == viewer.self_id) {
+        return;
+    }
+
+    f64 distance = std::max(std::abs(entity.position.x - viewer.position.x),
+                            std::abs(entity.position.z - viewer.position.z));
+    bool chunk_visible = !chunk_visible_ ||
+                         chunk_visible_(viewer.session, to_chunk_coord(entity.position.x),
+                                        to_chunk_coord(entity.position.z));
+
+    if (entity.viewers.contains(slot)) {
+        if (!chunk_visible || distance > entity.range + DESPAWN_MARGIN) {
+            entity.viewers.erase(slot);
+            viewer.visible.erase(entity_id);
+            if (destroy_callback_) {
+                destroy_callback_(viewer.session, entity_id);
+            }
+        }
+    } else if (chunk_visible && distance <= entity.range) {
+        entity.viewers.insert(slot);
+        viewer.visible.insert(entity_id);
+        if (spawn_callback_) {
+            spawn_callback_(viewer.session, entity_id, entity.kind);
+        }
+    }
+}
+
+void EntityTracker::mark_viewer(u32 slot) {
+    viewers_[slot].position.dirty = true;
+    dirty_viewers_.push_back(slot);
+}
+
+void EntityTracker::mark_entity(i32 entity_id, Entity& entity) {
+    entity.position.dirty = true;
+    dirty_entities_.push_back(entity_id);
+}
+
+} // namespace mcserver
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "net/transport/chunk_streaming_manager.hpp"
+#include "util/types.hpp"
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mcserver {
+
+class ClientSession;
+
+// What a tracked entity is, so the spawn callback knows which packet to build
+enum class TrackedEntityKind : u8 {
+    Player,
+    Mob,
+    Item
+};
+
+// Called when a viewer's client should learn about an entity, or forget it
+using EntitySpawnCallback = std::function<void(ClientSession* viewer, i32 entity_id,
+                                               TrackedEntityKind kind)>;
+using EntityDestroyCallback = std::function<void(ClientSession* viewer, i32 entity_id)>;
+
+// True if the viewer's client has the chunk loaded, so entities in it can be spawned
+using ChunkVisibleFn = std::function<bool(ClientSession* viewer, i32 chunk_x, i32 chunk_z)>;
+
+// Which entities each player's client has spawned
+// An entity is spawned to a viewer once it is within its tracking range (square,
+// on the XZ plane) and in a chunk the client has loaded, and destroyed again once
+// it is DESPAWN_MARGIN blocks past the range or its chunk is unloaded; the margin
+// keeps entities near the edge from flickering in and out. Pairs are only re-checked
+// for viewers and entities that moved RECHECK_DISTANCE blocks or changed chunk
+// since their last check, so a quiet server costs nothing per tick.
+class EntityTracker {
+public:
+    static constexpr f64 DESPAWN_MARGIN = 16.0;
+    static constexpr f64 RECHECK_DISTANCE = 4.0;
+
+    void set_spawn_callback(EntitySpawnCallback callback) { spawn_callback_ = std::move(callback); }
+    void set_destroy_callback(EntityDestroyCallback callback) { destroy_callback_ = std::move(callback); }
+    void set_chunk_visible_fn(ChunkVisibleFn fn) { chunk_visible_ = std::move(fn); }
+
+    // Start spawning entities to a client; 'self_id' (its own player) is skipped
+    void add_viewer(ClientSession* session, i32 self_id, f64 x, f64 z);
+
+    // Forget a client and destroy its player entity for everyone else
+    void remove_viewer(ClientSession* session);
+
+    bool has_viewer(ClientSession* session) const { return slots_.contains(session); }
+
+    void move_viewer(ClientSession* session, f64 x, f64 z);
+
+    // The client loaded or dropped a chunk: re-check its entities on the next update
+    void chunks_changed(ClientSession* session);
+
+    // Start tracking an entity; it is spawned to viewers on the next update
+    void add_entity(i32 entity_id, TrackedEntityKind kind, f64 x, f64 z, f64 range);
+
+    // Stop tracking an entity and destroy it for every viewer that has it
+    void remove_entity(i32 entity_id);
+
+    bool has_entity(i32 entity_id) const { return entities_.contains(entity_id); }
+
+    void move_entity(i32 entity_id, f64 x, f64 z);
+
+    // Spawn and destroy for everything that moved since the last update
+    void update();
+
+    // Call fn(ClientSession*) for every viewer that has the entity spawned
+    template<typename Fn>
+    void for_each_viewer(i32 entity_id, Fn&& fn) const {
+        auto it = entities_.find(entity_id);
+        if (it != entities_.end()) {
+            it->second.viewers.for_each([&](u32 slot) { fn(viewers_[slot].session); });
+        }
+    }
+
+    // Entities spawned to a viewer's client
+    usize visible_count(ClientSession* session) const;
+
+    // True if the viewer's client has the entity spawned
+    bool is_visible(ClientSession* session, i32 entity_id) const;
+
+    usize viewer_count() const { return slots_.size(); }
+    usize entity_count() const { return entities_.size(); }
+
+private:
+    // Position as of the last check, and whether it moved far enough since
+    struct Checked {
+        f64 x = 0.0;
+        f64 z = 0.0;
+        f64 checked_x = 0.0;
+        f64 checked_z = 0.0;
+        bool dirty = false;     // Queued for the next update
+
+        // True if the move makes a re-check necessary
+        bool move(f64 new_x, f64 new_z);
+    };
+
+    struct Viewer {
+        ClientSession* session = nullptr;
+        i32 self_id = 0;
+        Checked position;
+        std::unordered_set<i32> visible;
+    };
+
+    struct Entity {
+        TrackedEntityKind kind = TrackedEntityKind::Mob;
+        f64 range = 0.0;
+        Checked position;
+        ChunkViewers viewers;   // Viewer slots that have it spawned
+    };
+
+    std::vector<Viewer> viewers_;               // Indexed by slot
+    std::vector<u32> free_slots_;
+    std::unordered_map<ClientSession*, u32> slots_;
+    std::unordered_map<i32, Entity> entities_;
+    std::vector<u32> dirty_viewers_;
+    std::vector<i32> dirty_entities_;
+
+    EntitySpawnCallback spawn_callback_;
+    EntityDestroyCallback destroy_callback_;
+    ChunkVisibleFn chunk_visible_;
+
+    // Spawn or destroy one entity for one viewer if its visibility changed
+    void check(u32 slot, i32 entity_id, Entity& entity);
+
+    void mark_viewer(u32 slot);
+    void mark_entity(i32 entity_id, Entity& entity);
+};
+
+} // namespace mcserver
@@ -0,0 +1,471 @@
+#include "network_io_thread.hpp"
+#include "net/session/connection.hpp"
+#include "util/log/logger.hpp"
+#include <algorithm>
+#include <cerrno>
+
+namespace mcserver {
+
+// Upper bound on how long the thread sleeps without being woken; Windows has no
+// poller wakeup, so it relies on a short timeout instead
+#ifdef PLATFORM_WINDOWS
+static constexpr i32 IO_WAIT_TIMEOUT_MS = 2;
+#else
+static constexpr i32 IO_WAIT_TIMEOUT_MS = 100;
+#endif
+
+// io_uring requests are tagged with the operation in the low bits of the
+// Connection pointer (connections are at least 8-byte aligned)
+static constexpr u64 OP_MASK = 0x7;
+static constexpr u64 OP_RECV = 1;
+static constexpr u64 OP_SEND = 2;
+static constexpr u64 OP_CANCEL = 3;
+
+static u64 tag(Connection& connection, u64 op) {
+    return reinterpret_cast<u64>(&connection) | op;
+}
+
+NetworkIoThread::NetworkIoThread(u32 index, NetworkBackend backend, u32 ring_entries)
+    : index_(index)
+    , backend_(backend)
+    , ring_entries_(ring_entries) {}
+
+NetworkIoThread::~NetworkIoThread() {
+    stop();
+}
+
+Result<void> NetworkIoThread::start() {
+    if (running_.load()) {
+        return ErrorCode::AlreadyExists;
+    }
+
+    if (backend_ == NetworkBackend::IoUring) {
+        auto ring_result = ring_.open(ring_entries_);
+        if (ring_result) {
+            ring_result = ring_.setup_buffers(RECV_BUFFER_COUNT, RECV_BUFFER_SIZE);
+        }
+        if (!ring_result) {
+            LOG_WARNING_CAT("io_uring unavailable on network I/O thread " + std::to_string(index_) +
+                            ", falling back to poll", LogCategory::Network);
+            ring_.close();
+            backend_ = NetworkBackend::Poll;
+        }
+    }
+
+    if (backend_ == NetworkBackend::Poll) {
+        auto open_result = poller_.open();
+        if (!open_result) {
+            return open_result;
+        }
+    }
+
+    running_.store(true);
+    thread_ = Thread([this]() { run(); });
+
+    return Result<void>();
+}
+
+void NetworkIoThread::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    wake();
+    thread_.join();
+
+    // Shutting the sockets down completes any io_uring requests still using
+    // connection buffers before the ring is torn down
+    for (auto& connection : connections_) {
+        connection->socket().shutdown();
+    }
+    ring_.close();
+
+    // Sockets close when the last reference to each connection goes away
+    connections_.clear();
+    {
+        LockGuard<Mutex> lock(pending_mutex_);
+        pending_.clear();
+    }
+    connection_count_.store(0);
+    poller_.close();
+}
+
+void NetworkIoThread::add_connection(std::shared_ptr<Connection> connection) {
+    {
+        LockGuard<Mutex> lock(pending_mutex_);
+        pending_.push_back(std::move(connection));
+    }
+    connection_count_.fetch_add(1, std::memory_order_relaxed);
+    wake();
+}
+
+NetworkIoThread* NetworkIoThread::least_loaded(
+        const std::vector<std::unique_ptr<NetworkIoThread>>& threads) {
+    NetworkIoThread* target = threads.front().get();
+    for (const auto& thread : threads) {
+        if (thread->connection_count() < target->connection_count()) {
+            target = thread.get();
+        }
+    }
+    return target;
+}
+
+void NetworkIoThread::request_flush() {
+    flush_requested_.store(true, std::memory_order_release);
+    wake();
+}
+
+void NetworkIoThread::wake() {
+    if (backend_ == NetworkBackend::IoUring) {
+        ring_.wake();
+    } else {
+        poller_.wake();
+    }
+}
+
+void NetworkIoThread::run() {
+    if (backend_ == NetworkBackend::IoUring) {
+        run_uring();
+    } else {
+        run_poll();
+    }
+}
+
+void NetworkIoThread::run_poll() {
+    while (running_.load(std::memory_order_acquire)) {
+        auto wait_result = poller_.wait(events_, IO_WAIT_TIMEOUT_MS);
+        if (!wait_result) {
+            LOG_ERROR_CAT("Network I/O thread " + std::to_string(index_) + " poll failed",
+                          LogCategory::Network);
+            continue;
+        }
+
+        adopt_pending();
+
+        bool any_closed = false;
+        for (const auto& event : events_) {
+            auto* connection = static_cast<Connection*>(event.user_data);
+            if (connection->is_closed()) {
+                continue;
+            }
+
+            if (event.flags & (PollFlags::Readable | PollFlags::Hangup)) {
+                connection->receive();
+                if (connection->inbound_count() >= Connection::MAX_QUEUED_INBOUND) {
+                    // Tick thread is behind; leave further data in the kernel
+                    connection->reading_paused_ = true;
+                }
+            }
+
+            if ((event.flags & PollFlags::Writable) && !connection->is_closed()) {
+                connection->flush();
+            }
+
+            if (connection->is_closed()) {
+                any_closed = true;
+                continue;
+            }
+
+            update_interest(*connection);
+        }
+
+        if (flush_requested_.exchange(false, std::memory_order_acq_rel)) {
+            any_closed |= service_connections();
+        }
+
+        if (any_closed) {
+            remove_closed();
+        }
+    }
+}
+
+void NetworkIoThread::adopt_pending() {
+    std::vector<std::shared_ptr<Connection>> adopted;
+    {
+        LockGuard<Mutex> lock(pending_mutex_);
+        adopted.swap(pending_);
+    }
+
+    for (auto& connection : adopted) {
+        if (backend_ == NetworkBackend::IoUring) {
+            arm_receive(*connection);
+            connections_.push_back(std::move(connection));
+            continue;
+        }
+
+        auto add_result = poller_.add(connection->socket().native_handle(),
+                                      PollFlags::Readable, connection.get());
+        if (!add_result) {
+            connection->mark_closed("Failed to register socket");
+            connection_count_.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        connection->registered_interest_ = PollFlags::Readable;
+        connections_.push_back(std::move(connection));
+    }
+}
+
+bool NetworkIoThread::service_connections() {
+    bool any_closed = false;
+    Clock::time_point now = Clock::now();
+
+    for (auto& connection : connections_) {
+        if (connection->is_closed()) {
+            any_closed = true;
+            continue;
+        }
+
+        connection->sample_round_trip(now);
+
+        // Resume reading once the tick thread has caught up
+        if (connection->reading_paused_ &&
+            connection->inbound_count() < Connection::MAX_QUEUED_INBOUND / 2) {
+            connection->reading_paused_ = false;
+            connection->decode_buffered();
+        }
+
+        if (connection->has_output() || connection->has_unsent()) {
+            connection->flush();
+        }
+
+        if (connection->close_requested() && !connection->is_closed()) {
+            // Best-effort: whatever didn't fit in the socket buffer is dropped
+            connection->mark_closed("Closed by server");
+        }
+
+        if (connection->is_closed()) {
+            any_closed = true;
+            continue;
+        }
+
+        update_interest(*connection);
+    }
+
+    return any_closed;
+}
+
+void NetworkIoThread::update_interest(Connection& connection) {
+    if (connection.is_closed()) {
+        return;
+    }
+
+    u32 interest = PollFlags::None;
+    if (!connection.reading_paused_) {
+        interest |= PollFlags::Readable;
+    }
+    if (connection.has_unsent()) {
+        interest |= PollFlags::Writable;
+    }
+
+    if (interest != connection.registered_interest_) {
+        poller_.modify(connection.socket().native_handle(), interest, &connection);
+        connection.registered_interest_ = interest;
+    }
+}
+
+void NetworkIoThread::remove_closed() {
+    auto it = connections_.begin();
+    while (it != connections_.end()) {
+        Connection& connection = **it;
+        if (!connection.is_closed()) {
+            ++it;
+            continue;
+        }
+
+        poller_.remove(connection.socket().native_handle());
+        connection.socket().shutdown();
+        connection.socket().close();
+
+        connection_count_.fetch_sub(1, std::memory_order_relaxed);
+        it = connections_.erase(it);
+    }
+}
+
+void NetworkIoThread::run_uring() {
+    while (running_.load(std::memory_order_acquire)) {
+        // Everything prepared since the last pass (receives, sends) goes out in this call
+        auto wait_result = ring_.submit_and_wait(completions_, IO_WAIT_TIMEOUT_MS);
+        if (!wait_result) {
+            LOG_ERROR_CAT("Network I/O thread " + std::to_string(index_) + " io_uring wait failed",
+                          LogCategory::Network);
+            continue;
+        }
+
+        adopt_pending();
+
+        for (const auto& completion : completions_) {
+            handle_completion(completion);
+        }
+
+        if (flush_requested_.exchange(false, std::memory_order_acq_rel)) {
+            service_connections_uring();
+        }
+
+        if (reap_closed_) {
+            remove_closed_uring();
+        }
+    }
+}
+
+void NetworkIoThread::handle_completion(const IoCompletion& completion) {
+    u64 op = completion.user_data & OP_MASK;
+    if (op == OP_CANCEL) {
+        return;
+    }
+
+    auto* connection = reinterpret_cast<Connection*>(completion.user_data & ~OP_MASK);
+
+    if (op == OP_RECV) {
+        if (!(completion.flags & IoCompletionFlags::More)) {
+            connection->recv_armed_ = false;
+        }
+
+        if (completion.flags & IoCompletionFlags::Buffer) {
+            if (completion.result > 0) {
+                connection->on_received(ring_.buffer_data(completion.buffer_id),
+                                        static_cast<usize>(completion.result));
+            }
+            ring_.recycle_buffer(completion.buffer_id);
+        }
+
+        if (completion.result == 0) {
+            connection->mark_closed("Connection closed by client");
+        } else if (completion.result < 0 && completion.result != -ENOBUFS &&
+                   completion.result != -ECANCELED) {
+            connection->mark_closed("Network error");
+        }
+
+        if (!connection->is_closed() && !connection->reading_paused_ &&
+            connection->inbound_count() >= Connection::MAX_QUEUED_INBOUND) {
+            // Tick thread is behind; stop receiving until it catches up
+            connection->reading_paused_ = true;
+            if (connection->recv_armed_) {
+                ring_.prep_cancel(tag(*connection, OP_RECV), tag(*connection, OP_CANCEL));
+            }
+        }
+
+        // Multishot receives end on ENOBUFS or after a kernel-side limit; keep going
+        if (!connection->recv_armed_ && !connection->reading_paused_) {
+            arm_receive(*connection);
+        }
+    } else if (op == OP_SEND) {
+        connection->send_in_flight_ = false;
+
+        if (completion.result == -EAGAIN) {
+            // Socket buffer full: back-pressure, try again with the same output
+            submit_send(*connection);
+        } else if (completion.result < 0) {
+            connection->mark_closed("Send error");
+        } else {
+            connection->complete_send(static_cast<usize>(completion.result));
+
+            if (connection->close_requested()) {
+                // Best-effort: the queued output got one attempt before closing
+                connection->mark_closed("Closed by server");
+            } else {
+                // Rest of a partial write, or output queued while this one was in flight
+                submit_send(*connection);
+            }
+        }
+    }
+
+    if (connection->is_closed()) {
+        reap_closed_ = true;
+    }
+}
+
+void NetworkIoThread::service_connections_uring() {
+    Clock::time_point now = Clock::now();
+
+    for (auto& connection : connections_) {
+        if (connection->is_closed()) {
+            continue;
+        }
+
+        connection->sample_round_trip(now);
+
+        // Resume reading once the tick thread has caught up
+        if (connection->reading_paused_ &&
+            connection->inbound_count() < Connection::MAX_QUEUED_INBOUND / 2) {
+            connection->reading_paused_ = false;
+            connection->decode_buffered();
+            if (!connection->recv_armed_) {
+                arm_receive(*connection);
+            }
+        }
+
+        submit_send(*connection);
+
+        // With a send in flight, the close happens when it completes
+        if (connection->close_requested() && !connection->send_in_flight_) {
+            connection->mark_closed("Closed by server");
+        }
+
+        if (connection->is_closed()) {
+            reap_closed_ = true;
+        }
+    }
+}
+
+void NetworkIoThread::arm_receive(Connection& connection) {
+    if (connection.is_closed() || connection.recv_armed_) {
+        return;
+    }
+
+    if (ring_.prep_recv_multishot(connection.socket().native_handle(), tag(connection, OP_RECV))) {
+        connection.recv_armed_ = true;
+    } else {
+        connection.mark_closed("Failed to queue receive");
+        reap_closed_ = true;
+    }
+}
+
+void NetworkIoThread::submit_send(Connection& connection) {
+    if (connection.is_closed() || connection.send_in_flight_ || !connection.stage_output()) {
+        return;
+    }
+
+    // The staged segments are left alone until the completion arrives
+    usize count = 0;
+    const IoSlice* slices = connection.gather_unsent(count);
+    if (ring_.prep_send_vectored(connection.socket().native_handle(), slices, count,
+                                 tag(connection, OP_SEND))) {
+        connection.send_in_flight_ = true;
+    } else {
+        connection.mark_closed("Failed to queue send");
+        reap_closed_ = true;
+    }
+}
+
+void NetworkIoThread::remove_closed_uring() {
+    reap_closed_ = false;
+
+    auto it = connections_.begin();
+    while (it != connections_.end()) {
+        Connection& connection = **it;
+        if (!connection.is_closed()) {
+            ++it;
+            continue;
+        }
+
+        // Shutting down completes the multishot receive and any pending send
+        if (!connection.io_shut_down_) {
+            connection.socket().shutdown();
+            connection.io_shut_down_ = true;
+        }
+
+        // The kernel may still write into this connection's buffers
+        if (connection.recv_armed_ || connection.send_in_flight_) {
+            reap_closed_ = true;
+            ++it;
+            continue;
+        }
+
+        connection.socket().close();
+        connection_count_.fetch_sub(1, std::memory_order_relaxed);
+        it = connections_.erase(it);
+    }
+}
+
+} // namespace mcserver
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "platform/net/poller.hpp"
+#include "platform/net/io_ring.hpp"
+#include "platform/thread/thread.hpp"
+#include "platform/thread/mutex.hpp"
+#include "util/types.hpp"
+#include "util/result.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace mcserver {
+
+class Connection;
+
+// How the I/O threads drive their sockets
+enum class NetworkBackend {
+    Poll,       // Readiness (epoll / poll) plus non-blocking send/recv
+    IoUring     // Completion-based: multishot receives and batched sends (Linux only)
+};
+
+// Network I/O worker owning one shard of client connections
+// Reads, frames and decodes inbound packets into each connection's queue and
+// writes the output the tick thread has queued, so socket work never runs on
+// the tick thread. Connections stay on the same shard for their whole lifetime.
+class NetworkIoThread {
+public:
+    // io_uring provided receive buffers per thread
+    static constexpr u32 RECV_BUFFER_COUNT = 256;
+    static constexpr u32 RECV_BUFFER_SIZE = 4096;
+
+    // ring_entries: io_uring submission queue size; a ring the kernel refuses to
+    // set up falls back to the Poll backend in start()
+    NetworkIoThread(u32 index, NetworkBackend backend, u32 ring_entries = IoRing::DEFAULT_ENTRIES);
+    ~NetworkIoThread();
+
+    NetworkIoThread(const NetworkIoThread&) = delete;
+    NetworkIoThread& operator=(const NetworkIoThread&) = delete;
+
+    // Falls back to the Poll backend if io_uring is unavailable
+    Result<void> start();
+    void stop();
+
+    // Hand a freshly accepted connection to this shard (thread-safe)
+    void add_connection(std::shared_ptr<Connection> connection);
+
+    // Write queued output, resume paused readers and close connections whose
+    // session asked for it. Called by the tick thread once per tick (thread-safe)
+    void request_flush();
+
+    // Shard a new connection goes to: the one with the fewest connections, the
+    // lowest index on a tie
+    static NetworkIoThread* least_loaded(const std::vector<std::unique_ptr<NetworkIoThread>>& threads);
+
+    u32 index() const { return index_; }
+    NetworkBackend backend() const { return backend_; }
+    usize connection_count() const { return connection_count_.load(std::memory_order_relaxed); }
+
+private:
+    u32 index_;
+    NetworkBackend backend_;
+    u32 ring_entries_;
+    Thread thread_;
+    Poller poller_;
+    IoRing ring_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> flush_requested_{false};
+    std::atomic<usize> connection_count_{0};
+
+    Mutex pending_mutex_;
+    std::vector<std::shared_ptr<Connection>> pending_;
+
+    // Owned by the I/O thread
+    std::vector<std::shared_ptr<Connection>> connections_;
+    std::vector<PollEvent> events_;
+    std::vector<IoCompletion> completions_;
+    bool reap_closed_ = false;  // io_uring: closed connections may still have requests in flight
+
+    void wake();
+    void run();
+    void adopt_pending();
+
+    // Poll backend
+    void run_poll();
+    bool service_connections();
+    void update_interest(Connection& connection);
+    void remove_closed();
+
+    // io_uring backend
+    void run_uring();
+    void handle_completion(const IoCompletion& completion);
+    void service_connections_uring();
+    void arm_receive(Connection& connection);
+    void submit_send(Connection& connection);
+    void remove_closed_uring();
+};
+
+} // namespace mcserver
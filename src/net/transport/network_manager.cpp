@@ -1,20 +1,14 @@
 #include "network_manager.hpp"
+#include "net/protocol/clientbound.hpp"
 #include "net/protocol/packets/chat.hpp"
-#include "net/protocol/packets/named_entity_spawn.hpp"
-#include "net/protocol/packets/destroy_entity.hpp"
-#include "net/protocol/packets/block_change.hpp"
 #include "net/protocol/packets/map_chunk.hpp"
-#include "net/protocol/packets/mob_spawn.hpp"
-#include "net/protocol/packets/pickup_spawn.hpp"
-#include "net/protocol/packets/collect.hpp"
-#include "net/protocol/packets/entity_relative_move.hpp"
-#include "net/protocol/packets/entity_look.hpp"
-#include "net/protocol/packets/entity_look_move.hpp"
 #include "net/protocol/packets/update_health.hpp"
-#include "net/protocol/packets/entity_status.hpp"
 #include "net/protocol/packets/respawn.hpp"
 #include "net/protocol/packets/player_position_look.hpp"
+#include "net/protocol/packets/kick.hpp"
 #include "world/chunk/chunk_manager.hpp"
+#include "core/config/server_config.hpp"
+#include "core/tick/tick_manager.hpp"
 #include "entity/player.hpp"
 #include "entity/mob/mob.hpp"
 #include "entity/item/item_entity.hpp"
@@ -24,32 +18,139 @@
 
 namespace mcserver {
 
-NetworkManager::NetworkManager(ChunkManager* chunk_manager, const std::string& world_path)
+// Beta's entity tracking ranges, in blocks
+static constexpr f64 PLAYER_TRACKING_RANGE = 512.0;
+static constexpr f64 MOB_TRACKING_RANGE = 160.0;
+static constexpr f64 ITEM_TRACKING_RANGE = 64.0;
+
+// io_uring backend: accepted connections kept waiting for the accept budget; the
+// listen backlog holds the same number when polling
+static constexpr usize MAX_QUEUED_ACCEPTS = 128;
+
+// Ticks between sweeps of connection throttle buckets that are full again
+static constexpr u32 THROTTLE_PRUNE_INTERVAL = 20 * 60;
+
+// Value at 'percent' of 'values' (nearest rank); reorders them
+template <typename T>
+static T percentile(std::vector<T>& values, usize percent) {
+    if (values.empty()) {
+        return T{};
+    }
+    auto nth = values.begin() + static_cast<isize>((values.size() - 1) * percent / 100);
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+// Clip a tracking range so entities are destroyed before the client unloads their chunk
+static f64 tracking_range(f64 range, i32 view_distance) {
+    return std::min(range, view_distance * 16.0 - EntityTracker::DESPAWN_MARGIN);
+}
+
+// Players and mobs as clients see them
+template <typename T>
+static clientbound::EntityPosition position_of(const T& entity) {
+    return clientbound::EntityPosition::of(entity.get_x(), entity.get_y(), entity.get_z(),
+                                           entity.get_yaw(), entity.get_pitch());
+}
+
+// Configured backlog limits; the soft limit is at least 64 KiB and the hard limit
+// at least twice the soft limit actually used, so throttling comes before a kick
+static BacklogLimits backlog_limits_of(const ServerConfig& config) {
+    usize soft = static_cast<usize>(std::max(65536, config.client_backlog_soft_limit()));
+    usize hard = static_cast<usize>(std::max(0, config.client_backlog_hard_limit()));
+    return {soft, std::max(soft * 2, hard),
+            static_cast<i64>(std::max(1, config.client_stall_timeout())) * 1000};
+}
+
+NetworkManager::NetworkManager(ChunkManager* chunk_manager, const std::string& world_path,
+                               const ServerConfig& config)
     : chunk_manager_(chunk_manager)
     , job_system_(4)  // 4 worker threads for async operations
     , async_io_(&job_system_)
     , block_manager_(chunk_manager)
     , mob_manager_(chunk_manager)
     , item_entity_manager_(entity_manager_.get_id_manager())
-    , chunk_streaming_manager_(chunk_manager, 10)  // Default view distance: 10 chunks
+    , chunk_streaming_manager_(chunk_manager, 10, &job_system_)  // Default view distance: 10 chunks
     , player_data_manager_(world_path, &async_io_)
-    , admin_manager_() {
+    , admin_manager_()
+    , backend_(config.network_backend() == "io_uring" ? NetworkBackend::IoUring
+                                                      : NetworkBackend::Poll)
+    , send_budget_(static_cast<usize>(std::max(1024, config.client_send_budget())))
+    , min_send_budget_(static_cast<usize>(std::max(512, config.client_min_send_budget())))
+    , backlog_limits_(backlog_limits_of(config))
+    , inbound_limits_{static_cast<u32>(std::max(1, config.client_inbound_packets_per_tick())),
+                      static_cast<u32>(std::max(8, config.client_inbound_cost_per_tick()))}
+    , inbound_tick_budget_(static_cast<u32>(std::max(config.client_inbound_cost_per_tick(),
+                                                     config.inbound_cost_per_tick())))
+    , connection_throttle_(static_cast<u32>(std::max(0, config.connection_throttle_burst())),
+                           static_cast<u32>(std::max(1, config.connection_throttle_per_minute())))
+    , accepts_per_tick_(static_cast<u32>(std::max(1, config.accepts_per_tick())))
+    , throttle_kick_(PacketKick("Connection throttled! Please wait before reconnecting.").encode())
+    , login_timeout_ms_(static_cast<i64>(std::max(1, config.login_timeout())) * 1000)
+    , mob_update_interval_(static_cast<u32>(std::max(1, config.mob_update_interval())))
+    , player_update_interval_(static_cast<u32>(std::max(1, config.player_update_interval())))
+    , player_tracking_range_(tracking_range(PLAYER_TRACKING_RANGE,
+                                            chunk_streaming_manager_.get_view_distance()))
+    , mob_tracking_range_(tracking_range(MOB_TRACKING_RANGE,
+                                         chunk_streaming_manager_.get_view_distance()))
+    , item_tracking_range_(tracking_range(ITEM_TRACKING_RANGE,
+                                          chunk_streaming_manager_.get_view_distance())) {
     // Start the job system
     job_system_.start();
 
+    // Chunks for logins and streaming are loaded and generated off the tick thread
+    chunk_manager_->set_job_system(&job_system_);
+
+    // Socket reads, packet decoding and writes run on these threads, off the tick thread
+    u32 io_thread_count = static_cast<u32>(std::max(1, config.network_threads()));
+    for (u32 i = 0; i < io_thread_count; ++i) {
+        io_threads_.push_back(std::make_unique<NetworkIoThread>(i, backend_));
+    }
+
+    // Chunk payload compression
+    CompressionSettings compression;
+    compression.level = std::clamp(config.chunk_compression_level(), CompressionSettings::MIN_LEVEL,
+                                   CompressionSettings::MAX_LEVEL);
+    std::string engine = config.chunk_compression_engine();
+    if (!ChunkCompressor::parse_engine(engine, compression.engine)) {
+        LOG_WARNING_CAT("Chunk compression engine '" + engine + "' is not available, using zlib",
+                        LogCategory::Network);
+        compression.engine = CompressionEngine::Zlib;
+    }
+    chunk_streaming_manager_.set_compression(compression, config.chunk_compression_adaptive());
+    LOG_INFO_CAT(std::string("Chunk compression: ") + ChunkCompressor::engine_name(compression.engine) +
+                 " level " + std::to_string(compression.level) +
+                 (config.chunk_compression_adaptive() ? " (adaptive)" : ""),
+                 LogCategory::Network);
+    chunk_streaming_manager_.set_chunks_per_tick(static_cast<u32>(std::max(1, config.chunks_per_tick())));
+
     // Set up admin manager with manager references
     admin_manager_.set_chunk_manager(chunk_manager_);
     admin_manager_.set_entity_manager(&entity_manager_);
     admin_manager_.set_mob_manager(&mob_manager_);
-    // Set up entity manager callbacks
-    entity_manager_.set_spawn_player_callback([this](ClientSession* viewer, const Player* player) {
-        this->spawn_player_to_client(viewer, player);
+    // Set up entity tracker callbacks
+    entity_tracker_.set_spawn_callback([this](ClientSession* viewer, i32 entity_id,
+                                              TrackedEntityKind kind) {
+        this->spawn_entity_to_client(viewer, entity_id, kind);
     });
 
-    entity_manager_.set_despawn_entity_callback([this](ClientSession* viewer, i32 entity_id) {
+    entity_tracker_.set_destroy_callback([this](ClientSession* viewer, i32 entity_id) {
         this->despawn_entity_from_client(viewer, entity_id);
     });
 
+    // Entities are only spawned into chunks the client has
+    entity_tracker_.set_chunk_visible_fn([this](ClientSession* viewer, i32 chunk_x, i32 chunk_z) {
+        return chunk_streaming_manager_.has_sent_chunk(viewer, chunk_x, chunk_z);
+    });
+
+    chunk_streaming_manager_.set_chunk_sent_callback([this](ClientSession* viewer, i32, i32) {
+        entity_tracker_.chunks_changed(viewer);
+    });
+
+    chunk_streaming_manager_.set_chunk_released_callback([this](ClientSession* viewer, i32, i32) {
+        entity_tracker_.chunks_changed(viewer);
+    });
+
     // Set up block manager callbacks
     block_manager_.set_block_change_callback([this](i32 x, i8 y, i32 z, u8 block_type, u8 metadata) {
         this->broadcast_block_change(x, y, z, block_type, metadata);
@@ -64,11 +165,6 @@ NetworkManager::NetworkManager(ChunkManager* chunk_manager, const std::string& w
         this->broadcast_mob_spawn(mob);
     });
 
-    mob_manager_.set_movement_callback([this](i32 entity_id, f64 old_x, f64 old_y, f64 old_z,
-                                              f64 new_x, f64 new_y, f64 new_z, f32 yaw, f32 pitch) {
-        this->broadcast_mob_movement(entity_id, old_x, old_y, old_z, new_x, new_y, new_z, yaw, pitch);
-    });
-
     mob_manager_.set_despawn_callback([this](i32 entity_id) {
         this->broadcast_mob_despawn(entity_id);
     });
@@ -117,26 +213,104 @@ Result<void> NetworkManager::start(const std::string& address, u16 port) {
         return result;
     }
 
-    LOG_INFO_CAT(std::string("Network listening on ") + address + ":" + std::to_string(port),
+    auto accept_result = start_accepting();
+    if (!accept_result) {
+        listener_.stop();
+        return accept_result;
+    }
+
+    for (auto& io_thread : io_threads_) {
+        auto io_result = io_thread->start();
+        if (!io_result) {
+            for (auto& started : io_threads_) {
+                started->stop();
+            }
+            accept_ring_.close();
+            poller_.close();
+            listener_.stop();
+            return io_result;
+        }
+    }
+
+    bool uring = io_threads_.front()->backend() == NetworkBackend::IoUring;
+    LOG_INFO_CAT(std::string("Network listening on ") + address + ":" + std::to_string(port) +
+                 " (" + std::to_string(io_threads_.size()) + " I/O threads, " +
+                 (uring ? "io_uring" : "poll") + ")",
                  LogCategory::Network);
 
     return Result<void>();
 }
 
+Result<void> NetworkManager::start_accepting() {
+    if (backend_ == NetworkBackend::IoUring) {
+        // The tick thread only reaps this ring, so accepting costs no syscall per tick
+        if (accept_ring_.open(16) && listener_.arm_multishot_accept(accept_ring_, 0) &&
+            accept_ring_.submit()) {
+            return Result<void>();
+        }
+
+        LOG_WARNING_CAT("io_uring multishot accept unavailable, falling back to poll",
+                        LogCategory::Network);
+        accept_ring_.close();
+    }
+
+    auto poller_result = poller_.open();
+    if (!poller_result) {
+        return poller_result;
+    }
+
+    auto add_result = poller_.add(listener_.native_handle(), PollFlags::Readable, &listener_);
+    if (!add_result) {
+        poller_.close();
+        return add_result;
+    }
+
+    return Result<void>();
+}
+
 void NetworkManager::stop() {
+    accept_ring_.close();
+    poller_.close();
     listener_.stop();
 
+    // Closes every client socket; sessions only hold the shared Connection state
+    for (auto& io_thread : io_threads_) {
+        io_thread->stop();
+    }
+
     // Wait for all pending async I/O operations to complete before shutting down
     job_system_.wait_all();
     job_system_.stop();
+    chunk_manager_->set_job_system(nullptr);
+    chunk_manager_->tick();
 
     clients_.clear();
 }
 
 void NetworkManager::tick() {
-    accept_connections();
+    // Drop sessions that were disconnected since the last tick
+    remove_disconnected_clients();
+
+    // Client sockets live on the I/O threads; only the listener is watched here
+    if (accept_ring_.is_open()) {
+        accept_completed_connections();
+    } else {
+        auto poll_result = poller_.wait(poll_events_, 0);
+        if (!poll_result) {
+            LOG_ERROR_CAT("Network poll failed", LogCategory::Network);
+        }
+
+        if (!poll_events_.empty()) {
+            accept_connections();
+        }
+    }
     process_clients();
 
+    if (++ticks_since_throttle_prune_ >= THROTTLE_PRUNE_INTERVAL) {
+        ticks_since_throttle_prune_ = 0;
+        connection_throttle_.prune(Clock::now());
+    }
+
     // Update player list for hostile mob targeting and natural spawning
     // We cache this to avoid rebuilding it on every mob update
     static i32 player_list_update_counter = 0;
@@ -153,11 +327,15 @@ void NetworkManager::tick() {
             chunk_streaming_manager_.update_player_chunks(
                 client.get(),
                 player->get_x(),
-                player->get_z()
+                player->get_z(),
+                player->get_yaw()
             );
         }
     }
 
+    // Send chunks whose payloads were compressed since the last tick
+    chunk_streaming_manager_.tick();
+
     // Natural mob spawning
     if (mob_manager_.get_spawner()) {
         mob_manager_.get_spawner()->tick(player_list_cache_);
@@ -170,30 +348,68 @@ void NetworkManager::tick() {
     item_entity_manager_.check_pickups(player_list_cache_);
 }
 
-void NetworkManager::broadcast_chat(const std::string& message, const std::string& sender) {
-    // Format: <sender> message
-    std::string formatted = "<" + sender + "> " + message;
+PacketWriter& NetworkManager::scratch_writer() {
+    scratch_.clear();
+    return scratch_;
+}
 
-    PacketChat chat_packet(formatted);
+void NetworkManager::broadcast_packet(const Packet& packet) {
+    PacketWriter& writer = scratch_writer();
+    if (!packet.encode(writer)) {
+        LOG_ERROR_CAT("Failed to serialize broadcast packet", LogCategory::Network);
+        return;
+    }
 
-    // Send to all connected clients in Play state
+    broadcast_encoded(writer);
+}
+
+void NetworkManager::broadcast_packet_to_chunk(const Packet& packet, i32 chunk_x, i32 chunk_z) {
+    if (!chunk_streaming_manager_.get_viewers(chunk_x, chunk_z)) {
+        return;
+    }
+
+    PacketWriter& writer = scratch_writer();
+    if (!packet.encode(writer)) {
+        LOG_ERROR_CAT("Failed to serialize broadcast packet", LogCategory::Network);
+        return;
+    }
+
+    broadcast_encoded_to_chunk(writer, chunk_x, chunk_z);
+}
+
+void NetworkManager::broadcast_encoded(const PacketWriter& packet) {
     for (auto& client : clients_) {
         if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(chat_packet);
+            client->send_encoded(packet);
         }
     }
 }
 
+void NetworkManager::broadcast_encoded_to_chunk(const PacketWriter& packet, i32 chunk_x, i32 chunk_z) {
+    const ChunkViewers* viewers = chunk_streaming_manager_.get_viewers(chunk_x, chunk_z);
+    if (!viewers) {
+        return;
+    }
+
+    viewers->for_each([&](u32 slot) {
+        chunk_streaming_manager_.get_viewer_session(slot)->send_encoded(packet);
+    });
+}
+
+void NetworkManager::broadcast_chat(const std::string& message, const std::string& sender) {
+    // Format: <sender> message
+    std::string formatted = "<" + sender + "> " + message;
+
+    PacketChat chat_packet(formatted);
+
+    broadcast_packet(chat_packet);
+}
+
 void NetworkManager::broadcast_player_join(const std::string& username) {
     std::string message = "§e" + username + " joined the game";
     PacketChat chat_packet(message);
 
-    // Send to all connected clients in Play state
-    for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(chat_packet);
-        }
-    }
+    broadcast_packet(chat_packet);
 
     LOG_INFO_CAT(username + " joined the game", LogCategory::General);
 }
@@ -202,19 +418,14 @@ void NetworkManager::broadcast_player_leave(const std::string& username) {
     std::string message = "§e" + username + " left the game";
     PacketChat chat_packet(message);
 
-    // Send to all connected clients in Play state
-    for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(chat_packet);
-        }
-    }
+    broadcast_packet(chat_packet);
 
     LOG_INFO_CAT(username + " left the game", LogCategory::General);
 }
 
 void NetworkManager::accept_connections() {
-    // Try to accept new connections (non-blocking)
-    while (true) {
+    // Connections over this tick's budget stay in the listen backlog
+    for (u32 accepted = 0; accepted < accepts_per_tick_; ++accepted) {
         auto socket_result = listener_.accept();
 
         if (!socket_result) {
@@ -222,81 +433,249 @@ void NetworkManager::accept_connections() {
             break;
         }
 
-        // Create callbacks for this client
-        auto chat_callback = [this](const std::string& message, const std::string& sender) {
-            this->broadcast_chat(message, sender);
-        };
+        admit_connection(std::move(socket_result.value()));
+    }
+}
+
+void NetworkManager::accept_completed_connections() {
+    accept_ring_.reap(accept_completions_);
+
+    bool rearm = false;
+    for (const auto& completion : accept_completions_) {
+        auto socket_result = TcpListener::accepted(completion);
+        if (socket_result) {
+            // Past the queue limit the connection is closed as if the backlog overflowed
+            if (accept_queue_.size() < MAX_QUEUED_ACCEPTS) {
+                accept_queue_.push_back(std::move(socket_result.value()));
+            }
+        }
+
+        // The kernel ends a multishot accept on errors; queue a new one
+        if (!(completion.flags & IoCompletionFlags::More)) {
+            rearm = true;
+        }
+    }
 
-        auto join_callback = [this](const std::string& username) {
-            this->broadcast_player_join(username);
-        };
+    if (rearm && listener_.arm_multishot_accept(accept_ring_, 0)) {
+        accept_ring_.submit();
+    }
 
-        auto leave_callback = [this](const std::string& username) {
-            this->broadcast_player_leave(username);
-        };
+    for (u32 accepted = 0; accepted < accepts_per_tick_ && !accept_queue_.empty(); ++accepted) {
+        Socket socket = std::move(accept_queue_.front());
+        accept_queue_.pop_front();
+        admit_connection(std::move(socket));
+    }
+}
 
-        auto session = std::make_unique<ClientSession>(
-            std::move(socket_result.value()),
-            chunk_manager_,
-            &entity_manager_,
-            &block_manager_,
-            &mob_manager_,
-            &item_entity_manager_,
-            &chunk_streaming_manager_,
-            &player_data_manager_,
-            &admin_manager_,
-            chat_callback,
-            join_callback,
-            leave_callback
-        );
-        clients_.push_back(std::move(session));
+void NetworkManager::admit_connection(Socket socket) {
+    // Turned away before anything is allocated for it
+    auto address = socket.peer_address();
+    if (address && !connection_throttle_.allow(address.value(), Clock::now())) {
+        ++throttled_connections_;
+        LOG_DEBUG_CAT("Connection from " + address.value() + " throttled", LogCategory::Network);
 
-        LOG_INFO_CAT("Client connected", LogCategory::Network);
+        // Best effort: the kick fits any fresh socket buffer, and nothing waits for it
+        if (throttle_kick_ && socket.set_non_blocking(true)) {
+            socket.send(throttle_kick_->data(), throttle_kick_->size());
+        }
+        return;
     }
+
+    add_client(std::move(socket));
+}
+
+void NetworkManager::add_client(Socket socket) {
+    // Create callbacks for this client
+    auto chat_callback = [this](const std::string& message, const std::string& sender) {
+        this->broadcast_chat(message, sender);
+    };
+
+    auto join_callback = [this](const std::string& username) {
+        this->broadcast_player_join(username);
+    };
+
+    auto leave_callback = [this](const std::string& username) {
+        this->broadcast_player_leave(username);
+    };
+
+    auto entity_status_callback = [this](i32 entity_id, i8 status) {
+        this->broadcast_entity_status(entity_id, status);
+    };
+
+    auto animation_callback = [this](i32 entity_id, AnimationType animation) {
+        this->broadcast_animation(entity_id, animation);
+    };
+
+    auto connection = std::make_shared<Connection>(std::move(socket));
+
+    auto session = std::make_unique<ClientSession>(
+        connection,
+        chunk_manager_,
+        &entity_manager_,
+        &block_manager_,
+        &mob_manager_,
+        &item_entity_manager_,
+        &chunk_streaming_manager_,
+        &player_data_manager_,
+        &admin_manager_,
+        chat_callback,
+        join_callback,
+        leave_callback,
+        entity_status_callback,
+        animation_callback,
+        send_budget_,
+        min_send_budget_,
+        backlog_limits_,
+        inbound_limits_,
+        login_timeout_ms_
+    );
+
+    // Balance by connection count; a session stays on its thread for life
+    NetworkIoThread::least_loaded(io_threads_)->add_connection(std::move(connection));
+
+    clients_.push_back(std::move(session));
+
+    LOG_INFO_CAT("Client connected", LogCategory::Network);
 }
 
 void NetworkManager::process_clients() {
-    // Process all clients and remove disconnected ones
+    // Packets were already decoded by the I/O threads; sessions with nothing
+    // waiting return after an atomic check. Each tick starts one client further
+    // along, so whoever comes last when the shared budget runs out goes first soon
+    u32 remaining = inbound_tick_budget_;
+    usize count = clients_.size();
+    for (usize i = 0; i < count; ++i) {
+        ClientSession& client = *clients_[(process_cursor_ + i) % count];
+        remaining -= std::min(remaining, client.process(remaining));
+    }
+    process_cursor_ = count > 0 ? (process_cursor_ + 1) % count : 0;
+
+    remove_disconnected_clients();
+}
+
+void NetworkManager::flush() {
+    flush_block_changes();
+    flush_entity_movement();
+
+    // Each session releases what its bandwidth budget allows this tick
+    for (auto& client : clients_) {
+        client->flush_output();
+    }
+
+    for (auto& io_thread : io_threads_) {
+        io_thread->request_flush();
+    }
+}
+
+void NetworkManager::report_tick_time(f64 tick_ms) {
+    chunk_streaming_manager_.report_tick_time(tick_ms,
+                                              static_cast<f64>(TickManager::TARGET_MS_PER_TICK));
+}
+
+NetworkManager::OutboundQueueStats NetworkManager::outbound_queue_stats() const {
+    OutboundQueueStats stats;
+    for (const auto& client : clients_) {
+        usize queued = client->outbound_queue_bytes();
+        stats.total_bytes += queued;
+        stats.max_bytes = std::max(stats.max_bytes, queued);
+        if (queued > backlog_limits_.soft_bytes) {
+            ++stats.backlogged_clients;
+        }
+    }
+    stats.evicted_clients = evicted_clients_;
+    return stats;
+}
+
+NetworkManager::LinkStats NetworkManager::link_stats() {
+    rtt_scratch_.clear();
+    drain_scratch_.clear();
+    for (const auto& client : clients_) {
+        if (u32 rtt = client->round_trip_us()) {
+            rtt_scratch_.push_back(rtt);
+        }
+        if (usize rate = client->drain_rate()) {
+            drain_scratch_.push_back(rate);
+        }
+    }
+
+    LinkStats stats;
+    stats.measured_clients = rtt_scratch_.size();
+    stats.rtt_p50_us = percentile(rtt_scratch_, 50);
+    stats.rtt_p99_us = percentile(rtt_scratch_, 99);
+    stats.drain_p50 = percentile(drain_scratch_, 50);
+    return stats;
+}
+
+usize NetworkManager::pending_inbound_packets() const {
+    usize total = 0;
+    for (const auto& client : clients_) {
+        total += client->pending_inbound();
+    }
+    return total;
+}
+
+void NetworkManager::remove_disconnected_clients() {
+    bool removed_player = false;
     auto it = clients_.begin();
     while (it != clients_.end()) {
-        (*it)->process();
-
         if (!(*it)->is_connected()) {
+            if ((*it)->was_evicted()) {
+                ++evicted_clients_;
+            }
+
+            // Other clients lose the player before its entity ID can be reused
+            if (const Player* player = (*it)->get_player()) {
+                entity_movement_.untrack(player->get_entity_id());
+                removed_player = true;
+            }
+            entity_tracker_.remove_viewer(it->get());
             it = clients_.erase(it);
         } else {
             ++it;
         }
     }
-}
 
-void NetworkManager::spawn_player_to_client(ClientSession* viewer, const Player* player) {
-    if (!viewer || !player) {
-        return;
+    // The cached list would point at the deleted players until its next refresh
+    if (removed_player) {
+        player_list_cache_ = entity_manager_.get_all_players();
     }
+}
 
-    // Convert player position to fixed-point (multiply by 32)
-    i32 fixed_x = static_cast<i32>(std::round(player->get_x() * 32.0));
-    i32 fixed_y = static_cast<i32>(std::round(player->get_y() * 32.0));
-    i32 fixed_z = static_cast<i32>(std::round(player->get_z() * 32.0));
-
-    // Convert rotation to byte format (angle * 256 / 360)
-    i8 yaw = static_cast<i8>(std::round(player->get_yaw() * 256.0f / 360.0f));
-    i8 pitch = static_cast<i8>(std::round(player->get_pitch() * 256.0f / 360.0f));
-
-    // Create and send NamedEntitySpawn packet
-    PacketNamedEntitySpawn spawn_packet(
-        player->get_entity_id(),
-        player->get_username(),
-        fixed_x, fixed_y, fixed_z,
-        yaw, pitch,
-        0 // current item (held item ID)
-    );
-
-    viewer->send_packet(spawn_packet);
+void NetworkManager::spawn_entity_to_client(ClientSession* viewer, i32 entity_id,
+                                            TrackedEntityKind kind) {
+    // Players and mobs are where clients were last told they are, so later moves apply cleanly
+    const clientbound::EntityPosition* position = entity_movement_.find(entity_id);
+    PacketWriter& writer = scratch_writer();
+
+    switch (kind) {
+        case TrackedEntityKind::Player: {
+            const Player* player = entity_manager_.get_player(entity_id);
+            if (!player || !position) {
+                return;
+            }
+            clientbound::named_entity_spawn(writer, *player, *position, 0);  // No held item shown yet
+            break;
+        }
+        case TrackedEntityKind::Mob: {
+            const Mob* mob = mob_manager_.get_mob(entity_id);
+            if (!mob || !position) {
+                return;
+            }
+            clientbound::mob_spawn(writer, *mob, *position);
+            break;
+        }
+        case TrackedEntityKind::Item: {
+            const ItemEntity* item = item_entity_manager_.get_item(entity_id);
+            if (!item) {
+                return;
+            }
+            clientbound::pickup_spawn(writer, *item);
+            break;
+        }
+    }
+    viewer->send_encoded(writer);
 
-    LOG_DEBUG_CAT("Spawned player " + player->get_username() +
-                  " (entity ID " + std::to_string(player->get_entity_id()) + ") " +
-                  "to " + viewer->get_username(),
+    LOG_DEBUG_CAT("Spawned entity ID " + std::to_string(entity_id) + " to " + viewer->get_username(),
                   LogCategory::Entity);
 }
 
@@ -305,8 +684,9 @@ void NetworkManager::despawn_entity_from_client(ClientSession* viewer, i32 entit
         return;
     }
 
-    PacketDestroyEntity destroy_packet(entity_id);
-    viewer->send_packet(destroy_packet);
+    PacketWriter& writer = scratch_writer();
+    clientbound::destroy_entity(writer, entity_id);
+    viewer->send_encoded(writer);
 
     LOG_DEBUG_CAT("Despawned entity ID " + std::to_string(entity_id) +
                   " from " + viewer->get_username(),
@@ -314,22 +694,73 @@ void NetworkManager::despawn_entity_from_client(ClientSession* viewer, i32 entit
 }
 
 void NetworkManager::broadcast_block_change(i32 x, i8 y, i32 z, u8 block_type, u8 metadata) {
-    PacketBlockChange block_packet(x, y, z, block_type, metadata);
-
-    // Send to all connected clients in Play state
-    for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(block_packet);
-        }
-    }
+    block_changes_.record(x, y, z, block_type, metadata);
 
-    LOG_DEBUG_CAT("Broadcast block change at (" + std::to_string(x) + ", " +
+    LOG_DEBUG_CAT("Queued block change at (" + std::to_string(x) + ", " +
                   std::to_string(y) + ", " + std::to_string(z) +
                   ") type: " + std::to_string(block_type),
                   LogCategory::World);
 }
 
 void NetworkManager::broadcast_chunk_update(i32 chunk_x, i32 chunk_z) {
+    block_changes_.record_resend(chunk_x, chunk_z);
+}
+
+void NetworkManager::flush_block_changes() {
+    block_changes_.drain([this](ChunkCoord coord, const BlockChangeAccumulator::ChunkChanges& chunk) {
+        // Players that load the chunk later get its current contents anyway
+        if (!chunk_streaming_manager_.get_viewers(coord.x, coord.z)) {
+            return;
+        }
+
+        if (chunk.resend) {
+            send_chunk_update(coord.x, coord.z);
+            return;
+        }
+        if (chunk.overflow) {
+            send_chunk_region(coord.x, coord.z, chunk.bounds);
+            return;
+        }
+
+        PacketWriter& writer = scratch_writer();
+        if (chunk.changes.size() == 1) {
+            const clientbound::LocalBlockChange& change = chunk.changes.front();
+            clientbound::block_change(writer, coord.x * 16 + change.local_x(), change.y(),
+                                      coord.z * 16 + change.local_z(),
+                                      change.block_type, change.metadata);
+        } else {
+            clientbound::multi_block_change(writer, coord.x, coord.z, chunk.changes);
+        }
+        broadcast_encoded_to_chunk(writer, coord.x, coord.z);
+    });
+}
+
+void NetworkManager::send_chunk_region(i32 chunk_x, i32 chunk_z, const ChunkBox& box) {
+    // Past half the chunk the cached whole-chunk payload is the better deal
+    if (box.volume() * 2 > PacketMapChunk::BLOCKS_SIZE) {
+        send_chunk_update(chunk_x, chunk_z);
+        return;
+    }
+
+    Chunk* chunk = chunk_manager_->get_chunk(chunk_x, chunk_z);
+    if (!chunk) {
+        return;
+    }
+
+    PacketMapChunk region_packet;
+    region_packet.set_region_data(chunk_x, chunk_z, box,
+                                  chunk->get_blocks_data(), chunk->get_metadata_data(),
+                                  chunk->get_block_light_data(), chunk->get_sky_light_data(),
+                                  chunk_streaming_manager_.get_compression());
+    if (!region_packet.compressed_data) {
+        LOG_ERROR_CAT("Failed to compress chunk region", LogCategory::Network);
+        return;
+    }
+
+    broadcast_packet_to_chunk(region_packet, chunk_x, chunk_z);
+}
+
+void NetworkManager::send_chunk_update(i32 chunk_x, i32 chunk_z) {
     // Get the chunk from chunk manager
     Chunk* chunk = chunk_manager_->get_chunk(chunk_x, chunk_z);
     if (!chunk) {
@@ -339,21 +770,11 @@ void NetworkManager::broadcast_chunk_update(i32 chunk_x, i32 chunk_z) {
         return;
     }
 
-    // Create MapChunk packet with updated lighting data
+    // Create MapChunk packet with updated lighting data (recompressed only if it changed)
     PacketMapChunk chunk_packet(chunk_x * 16, chunk_z * 16);
-    chunk_packet.set_chunk_data(
-        chunk->get_blocks_data(),
-        chunk->get_metadata_data(),
-        chunk->get_block_light_data(),
-        chunk->get_sky_light_data()
-    );
+    chunk_packet.compressed_data = chunk_streaming_manager_.get_chunk_payload(*chunk);
 
-    // Send to all connected clients in Play state
-    for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(chunk_packet);
-        }
-    }
+    broadcast_packet_to_chunk(chunk_packet, chunk_x, chunk_z);
 
     LOG_DEBUG_CAT("Broadcast chunk update for chunk (" + std::to_string(chunk_x) +
                   ", " + std::to_string(chunk_z) + ")",
@@ -365,53 +786,94 @@ void NetworkManager::broadcast_mob_spawn(const Mob* mob) {
         return;
     }
 
-    PacketMobSpawn spawn_packet(mob);
+    entity_movement_.track(mob->get_entity_id(), position_of(*mob), mob_update_interval_);
+    entity_tracker_.add_entity(mob->get_entity_id(), TrackedEntityKind::Mob,
+                               mob->get_x(), mob->get_z(), mob_tracking_range_);
 
-    // Send to all connected clients in Play state
-    for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(spawn_packet);
-        }
-    }
-
-    LOG_DEBUG_CAT("Broadcast mob spawn: " + mob->get_name() + " (ID: " +
+    LOG_DEBUG_CAT("Tracking mob spawn: " + mob->get_name() + " (ID: " +
                   std::to_string(mob->get_entity_id()) + ")",
                   LogCategory::Entity);
 }
 
 void NetworkManager::broadcast_mob_despawn(i32 entity_id) {
-    PacketDestroyEntity destroy_packet(entity_id);
-
-    // Send to all connected clients in Play state
-    for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(destroy_packet);
-        }
-    }
+    entity_movement_.untrack(entity_id);
+    entity_tracker_.remove_entity(entity_id);
 
     LOG_DEBUG_CAT("Broadcast mob despawn (ID: " + std::to_string(entity_id) + ")",
                   LogCategory::Entity);
 }
 
-void NetworkManager::broadcast_mob_movement(i32 entity_id, f64 old_x, f64 old_y, f64 old_z,
-                                            f64 new_x, f64 new_y, f64 new_z, f32 yaw, f32 pitch) {
-    // Calculate relative movement in fixed-point (multiply by 32)
-    i8 dx = static_cast<i8>(std::floor((new_x - old_x) * 32.0));
-    i8 dy = static_cast<i8>(std::floor((new_y - old_y) * 32.0));
-    i8 dz = static_cast<i8>(std::floor((new_z - old_z) * 32.0));
+void NetworkManager::flush_entity_movement() {
+    for (auto& client : clients_) {
+        const Player* player = client->get_player();
+        if (!client->is_connected() || client->get_state() != SessionState::Play || !player) {
+            continue;
+        }
+
+        // Entered Play state: spawned both ways by the update below
+        i32 entity_id = player->get_entity_id();
+        if (!entity_tracker_.has_viewer(client.get())) {
+            entity_movement_.track(entity_id, position_of(*player), player_update_interval_);
+            entity_tracker_.add_viewer(client.get(), entity_id, player->get_x(), player->get_z());
+            entity_tracker_.add_entity(entity_id, TrackedEntityKind::Player,
+                                       player->get_x(), player->get_z(), player_tracking_range_);
+            continue;
+        }
 
-    // Convert yaw/pitch to byte format
-    i8 yaw_byte = static_cast<i8>(static_cast<i32>(yaw * 256.0f / 360.0f) & 0xFF);
-    i8 pitch_byte = static_cast<i8>(static_cast<i32>(pitch * 256.0f / 360.0f) & 0xFF);
+        send_entity_movement(entity_id, position_of(*player));
+        entity_tracker_.move_viewer(client.get(), player->get_x(), player->get_z());
+        entity_tracker_.move_entity(entity_id, player->get_x(), player->get_z());
+    }
 
-    // Use combined packet if both movement and rotation occurred
-    PacketEntityLookMove move_packet(entity_id, dx, dy, dz, yaw_byte, pitch_byte);
+    for (const auto& [entity_id, mob] : mob_manager_.get_all_mobs()) {
+        send_entity_movement(entity_id, position_of(*mob));
+        entity_tracker_.move_entity(entity_id, mob->get_x(), mob->get_z());
+    }
+
+    // Clients simulate item physics themselves; the position only decides who sees them
+    for (const auto& [entity_id, item] : item_entity_manager_.get_items()) {
+        entity_tracker_.move_entity(entity_id, item->get_x(), item->get_z());
+    }
+
+    // After the moves, so new viewers are spawned where the others now see the entity
+    entity_tracker_.update();
 
-    // Send to all connected clients in Play state
     for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(move_packet);
+        if (client->has_dropped_movement() && !client->is_backlogged()) {
+            resync_dropped_movement(client.get());
+        }
+    }
+}
+
+void NetworkManager::resync_dropped_movement(ClientSession* client) {
+    for (i32 entity_id : client->take_dropped_movement()) {
+        // Entities destroyed for the client since are spawned where they are now
+        const clientbound::EntityPosition* position = entity_movement_.find(entity_id);
+        if (!position || !entity_tracker_.is_visible(client, entity_id)) {
+            continue;
         }
+
+        PacketWriter& writer = scratch_writer();
+        clientbound::entity_teleport(writer, entity_id, *position);
+        client->send_encoded(writer);
+    }
+}
+
+void NetworkManager::send_entity_movement(i32 entity_id, const clientbound::EntityPosition& current) {
+    clientbound::EntityPosition previous;
+    PacketWriter& writer = scratch_writer();
+    if (entity_movement_.update(entity_id, current, writer, previous)) {
+        // Backlogged clients skip relative moves of distant entities; they are
+        // teleported into place once the client catches up
+        entity_tracker_.for_each_viewer(entity_id, [&](ClientSession* viewer) {
+            const Player* player = viewer->get_player();
+            if (player && viewer->is_backlogged() &&
+                EntityMovementTracker::droppable(writer, current, position_of(*player))) {
+                viewer->drop_movement(entity_id);
+                return;
+            }
+            viewer->send_encoded(writer);
+        });
     }
 }
 
@@ -441,13 +903,16 @@ void NetworkManager::send_health_update(i32 entity_id, i16 health) {
 }
 
 void NetworkManager::broadcast_entity_status(i32 entity_id, i8 status) {
-    PacketEntityStatus status_packet(entity_id, status);
+    PacketWriter& writer = scratch_writer();
+    clientbound::entity_status(writer, entity_id, status);
 
-    // Broadcast to all connected clients in Play state
-    for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(status_packet);
-        }
+    entity_tracker_.for_each_viewer(entity_id, [&](ClientSession* viewer) {
+        viewer->send_encoded(writer);
+    });
+
+    // Players see their own hurt and death animations too
+    if (ClientSession* session = entity_manager_.get_player_session(entity_id)) {
+        session->send_encoded(writer);
     }
 
     const char* status_str = (status == 2) ? "hurt" : (status == 3) ? "dead" : "unknown";
@@ -456,6 +921,15 @@ void NetworkManager::broadcast_entity_status(i32 entity_id, i8 status) {
                  LogCategory::Entity);
 }
 
+void NetworkManager::broadcast_animation(i32 entity_id, AnimationType animation) {
+    PacketWriter& writer = scratch_writer();
+    clientbound::animation(writer, entity_id, animation);
+
+    entity_tracker_.for_each_viewer(entity_id, [&](ClientSession* viewer) {
+        viewer->send_encoded(writer);
+    });
+}
+
 void NetworkManager::handle_player_death(i32 entity_id) {
     Player* player = entity_manager_.get_player(entity_id);
     if (!player) {
@@ -511,57 +985,35 @@ void NetworkManager::broadcast_item_spawn(const ItemEntity* item) {
         return;
     }
 
-    // PacketPickupSpawn constructor handles fixed-point conversion
-    PacketPickupSpawn spawn_packet(
-        item->get_entity_id(),
-        item->get_item()->get_item_id(),
-        item->get_item()->get_count(),
-        item->get_item()->get_damage(),
-        item->get_x(),  // Pass raw f64 coordinates
-        item->get_y(),
-        item->get_z(),
-        0, 0, 0  // rotation, pitch, roll
-    );
+    entity_tracker_.add_entity(item->get_entity_id(), TrackedEntityKind::Item,
+                               item->get_x(), item->get_z(), item_tracking_range_);
 
-    // Send to all connected clients in Play state
-    for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(spawn_packet);
-        }
-    }
-
-    LOG_DEBUG_CAT("Broadcast item spawn (entity ID: " + std::to_string(item->get_entity_id()) +
+    LOG_DEBUG_CAT("Tracking item spawn (entity ID: " + std::to_string(item->get_entity_id()) +
                   ", item ID: " + std::to_string(item->get_item()->get_item_id()) + ")",
                   LogCategory::Entity);
 }
 
 void NetworkManager::broadcast_item_despawn(i32 entity_id) {
-    PacketDestroyEntity destroy_packet(entity_id);
-
-    // Send to all connected clients in Play state
-    for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(destroy_packet);
-        }
-    }
+    entity_tracker_.remove_entity(entity_id);
 
     LOG_DEBUG_CAT("Broadcast item despawn (entity ID: " + std::to_string(entity_id) + ")",
                   LogCategory::Entity);
 }
 
 void NetworkManager::broadcast_item_collect(i32 item_entity_id, i32 collector_entity_id) {
-    PacketCollect collect_packet(item_entity_id, collector_entity_id);
+    PacketWriter& writer = scratch_writer();
+    clientbound::collect(writer, item_entity_id, collector_entity_id);
+    entity_tracker_.for_each_viewer(item_entity_id, [&](ClientSession* viewer) {
+        viewer->send_encoded(writer);
+    });
 
-    // Send to all connected clients in Play state
+    // Find the collector's session
     ClientSession* collector_session = nullptr;
     for (auto& client : clients_) {
-        if (client->is_connected() && client->get_state() == SessionState::Play) {
-            client->send_packet(collect_packet);
-
-            // Track which client is the collector
-            if (client->get_player() && client->get_player()->get_entity_id() == collector_entity_id) {
-                collector_session = client.get();
-            }
+        if (client->is_connected() && client->get_state() == SessionState::Play &&
+            client->get_player() && client->get_player()->get_entity_id() == collector_entity_id) {
+            collector_session = client.get();
+            break;
         }
     }
 
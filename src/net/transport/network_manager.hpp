@@ -1,8 +1,14 @@
 #pragma once
 
 #include "platform/net/tcp_listener.hpp"
+#include "platform/net/poller.hpp"
 #include "net/session/client_session.hpp"
+#include "net/transport/network_io_thread.hpp"
 #include "net/transport/chunk_streaming_manager.hpp"
+#include "net/transport/block_change_accumulator.hpp"
+#include "net/transport/entity_movement_tracker.hpp"
+#include "net/transport/entity_tracker.hpp"
+#include "net/transport/connection_throttle.hpp"
 #include "entity/entity_manager.hpp"
 #include "entity/mob/mob_manager.hpp"
 #include "entity/item/item_entity_manager.hpp"
@@ -12,6 +18,7 @@
 #include "core/scheduler/job_system.hpp"
 #include "admin/admin_manager.hpp"
 #include "util/result.hpp"
+#include <deque>
 #include <vector>
 #include <memory>
 #include <string>
@@ -19,13 +26,15 @@
 namespace mcserver {
 
 class ChunkManager;
+class ServerConfig;
 class Player;
 class Mob;
 class ItemEntity;
 
 class NetworkManager {
 public:
-    NetworkManager(ChunkManager* chunk_manager, const std::string& world_path);
+    NetworkManager(ChunkManager* chunk_manager, const std::string& world_path,
+                   const ServerConfig& config);
     ~NetworkManager();
 
     // Start listening for connections
@@ -37,9 +46,39 @@ public:
     // Process network I/O (accept connections, process packets)
     void tick();
 
+    // Hand this tick's queued output to the network I/O threads
+    void flush();
+
+    // How long the last tick took, for adaptive chunk compression
+    void report_tick_time(f64 tick_ms);
+
     // Get connected client count
     usize client_count() const { return clients_.size(); }
 
+    // Outbound queue depth across all clients
+    struct OutboundQueueStats {
+        usize total_bytes = 0;
+        usize max_bytes = 0;    // Deepest single client queue
+        usize backlogged_clients = 0;   // Past the soft backlog limit
+        u64 evicted_clients = 0;        // Kicked as too slow since startup
+    };
+    OutboundQueueStats outbound_queue_stats() const;
+
+    // Decoded packets held back by the inbound budgets, across all clients
+    usize pending_inbound_packets() const;
+
+    // Round-trip time and drain rate percentiles over the clients that have them
+    struct LinkStats {
+        usize measured_clients = 0;     // With a round-trip time
+        u32 rtt_p50_us = 0;
+        u32 rtt_p99_us = 0;
+        usize drain_p50 = 0;            // Bytes per second, over clients whose link was the limit
+    };
+    LinkStats link_stats();
+
+    // Connections turned away by the per-address rate limit since startup
+    u64 throttled_connections() const { return throttled_connections_; }
+
     // Broadcast a chat message to all clients
     void broadcast_chat(const std::string& message, const std::string& sender);
 
@@ -67,38 +106,39 @@ public:
     // Get player data manager
     PlayerDataManager* get_player_data_manager() { return &player_data_manager_; }
 
-    // Broadcast a block change to all nearby clients
+    // Broadcast a block change to players that have the chunk loaded
+    // Batched per chunk and sent at the end of the tick
     void broadcast_block_change(i32 x, i8 y, i32 z, u8 block_type, u8 metadata);
 
     // Broadcast a chunk update (resend chunk data for lighting updates)
+    // Sent once at the end of the tick, however often it was requested
     void broadcast_chunk_update(i32 chunk_x, i32 chunk_z);
 
-    // Broadcast a mob spawn to all clients
+    // Start tracking a mob; players in range see it from the end of the tick
     void broadcast_mob_spawn(const Mob* mob);
 
-    // Broadcast a mob despawn to all clients
+    // Destroy a mob for the players that can see it
     void broadcast_mob_despawn(i32 entity_id);
 
-    // Broadcast mob movement to all clients
-    void broadcast_mob_movement(i32 entity_id, f64 old_x, f64 old_y, f64 old_z,
-                                f64 new_x, f64 new_y, f64 new_z, f32 yaw, f32 pitch);
-
     // Broadcast player health update to specific player
     void send_health_update(i32 entity_id, i16 health);
 
-    // Broadcast entity status (damage/death animation) to all nearby players
+    // Broadcast entity status (damage/death animation) to the players that can see it
     void broadcast_entity_status(i32 entity_id, i8 status);
 
+    // Broadcast an animation (e.g. arm swing) to the players that can see the entity
+    void broadcast_animation(i32 entity_id, AnimationType animation);
+
     // Handle player death and respawn
     void handle_player_death(i32 entity_id);
 
-    // Broadcast item entity spawn to all clients
+    // Start tracking an item entity; players in range see it from the end of the tick
     void broadcast_item_spawn(const ItemEntity* item);
 
-    // Broadcast item entity despawn to all clients
+    // Destroy an item entity for the players that can see it
     void broadcast_item_despawn(i32 entity_id);
 
-    // Broadcast item collect to all clients
+    // Broadcast item collect to the players that can see the item
     void broadcast_item_collect(i32 item_entity_id, i32 collector_entity_id);
 
 private:
@@ -113,14 +153,85 @@ private:
     PlayerDataManager player_data_manager_;
     AdminManager admin_manager_;
     TcpListener listener_;
+    Poller poller_;                          // Readiness for the listener socket
+    std::vector<PollEvent> poll_events_;     // Reused per-tick event buffer
+    NetworkBackend backend_;
+    usize send_budget_;                      // Per-client bytes per tick (TrafficShaper)
+    usize min_send_budget_;
+    BacklogLimits backlog_limits_;           // Per-client outbound backlog before throttling / kicking
+    u64 evicted_clients_ = 0;
+    InboundLimits inbound_limits_;           // Per-client inbound packets and cost per tick
+    u32 inbound_tick_budget_;                // Inbound cost per tick across all clients
+    usize process_cursor_ = 0;               // Client whose packets are handled first next tick
+    IoRing accept_ring_;                     // io_uring backend: multishot accept
+    std::vector<IoCompletion> accept_completions_;
+    std::deque<Socket> accept_queue_;        // io_uring backend: accepted, waiting for the budget
+    ConnectionThrottle connection_throttle_; // Per-address connection rate limit
+    u32 accepts_per_tick_;                   // New connections looked at per tick
+    u32 ticks_since_throttle_prune_ = 0;
+    u64 throttled_connections_ = 0;
+    EncodedPacket throttle_kick_;            // Sent to connections over their rate limit
+    i64 login_timeout_ms_;                   // From connect until the Login packet
+    std::vector<std::unique_ptr<NetworkIoThread>> io_threads_;  // Own the client sockets
     std::vector<std::unique_ptr<ClientSession>> clients_;
     std::vector<Player*> player_list_cache_;  // Cached player list for mob targeting
+    PacketWriter scratch_;                   // Packets encoded once and copied to each recipient
+    std::vector<u32> rtt_scratch_;           // Reused by link_stats()
+    std::vector<usize> drain_scratch_;
+    BlockChangeAccumulator block_changes_;   // This tick's block changes, sent in flush()
+    EntityMovementTracker entity_movement_;  // What clients last saw of each player and mob
+    EntityTracker entity_tracker_;           // Which clients have each entity spawned
+    u32 mob_update_interval_;                // Ticks between mob movement updates
+    u32 player_update_interval_;             // Ticks between player movement updates
+    f64 player_tracking_range_;              // In blocks, within the view distance
+    f64 mob_tracking_range_;
+    f64 item_tracking_range_;
 
     void accept_connections();
+    void accept_completed_connections();
+    void admit_connection(Socket socket);
+    void add_client(Socket socket);
+    Result<void> start_accepting();
     void process_clients();
+    void remove_disconnected_clients();
+
+    // The scratch writer, emptied, for the next packet to encode
+    PacketWriter& scratch_writer();
+
+    // Encode a packet once and queue the same bytes on every client in Play state
+    void broadcast_packet(const Packet& packet);
+
+    // Same, but only to players that have chunk (chunk_x, chunk_z) loaded
+    void broadcast_packet_to_chunk(const Packet& packet, i32 chunk_x, i32 chunk_z);
+
+    // Queue an already encoded packet (e.g. from the clientbound encoders) the same ways
+    void broadcast_encoded(const PacketWriter& packet);
+    void broadcast_encoded_to_chunk(const PacketWriter& packet, i32 chunk_x, i32 chunk_z);
+
+    // Send this tick's block changes to the players that have each chunk loaded
+    void flush_block_changes();
+
+    // Move players, mobs and items in the entity tracker, send moves that changed
+    // what clients see to the players that can see each entity, then spawn and
+    // destroy entities for players that came into or left their range. Clients
+    // that caught up with their backlog get the moves they skipped as teleports
+    void flush_entity_movement();
+
+    // Send one entity's move, if any, to the players that can see it
+    void send_entity_movement(i32 entity_id, const clientbound::EntityPosition& current);
+
+    // Teleport the entities whose moves a client skipped while backlogged to
+    // where the others see them
+    void resync_dropped_movement(ClientSession* client);
+
+    // Resend a whole chunk to the players that have it loaded
+    void send_chunk_update(i32 chunk_x, i32 chunk_z);
+
+    // Resend just a box of a chunk (e.g. around many block changes)
+    void send_chunk_region(i32 chunk_x, i32 chunk_z, const ChunkBox& box);
 
-    // Entity spawn/despawn callbacks
-    void spawn_player_to_client(ClientSession* viewer, const Player* player);
+    // Entity tracker callbacks
+    void spawn_entity_to_client(ClientSession* viewer, i32 entity_id, TrackedEntityKind kind);
     void despawn_entity_from_client(ClientSession* viewer, i32 entity_id);
 };
 
@@ -0,0 +1,481 @@
+#include "io_ring.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <limits>
+
+#ifdef PLATFORM_LINUX
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <atomic>
+#endif
+
+namespace mcserver {
+
+IoRing::~IoRing() {
+    close();
+}
+
+#ifdef PLATFORM_LINUX
+
+// Reserved user data for the internal eventfd read
+static constexpr u64 WAKE_USER_DATA = std::numeric_limits<u64>::max();
+
+// All provided receive buffers live in one group
+static constexpr u16 BUFFER_GROUP = 0;
+
+static u32 load_acquire(u32* ptr) {
+    return std::atomic_ref<u32>(*ptr).load(std::memory_order_acquire);
+}
+
+static void store_release(u32* ptr, u32 value) {
+    std::atomic_ref<u32>(*ptr).store(value, std::memory_order_release);
+}
+
+Result<void> IoRing::open(u32 entries) {
+    if (is_open()) {
+        return ErrorCode::AlreadyExists;
+    }
+
+    io_uring_params params{};
+    params.flags = IORING_SETUP_SUBMIT_ALL;
+
+    ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd_ < 0) {
+        ring_fd_ = -1;
+        return errno == EPERM ? ErrorCode::PermissionDenied : ErrorCode::NetworkError;
+    }
+
+    // Timed waits need EXT_ARG, and buffers must stay in place for in-flight requests;
+    // SUBMIT_STABLE lets send headers be reused once their entry has been submitted
+    constexpr u32 required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP |
+                             IORING_FEAT_EXT_ARG | IORING_FEAT_SUBMIT_STABLE;
+    if ((params.features & required) != required) {
+        close();
+        return ErrorCode::NetworkError;
+    }
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(u32);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+    // SINGLE_MMAP: the submission and completion rings share one mapping
+    sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+        sq_ring_ = nullptr;
+        close();
+        return ErrorCode::OutOfMemory;
+    }
+    cq_ring_ = sq_ring_;
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   ring_fd_, IORING_OFF_SQES);
+    if (sqes_ == MAP_FAILED) {
+        sqes_ = nullptr;
+        close();
+        return ErrorCode::OutOfMemory;
+    }
+
+    auto* sq = static_cast<byte*>(sq_ring_);
+    sq_head_ = reinterpret_cast<u32*>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<u32*>(sq + params.sq_off.tail);
+    sq_array_ = reinterpret_cast<u32*>(sq + params.sq_off.array);
+    sq_mask_ = *reinterpret_cast<u32*>(sq + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sq_local_tail_ = *sq_tail_;
+
+    auto* cq = static_cast<byte*>(cq_ring_);
+    cq_head_ = reinterpret_cast<u32*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<u32*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<u32*>(cq + params.cq_off.ring_mask);
+    cqes_ = cq + params.cq_off.cqes;
+
+    send_headers_.assign(sq_entries_, msghdr{});
+
+    // Blocking on purpose: io_uring completes reads of non-blocking files with -EAGAIN
+    wake_fd_ = ::eventfd(0, EFD_CLOEXEC);
+    if (wake_fd_ < 0 || !arm_wake()) {
+        close();
+        return ErrorCode::NetworkError;
+    }
+
+    return Result<void>();
+}
+
+void IoRing::close() {
+    // Closing the ring fd cancels everything still in flight
+    if (ring_fd_ >= 0) {
+        ::close(ring_fd_);
+        ring_fd_ = -1;
+    }
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
+    if (buf_ring_) {
+        ::munmap(buf_ring_, buf_ring_size_);
+        buf_ring_ = nullptr;
+    }
+    if (sqes_) {
+        ::munmap(sqes_, sqes_size_);
+        sqes_ = nullptr;
+    }
+    if (sq_ring_) {
+        ::munmap(sq_ring_, sq_ring_size_);
+        sq_ring_ = nullptr;
+        cq_ring_ = nullptr;
+    }
+
+    send_headers_.clear();
+    buffer_memory_.clear();
+    buffer_memory_.shrink_to_fit();
+    buffer_count_ = 0;
+    buffer_size_ = 0;
+    buf_tail_ = 0;
+    pending_submissions_ = 0;
+}
+
+bool IoRing::is_open() const {
+    return ring_fd_ >= 0;
+}
+
+Result<void> IoRing::setup_buffers(u32 count, u32 size) {
+    if (!is_open() || buf_ring_ || count == 0 || (count & (count - 1)) != 0 ||
+        count > 32768 || size == 0) {
+        return ErrorCode::InvalidArgument;
+    }
+
+    // The buffer ring itself must be page aligned, which mmap guarantees
+    buf_ring_size_ = count * sizeof(io_uring_buf);
+    buf_ring_ = ::mmap(nullptr, buf_ring_size_, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buf_ring_ == MAP_FAILED) {
+        buf_ring_ = nullptr;
+        return ErrorCode::OutOfMemory;
+    }
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<u64>(buf_ring_);
+    reg.ring_entries = count;
+    reg.bgid = BUFFER_GROUP;
+    if (::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        ::munmap(buf_ring_, buf_ring_size_);
+        buf_ring_ = nullptr;
+        return ErrorCode::NetworkError;
+    }
+
+    buffer_memory_.resize(static_cast<usize>(count) * size);
+    buffer_count_ = count;
+    buffer_size_ = size;
+    buf_tail_ = 0;
+
+    for (u32 i = 0; i < count; ++i) {
+        recycle_buffer(static_cast<u16>(i));
+    }
+
+    return Result<void>();
+}
+
+const byte* IoRing::buffer_data(u16 buffer_id) const {
+    return buffer_memory_.data() + static_cast<usize>(buffer_id) * buffer_size_;
+}
+
+void IoRing::recycle_buffer(u16 buffer_id) {
+    // Indexed by hand: in C++ the header's flexible-array wrapper shifts 'bufs'
+    // by 8 bytes, while the kernel expects entry 0 at the start of the ring
+    auto* bufs = static_cast<io_uring_buf*>(buf_ring_);
+    auto* ring = static_cast<io_uring_buf_ring*>(buf_ring_);
+    io_uring_buf& buf = bufs[buf_tail_ & (buffer_count_ - 1)];
+    buf.addr = reinterpret_cast<u64>(buffer_data(buffer_id));
+    buf.len = buffer_size_;
+    buf.bid = buffer_id;
+
+    ++buf_tail_;
+    std::atomic_ref<u16>(ring->tail).store(buf_tail_, std::memory_order_release);
+}
+
+void* IoRing::next_sqe() {
+    if (sq_local_tail_ - load_acquire(sq_head_) >= sq_entries_) {
+        // Queue full: hand what we have to the kernel to make room
+        if (!submit() || sq_local_tail_ - load_acquire(sq_head_) >= sq_entries_) {
+            return nullptr;
+        }
+    }
+
+    u32 index = sq_local_tail_ & sq_mask_;
+    auto* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    sq_array_[index] = index;
+
+    ++sq_local_tail_;
+    ++pending_submissions_;
+    return sqe;
+}
+
+bool IoRing::arm_wake() {
+    auto* sqe = static_cast<io_uring_sqe*>(next_sqe());
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = wake_fd_;
+    sqe->addr = reinterpret_cast<u64>(&wake_value_);
+    sqe->len = sizeof(wake_value_);
+    sqe->user_data = WAKE_USER_DATA;
+    return true;
+}
+
+bool IoRing::prep_accept_multishot(socket_t listener, u64 user_data) {
+    auto* sqe = static_cast<io_uring_sqe*>(next_sqe());
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = listener;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoRing::prep_recv_multishot(socket_t handle, u64 user_data) {
+    auto* sqe = static_cast<io_uring_sqe*>(next_sqe());
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = handle;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoRing::prep_send_vectored(socket_t handle, const IoSlice* slices, usize count,
+                                u64 user_data, bool dont_wait) {
+    auto* sqe = static_cast<io_uring_sqe*>(next_sqe());
+    if (!sqe) {
+        return false;
+    }
+
+    // The kernel copies the header and slice array when the entry is submitted
+    msghdr& message = send_headers_[(sq_local_tail_ - 1) & sq_mask_];
+    message = msghdr{};
+    message.msg_iov = reinterpret_cast<iovec*>(const_cast<IoSlice*>(slices));
+    message.msg_iovlen = std::min<usize>(count, IOV_MAX);
+
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = handle;
+    sqe->addr = reinterpret_cast<u64>(&message);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL | (dont_wait ? MSG_DONTWAIT : 0);
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoRing::prep_cancel(u64 target_user_data, u64 user_data) {
+    auto* sqe = static_cast<io_uring_sqe*>(next_sqe());
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = target_user_data;
+    sqe->user_data = user_data;
+    return true;
+}
+
+Result<usize> IoRing::enter(u32 to_submit, u32 min_complete, i32 timeout_ms) {
+    // Publish prepared entries before the kernel looks at the tail
+    store_release(sq_tail_, sq_local_tail_);
+
+    u32 flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    long ret;
+
+    if (min_complete > 0 && timeout_ms > 0) {
+        __kernel_timespec ts{};
+        ts.tv_sec = timeout_ms / 1000;
+        ts.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000;
+
+        io_uring_getevents_arg arg{};
+        arg.sigmask_sz = _NSIG / 8;
+        arg.ts = reinterpret_cast<u64>(&ts);
+
+        ret = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete,
+                        flags | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    } else {
+        ret = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, nullptr, 0);
+    }
+
+    if (ret < 0) {
+        // Timed out, interrupted, or completions must be reaped first: none are errors
+        if (errno == ETIME || errno == EINTR || errno == EBUSY || errno == EAGAIN) {
+            return static_cast<usize>(0);
+        }
+        return ErrorCode::NetworkError;
+    }
+
+    return static_cast<usize>(ret);
+}
+
+Result<void> IoRing::submit() {
+    if (!is_open()) {
+        return ErrorCode::InvalidArgument;
+    }
+    if (pending_submissions_ == 0) {
+        return Result<void>();
+    }
+
+    auto result = enter(pending_submissions_, 0, 0);
+    if (!result) {
+        return result.error();
+    }
+
+    pending_submissions_ -= std::min<u32>(pending_submissions_, static_cast<u32>(result.value()));
+    return Result<void>();
+}
+
+Result<usize> IoRing::submit_and_wait(std::vector<IoCompletion>& completions, i32 timeout_ms) {
+    if (!is_open()) {
+        completions.clear();
+        return ErrorCode::InvalidArgument;
+    }
+
+    // Don't block when completions are already waiting
+    bool ready = load_acquire(cq_tail_) != *cq_head_;
+    u32 min_complete = (timeout_ms != 0 && !ready) ? 1 : 0;
+
+    if (pending_submissions_ > 0 || min_complete > 0) {
+        auto result = enter(pending_submissions_, min_complete, timeout_ms);
+        if (!result) {
+            return result.error();
+        }
+        pending_submissions_ -= std::min<u32>(pending_submissions_,
+                                              static_cast<u32>(result.value()));
+    }
+
+    return reap(completions);
+}
+
+usize IoRing::reap(std::vector<IoCompletion>& completions) {
+    completions.clear();
+
+    if (!is_open()) {
+        return 0;
+    }
+
+    u32 head = *cq_head_;
+    u32 tail = load_acquire(cq_tail_);
+    bool rearm_wake = false;
+
+    for (; head != tail; ++head) {
+        const auto& cqe = static_cast<const io_uring_cqe*>(cqes_)[head & cq_mask_];
+
+        if (cqe.user_data == WAKE_USER_DATA) {
+            rearm_wake = true;
+            continue;
+        }
+
+        IoCompletion completion;
+        completion.user_data = cqe.user_data;
+        completion.result = cqe.res;
+        if (cqe.flags & IORING_CQE_F_MORE) {
+            completion.flags |= IoCompletionFlags::More;
+        }
+        if (cqe.flags & IORING_CQE_F_BUFFER) {
+            completion.flags |= IoCompletionFlags::Buffer;
+            completion.buffer_id = static_cast<u16>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        }
+        completions.push_back(completion);
+    }
+
+    store_release(cq_head_, head);
+
+    // Submitted with the next batch
+    if (rearm_wake) {
+        arm_wake();
+    }
+
+    return completions.size();
+}
+
+void IoRing::wake() {
+    if (wake_fd_ >= 0) {
+        u64 one = 1;
+        [[maybe_unused]] auto written = ::write(wake_fd_, &one, sizeof(one));
+    }
+}
+
+#else // io_uring is Linux-only
+
+Result<void> IoRing::open(u32) {
+    return ErrorCode::NetworkError;
+}
+
+void IoRing::close() {
+    pending_submissions_ = 0;
+}
+
+bool IoRing::is_open() const {
+    return false;
+}
+
+Result<void> IoRing::setup_buffers(u32, u32) {
+    return ErrorCode::InvalidArgument;
+}
+
+const byte* IoRing::buffer_data(u16) const {
+    return nullptr;
+}
+
+void IoRing::recycle_buffer(u16) {}
+
+bool IoRing::prep_accept_multishot(socket_t, u64) {
+    return false;
+}
+
+bool IoRing::prep_recv_multishot(socket_t, u64) {
+    return false;
+}
+
+bool IoRing::prep_send_vectored(socket_t, const IoSlice*, usize, u64, bool) {
+    return false;
+}
+
+bool IoRing::prep_cancel(u64, u64) {
+    return false;
+}
+
+Result<void> IoRing::submit() {
+    return ErrorCode::InvalidArgument;
+}
+
+Result<usize> IoRing::submit_and_wait(std::vector<IoCompletion>& completions, i32) {
+    completions.clear();
+    return ErrorCode::InvalidArgument;
+}
+
+usize IoRing::reap(std::vector<IoCompletion>& completions) {
+    completions.clear();
+    return 0;
+}
+
+void IoRing::wake() {}
+
+#endif
+
+} // namespace mcserver
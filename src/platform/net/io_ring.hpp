@@ -0,0 +1,146 @@
+#pragma once
+
+#include "socket.hpp"
+#include "util/types.hpp"
+#include "util/result.hpp"
+#include <vector>
+
+#ifdef PLATFORM_LINUX
+#include <sys/socket.h>
+#endif
+
+namespace mcserver {
+
+// Completion flags reported alongside a result
+struct IoCompletionFlags {
+    static constexpr u32 None = 0;
+    static constexpr u32 More = 1u << 0;    // Multishot request is still armed
+    static constexpr u32 Buffer = 1u << 1;  // 'buffer_id' names a provided receive buffer
+};
+
+// A single completed request
+struct IoCompletion {
+    u64 user_data = 0;
+    i32 result = 0;         // Bytes / accepted handle, or a negated errno
+    u32 flags = IoCompletionFlags::None;
+    u16 buffer_id = 0;
+};
+
+// Minimal io_uring wrapper for socket I/O (Linux 6.0+)
+// Requests are queued with the prep_* calls and submitted in one batch by
+// submit() or submit_and_wait(), so a whole tick's sends cost a single syscall.
+// Receives use a ring of provided buffers: the kernel picks a free buffer per
+// completion and the caller hands it back with recycle_buffer().
+// On other platforms, or kernels without the required features, open() fails
+// and callers should fall back to the Poller.
+class IoRing {
+public:
+    // Default number of submission queue entries
+    static constexpr u32 DEFAULT_ENTRIES = 256;
+
+    IoRing() = default;
+    ~IoRing();
+
+    IoRing(const IoRing&) = delete;
+    IoRing& operator=(const IoRing&) = delete;
+
+    // Create the ring; fails if io_uring or a required feature is unavailable
+    Result<void> open(u32 entries = DEFAULT_ENTRIES);
+
+    // Tear down the ring (cancels everything still in flight)
+    void close();
+
+    bool is_open() const;
+
+    // Register 'count' receive buffers of 'size' bytes each ('count' must be a power of two)
+    Result<void> setup_buffers(u32 count, u32 size);
+
+    // Access a provided buffer named by a completion
+    const byte* buffer_data(u16 buffer_id) const;
+
+    // Return a provided buffer to the kernel once its data has been consumed
+    void recycle_buffer(u16 buffer_id);
+
+    // ---- Request preparation (false if the submission queue is full) ----
+
+    // Keep accepting on a listening socket; each connection completes separately
+    bool prep_accept_multishot(socket_t listener, u64 user_data);
+
+    // Keep receiving into provided buffers until EOF, an error or cancellation
+    bool prep_recv_multishot(socket_t handle, u64 user_data);
+
+    // Send the gathered slices in one request (sendmsg); the slice array is read
+    // when the request is submitted, the bytes it points to until completion.
+    // A full socket buffer delays the completion until there is room, or with
+    // 'dont_wait' completes it with -EAGAIN
+    bool prep_send_vectored(socket_t handle, const IoSlice* slices, usize count, u64 user_data,
+                            bool dont_wait = false);
+
+    // Cancel the request submitted with 'target_user_data'
+    bool prep_cancel(u64 target_user_data, u64 user_data);
+
+    // ---- Submission and completion ----
+
+    // Submit queued requests without waiting
+    Result<void> submit();
+
+    // Submit queued requests, then wait up to timeout_ms for at least one completion
+    // timeout_ms: 0 = don't wait, -1 = block until something completes
+    // Clears and fills 'completions', returns the number reported
+    Result<usize> submit_and_wait(std::vector<IoCompletion>& completions, i32 timeout_ms);
+
+    // Collect completions that are already available (no syscall)
+    // Clears and fills 'completions', returns the number reported
+    usize reap(std::vector<IoCompletion>& completions);
+
+    // Interrupt a submit_and_wait() blocked on another thread (thread-safe)
+    void wake();
+
+    // Number of requests prepared but not yet submitted
+    u32 pending_submissions() const { return pending_submissions_; }
+
+private:
+    u32 pending_submissions_ = 0;
+
+#ifdef PLATFORM_LINUX
+    int ring_fd_ = -1;
+    int wake_fd_ = -1;          // eventfd with a read kept in flight
+    u64 wake_value_ = 0;        // Target of that read
+
+    // Shared ring mappings
+    void* sq_ring_ = nullptr;
+    usize sq_ring_size_ = 0;
+    void* cq_ring_ = nullptr;
+    usize cq_ring_size_ = 0;
+    void* sqes_ = nullptr;
+    usize sqes_size_ = 0;
+
+    u32 sq_local_tail_ = 0;     // Prepared entries, published to the kernel on enter()
+    u32* sq_head_ = nullptr;
+    u32* sq_tail_ = nullptr;
+    u32* sq_array_ = nullptr;
+    u32 sq_mask_ = 0;
+    u32 sq_entries_ = 0;
+    u32* cq_head_ = nullptr;
+    u32* cq_tail_ = nullptr;
+    u32 cq_mask_ = 0;
+    void* cqes_ = nullptr;
+
+    // Provided buffer ring
+    void* buf_ring_ = nullptr;
+    usize buf_ring_size_ = 0;
+    std::vector<byte> buffer_memory_;
+    u32 buffer_count_ = 0;
+    u32 buffer_size_ = 0;
+    u16 buf_tail_ = 0;
+
+    // One message header per submission slot for vectored sends
+    std::vector<msghdr> send_headers_;
+
+    void* next_sqe();
+    bool arm_wake();
+    Result<usize> enter(u32 to_submit, u32 min_complete, i32 timeout_ms);
+#endif
+};
+
+} // namespace mcserver
@@ -0,0 +1,346 @@
+#include "poller.hpp"
+#include <algorithm>
+
+#ifdef PLATFORM_LINUX
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#elif !defined(PLATFORM_WINDOWS)
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#endif
+
+namespace mcserver {
+
+Poller::~Poller() {
+    close();
+}
+
+#ifdef PLATFORM_LINUX
+
+static u32 to_epoll_events(u32 interest) {
+    u32 events = 0;
+    if (interest & PollFlags::Readable) events |= EPOLLIN | EPOLLRDHUP;
+    if (interest & PollFlags::Writable) events |= EPOLLOUT;
+    return events;
+}
+
+static u32 from_epoll_events(u32 events) {
+    u32 flags = PollFlags::None;
+    if (events & EPOLLIN) flags |= PollFlags::Readable;
+    if (events & EPOLLOUT) flags |= PollFlags::Writable;
+    if (events & (EPOLLHUP | EPOLLERR | EPOLLRDHUP)) flags |= PollFlags::Hangup;
+    return flags;
+}
+
+Result<void> Poller::open() {
+    if (is_open()) {
+        return ErrorCode::AlreadyExists;
+    }
+
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        return ErrorCode::NetworkError;
+    }
+
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        close();
+        return ErrorCode::NetworkError;
+    }
+
+    // The wake descriptor is tagged with its own address so wait() can filter it out
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = &wake_fd_;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev) < 0) {
+        close();
+        return ErrorCode::NetworkError;
+    }
+
+    return Result<void>();
+}
+
+void Poller::close() {
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+    registered_count_ = 0;
+}
+
+void Poller::wake() {
+    if (wake_fd_ >= 0) {
+        u64 one = 1;
+        [[maybe_unused]] auto written = ::write(wake_fd_, &one, sizeof(one));
+    }
+}
+
+void Poller::drain_wakeups() {
+    u64 count = 0;
+    [[maybe_unused]] auto read_bytes = ::read(wake_fd_, &count, sizeof(count));
+}
+
+bool Poller::is_open() const {
+    return epoll_fd_ >= 0;
+}
+
+Result<void> Poller::add(socket_t handle, u32 interest, void* user_data) {
+    if (!is_open() || handle == INVALID_SOCKET_VALUE) {
+        return ErrorCode::InvalidArgument;
+    }
+
+    epoll_event ev{};
+    ev.events = to_epoll_events(interest);
+    ev.data.ptr = user_data;
+
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, handle, &ev) < 0) {
+        return errno == EEXIST ? ErrorCode::AlreadyExists : ErrorCode::NetworkError;
+    }
+
+    ++registered_count_;
+    return Result<void>();
+}
+
+Result<void> Poller::modify(socket_t handle, u32 interest, void* user_data) {
+    if (!is_open() || handle == INVALID_SOCKET_VALUE) {
+        return ErrorCode::InvalidArgument;
+    }
+
+    epoll_event ev{};
+    ev.events = to_epoll_events(interest);
+    ev.data.ptr = user_data;
+
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, handle, &ev) < 0) {
+        return errno == ENOENT ? ErrorCode::NotFound : ErrorCode::NetworkError;
+    }
+
+    return Result<void>();
+}
+
+void Poller::remove(socket_t handle) {
+    if (!is_open() || handle == INVALID_SOCKET_VALUE) {
+        return;
+    }
+
+    // Kernels before 2.6.9 require a non-null event pointer for EPOLL_CTL_DEL
+    epoll_event ev{};
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, handle, &ev) == 0 && registered_count_ > 0) {
+        --registered_count_;
+    }
+}
+
+Result<usize> Poller::wait(std::vector<PollEvent>& events, i32 timeout_ms) {
+    events.clear();
+
+    if (!is_open()) {
+        return ErrorCode::InvalidArgument;
+    }
+
+    static thread_local epoll_event ready[MAX_EVENTS_PER_WAIT];
+    int count = ::epoll_wait(epoll_fd_, ready, static_cast<int>(MAX_EVENTS_PER_WAIT), timeout_ms);
+    if (count < 0) {
+        if (errno == EINTR) {
+            return static_cast<usize>(0);
+        }
+        return ErrorCode::NetworkError;
+    }
+
+    events.reserve(static_cast<usize>(count));
+    for (int i = 0; i < count; ++i) {
+        if (ready[i].data.ptr == &wake_fd_) {
+            drain_wakeups();
+            continue;
+        }
+        events.push_back(PollEvent{ready[i].data.ptr, from_epoll_events(ready[i].events)});
+    }
+
+    return events.size();
+}
+
+#else // poll() / WSAPoll fallback
+
+#ifdef PLATFORM_WINDOWS
+using pollfd_t = WSAPOLLFD;
+static int platform_poll(pollfd_t* fds, usize count, i32 timeout_ms) {
+    return ::WSAPoll(fds, static_cast<ULONG>(count), timeout_ms);
+}
+#else
+using pollfd_t = pollfd;
+static int platform_poll(pollfd_t* fds, usize count, i32 timeout_ms) {
+    return ::poll(fds, static_cast<nfds_t>(count), timeout_ms);
+}
+#endif
+
+Result<void> Poller::open() {
+    if (open_) {
+        return ErrorCode::AlreadyExists;
+    }
+
+#ifndef PLATFORM_WINDOWS
+    if (::pipe(wake_pipe_) < 0) {
+        return ErrorCode::NetworkError;
+    }
+    for (int fd : wake_pipe_) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+#endif
+
+    open_ = true;
+    return Result<void>();
+}
+
+void Poller::close() {
+#ifndef PLATFORM_WINDOWS
+    for (int& fd : wake_pipe_) {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+#endif
+    open_ = false;
+    registrations_.clear();
+    registered_count_ = 0;
+}
+
+void Poller::wake() {
+#ifndef PLATFORM_WINDOWS
+    if (wake_pipe_[1] >= 0) {
+        u8 one = 1;
+        [[maybe_unused]] auto written = ::write(wake_pipe_[1], &one, sizeof(one));
+    }
+#endif
+}
+
+void Poller::drain_wakeups() {
+#ifndef PLATFORM_WINDOWS
+    u8 scratch[64];
+    while (::read(wake_pipe_[0], scratch, sizeof(scratch)) > 0) {
+    }
+#endif
+}
+
+bool Poller::is_open() const {
+    return open_;
+}
+
+Result<void> Poller::add(socket_t handle, u32 interest, void* user_data) {
+    if (!open_ || handle == INVALID_SOCKET_VALUE) {
+        return ErrorCode::InvalidArgument;
+    }
+
+    auto it = std::find_if(registrations_.begin(), registrations_.end(),
+                           [handle](const Registration& r) { return r.handle == handle; });
+    if (it != registrations_.end()) {
+        return ErrorCode::AlreadyExists;
+    }
+
+    registrations_.push_back(Registration{handle, interest, user_data});
+    registered_count_ = registrations_.size();
+    return Result<void>();
+}
+
+Result<void> Poller::modify(socket_t handle, u32 interest, void* user_data) {
+    auto it = std::find_if(registrations_.begin(), registrations_.end(),
+                           [handle](const Registration& r) { return r.handle == handle; });
+    if (it == registrations_.end()) {
+        return ErrorCode::NotFound;
+    }
+
+    it->interest = interest;
+    it->user_data = user_data;
+    return Result<void>();
+}
+
+void Poller::remove(socket_t handle) {
+    auto it = std::find_if(registrations_.begin(), registrations_.end(),
+                           [handle](const Registration& r) { return r.handle == handle; });
+    if (it != registrations_.end()) {
+        // Order doesn't matter, swap-and-pop
+        *it = registrations_.back();
+        registrations_.pop_back();
+        registered_count_ = registrations_.size();
+    }
+}
+
+Result<usize> Poller::wait(std::vector<PollEvent>& events, i32 timeout_ms) {
+    events.clear();
+
+    if (!open_) {
+        return ErrorCode::InvalidArgument;
+    }
+
+#ifdef PLATFORM_WINDOWS
+    // WSAPoll rejects an empty set, so just honour the timeout
+    if (registrations_.empty()) {
+        if (timeout_ms > 0) {
+            Sleep(static_cast<DWORD>(timeout_ms));
+        }
+        return static_cast<usize>(0);
+    }
+    constexpr usize reserved = 0;
+#else
+    // Slot 0 is the wake pipe
+    constexpr usize reserved = 1;
+#endif
+
+    std::vector<pollfd_t> fds(registrations_.size() + reserved);
+#ifndef PLATFORM_WINDOWS
+    fds[0].fd = wake_pipe_[0];
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+#endif
+    for (usize i = 0; i < registrations_.size(); ++i) {
+        pollfd_t& pfd = fds[i + reserved];
+        pfd.fd = registrations_[i].handle;
+        pfd.events = 0;
+        if (registrations_[i].interest & PollFlags::Readable) pfd.events |= POLLIN;
+        if (registrations_[i].interest & PollFlags::Writable) pfd.events |= POLLOUT;
+        pfd.revents = 0;
+    }
+
+    int count = platform_poll(fds.data(), fds.size(), timeout_ms);
+    if (count < 0) {
+#ifndef PLATFORM_WINDOWS
+        if (errno == EINTR) {
+            return static_cast<usize>(0);
+        }
+#endif
+        return ErrorCode::NetworkError;
+    }
+
+#ifndef PLATFORM_WINDOWS
+    if (fds[0].revents != 0) {
+        drain_wakeups();
+    }
+#endif
+
+    for (usize i = 0; i < registrations_.size() && events.size() < MAX_EVENTS_PER_WAIT; ++i) {
+        const pollfd_t& pfd = fds[i + reserved];
+        if (pfd.revents == 0) {
+            continue;
+        }
+
+        u32 flags = PollFlags::None;
+        if (pfd.revents & POLLIN) flags |= PollFlags::Readable;
+        if (pfd.revents & POLLOUT) flags |= PollFlags::Writable;
+        if (pfd.revents & (POLLHUP | POLLERR)) flags |= PollFlags::Hangup;
+
+        events.push_back(PollEvent{registrations_[i].user_data, flags});
+    }
+
+    return events.size();
+}
+
+#endif
+
+} // namespace mcserver
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "socket.hpp"
+#include "util/types.hpp"
+#include "util/result.hpp"
+#include <vector>
+
+namespace mcserver {
+
+// Readiness flags (bitmask) used both for registration interest and reported events
+struct PollFlags {
+    static constexpr u32 None = 0;
+    static constexpr u32 Readable = 1u << 0;
+    static constexpr u32 Writable = 1u << 1;
+    static constexpr u32 Hangup = 1u << 2;  // Peer closed or socket error (reported only)
+};
+
+// A single readiness notification
+struct PollEvent {
+    void* user_data = nullptr;
+    u32 flags = PollFlags::None;
+};
+
+// Socket readiness poller
+// Uses epoll on Linux and falls back to poll()/WSAPoll on other platforms.
+// Registrations are level-triggered: a socket keeps being reported as long as
+// it has unread data (or free send space, if Writable interest is set).
+class Poller {
+public:
+    // Upper bound on events returned by a single wait() call
+    static constexpr usize MAX_EVENTS_PER_WAIT = 1024;
+
+    Poller() = default;
+    ~Poller();
+
+    Poller(const Poller&) = delete;
+    Poller& operator=(const Poller&) = delete;
+
+    // Create the underlying OS poll object
+    Result<void> open();
+
+    // Release the OS poll object and drop all registrations
+    void close();
+
+    bool is_open() const;
+
+    // Register a socket handle with the given interest flags
+    Result<void> add(socket_t handle, u32 interest, void* user_data);
+
+    // Change interest flags (and user data) for an already registered handle
+    Result<void> modify(socket_t handle, u32 interest, void* user_data);
+
+    // Unregister a handle (must still be open on epoll)
+    void remove(socket_t handle);
+
+    // Wait for readiness events
+    // timeout_ms: 0 = return immediately, -1 = block until an event arrives
+    // Clears and fills 'events', returns the number of events reported
+    Result<usize> wait(std::vector<PollEvent>& events, i32 timeout_ms);
+
+    // Interrupt a wait() blocked on another thread (thread-safe)
+    // Not supported on Windows, where waiters should use short timeouts instead
+    void wake();
+
+    // Number of registered handles
+    usize size() const { return registered_count_; }
+
+private:
+    usize registered_count_ = 0;
+
+#ifdef PLATFORM_LINUX
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;      // eventfd registered alongside the sockets
+#else
+    struct Registration {
+        socket_t handle;
+        u32 interest;
+        void* user_data;
+    };
+    bool open_ = false;
+    std::vector<Registration> registrations_;
+#ifndef PLATFORM_WINDOWS
+    int wake_pipe_[2] = {-1, -1};  // Self-pipe, read end is polled
+#endif
+#endif
+
+    void drain_wakeups();
+};
+
+} // namespace mcserver
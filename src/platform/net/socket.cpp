@@ -1,4 +1,6 @@
 #include "socket.hpp"
+#include <climits>
+#include <cstddef>
 #include <cstring>
 
 #ifdef PLATFORM_WINDOWS
@@ -8,6 +10,7 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -15,6 +18,20 @@
 
 namespace mcserver {
 
+// A peer that disappeared must fail the send, not raise SIGPIPE
+#ifdef MSG_NOSIGNAL
+static constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static constexpr int SEND_FLAGS = 0;
+#endif
+
+#ifndef PLATFORM_WINDOWS
+static_assert(sizeof(IoSlice) == sizeof(iovec) &&
+              offsetof(IoSlice, data) == offsetof(iovec, iov_base) &&
+              offsetof(IoSlice, size) == offsetof(iovec, iov_len),
+              "IoSlice must match iovec");
+#endif
+
 #ifdef PLATFORM_WINDOWS
 static WSADATA g_wsa_data;
 static bool g_wsa_initialized = false;
@@ -148,12 +165,50 @@ Result<isize> Socket::send(const byte* data, usize size) {
         return ErrorCode::InvalidArgument;
     }
 
-    isize sent = ::send(socket_, reinterpret_cast<const char*>(data), static_cast<int>(size), 0);
+    isize sent = ::send(socket_, reinterpret_cast<const char*>(data), static_cast<int>(size), SEND_FLAGS);
+    if (sent < 0) {
+        return get_last_socket_error();
+    }
+
+    return sent;
+}
+
+Result<isize> Socket::send_vectored(const IoSlice* slices, usize count) {
+    if (!is_valid()) {
+        return ErrorCode::InvalidArgument;
+    }
+
+    if (count == 0) {
+        return static_cast<isize>(0);
+    }
+
+#ifdef PLATFORM_WINDOWS
+    constexpr usize MAX_BUFFERS = 64;
+    WSABUF buffers[MAX_BUFFERS];
+    DWORD buffer_count = static_cast<DWORD>(count < MAX_BUFFERS ? count : MAX_BUFFERS);
+    for (DWORD i = 0; i < buffer_count; ++i) {
+        buffers[i].buf = const_cast<CHAR*>(reinterpret_cast<const CHAR*>(slices[i].data));
+        buffers[i].len = static_cast<ULONG>(slices[i].size);
+    }
+
+    DWORD sent = 0;
+    if (::WSASend(socket_, buffers, buffer_count, &sent, 0, nullptr, nullptr) != 0) {
+        return get_last_socket_error();
+    }
+
+    return static_cast<isize>(sent);
+#else
+    msghdr message{};
+    message.msg_iov = reinterpret_cast<iovec*>(const_cast<IoSlice*>(slices));
+    message.msg_iovlen = count < IOV_MAX ? count : IOV_MAX;
+
+    isize sent = ::sendmsg(socket_, &message, SEND_FLAGS);
     if (sent < 0) {
         return get_last_socket_error();
     }
 
     return sent;
+#endif
 }
 
 Result<isize> Socket::receive(byte* buffer, usize size) {
@@ -244,6 +299,51 @@ Result<void> Socket::set_receive_buffer_size(i32 size) {
     return Result<void>();
 }
 
+Result<std::string> Socket::peer_address() const {
+    if (!is_valid()) {
+        return ErrorCode::InvalidArgument;
+    }
+
+    sockaddr_in addr{};
+    socklen_t addr_len = sizeof(addr);
+    if (::getpeername(socket_, reinterpret_cast<sockaddr*>(&addr), &addr_len) < 0) {
+        return get_last_socket_error();
+    }
+
+    char text[INET_ADDRSTRLEN] = {};
+    if (!inet_ntop(AF_INET, &addr.sin_addr, text, sizeof(text))) {
+        return ErrorCode::NetworkError;
+    }
+    return std::string(text);
+}
+
+Result<u32> Socket::round_trip_time_us() const {
+    if (!is_valid()) {
+        return ErrorCode::InvalidArgument;
+    }
+
+#ifdef PLATFORM_LINUX
+    tcp_info info{};
+    socklen_t info_len = sizeof(info);
+    if (::getsockopt(socket_, IPPROTO_TCP, TCP_INFO, &info, &info_len) < 0) {
+        return get_last_socket_error();
+    }
+    return static_cast<u32>(info.tcpi_rtt);
+#else
+    return ErrorCode::NotFound;
+#endif
+}
+
+void Socket::shutdown() {
+    if (is_valid()) {
+#ifdef PLATFORM_WINDOWS
+        ::shutdown(socket_, SD_BOTH);
+#else
+        ::shutdown(socket_, SHUT_RDWR);
+#endif
+    }
+}
+
 void Socket::close() {
     if (is_valid()) {
 #ifdef PLATFORM_WINDOWS
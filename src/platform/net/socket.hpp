@@ -17,6 +17,13 @@ using socket_t = int;
 
 namespace mcserver {
 
+// One buffer of a vectored send
+// Same layout as POSIX iovec, so arrays of it are passed to the kernel as-is
+struct IoSlice {
+    const byte* data = nullptr;
+    usize size = 0;
+};
+
 class Socket {
 public:
     Socket();
@@ -47,6 +54,9 @@ public:
     // Send data
     Result<isize> send(const byte* data, usize size);
 
+    // Send several buffers with one call (writev-style); may write only part of them
+    Result<isize> send_vectored(const IoSlice* slices, usize count);
+
     // Receive data
     Result<isize> receive(byte* buffer, usize size);
 
@@ -59,6 +69,18 @@ public:
     Result<void> set_send_buffer_size(i32 size);
     Result<void> set_receive_buffer_size(i32 size);
 
+    // Remote IPv4 address in dotted form
+    Result<std::string> peer_address() const;
+
+    // Smoothed round-trip time the kernel measured for this TCP connection, in
+    // microseconds; 0 before anything was acknowledged. Linux only (TCP_INFO)
+    Result<u32> round_trip_time_us() const;
+
+    // Shut down both directions without releasing the handle
+    // The peer sees the connection close, but the descriptor stays reserved
+    // until close() so it cannot be reused while still registered elsewhere
+    void shutdown();
+
     // Close the socket
     void close();
 
@@ -52,4 +52,20 @@ Result<Socket> TcpListener::accept() {
     return listen_socket_.accept();
 }
 
+bool TcpListener::arm_multishot_accept(IoRing& ring, u64 user_data) {
+    if (!is_listening()) {
+        return false;
+    }
+
+    return ring.prep_accept_multishot(listen_socket_.native_handle(), user_data);
+}
+
+Result<Socket> TcpListener::accepted(const IoCompletion& completion) {
+    if (completion.result < 0) {
+        return ErrorCode::NetworkError;
+    }
+
+    return Socket(static_cast<socket_t>(completion.result));
+}
+
 } // namespace mcserver
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "socket.hpp"
+#include "io_ring.hpp"
 #include "util/result.hpp"
 #include <string>
 #include <vector>
@@ -24,9 +25,19 @@ public:
     // Accept incoming connections (non-blocking if socket is non-blocking)
     Result<Socket> accept();
 
+    // Queue a multishot accept on 'ring'; each new connection completes separately
+    // until the request ends (no IoCompletionFlags::More), when it must be re-armed
+    bool arm_multishot_accept(IoRing& ring, u64 user_data);
+
+    // Take ownership of the connection reported by an accept completion
+    static Result<Socket> accepted(const IoCompletion& completion);
+
     // Check if listening
     bool is_listening() const { return listen_socket_.is_valid(); }
 
+    // Get native handle of the listening socket (for readiness polling)
+    socket_t native_handle() const { return listen_socket_.native_handle(); }
+
 private:
     Socket listen_socket_;
 };
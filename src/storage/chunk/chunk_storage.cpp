@@ -66,13 +66,6 @@ Result<RegionFile*> ChunkStorage::get_region_file(i32 chunk_x, i32 chunk_z) {
 }
 
 Result<void> ChunkStorage::save_chunk(const Chunk& chunk, i64 world_time) {
-    // Get region file
-    auto region_result = get_region_file(chunk.get_x(), chunk.get_z());
-    if (!region_result) {
-        return region_result.error();
-    }
-    RegionFile* region = region_result.value();
-
     // Serialize chunk to NBT
     auto nbt = ChunkSerializer::serialize(chunk, world_time);
 
@@ -82,17 +75,10 @@ Result<void> ChunkStorage::save_chunk(const Chunk& chunk, i64 world_time) {
         return ErrorCode::ParseError;
     }
 
-    // Get local chunk coordinates within region
-    i32 local_x, local_z;
-    chunk_to_local(chunk.get_x(), chunk.get_z(), local_x, local_z);
-
-    // Write chunk to region file
-    return region->write_chunk(local_x, local_z, *level);
-}
+    std::lock_guard<std::mutex> lock(mutex_);
 
-Result<std::unique_ptr<Chunk>> ChunkStorage::load_chunk(i32 chunk_x, i32 chunk_z) {
     // Get region file
-    auto region_result = get_region_file(chunk_x, chunk_z);
+    auto region_result = get_region_file(chunk.get_x(), chunk.get_z());
     if (!region_result) {
         return region_result.error();
     }
@@ -100,10 +86,31 @@ Result<std::unique_ptr<Chunk>> ChunkStorage::load_chunk(i32 chunk_x, i32 chunk_z
 
     // Get local chunk coordinates within region
     i32 local_x, local_z;
-    chunk_to_local(chunk_x, chunk_z, local_x, local_z);
+    chunk_to_local(chunk.get_x(), chunk.get_z(), local_x, local_z);
 
-    // Read chunk from region file
-    auto nbt_result = region->read_chunk(local_x, local_z);
+    // Write chunk to region file
+    return region->write_chunk(local_x, local_z, *level);
+}
+
+Result<std::unique_ptr<Chunk>> ChunkStorage::load_chunk(i32 chunk_x, i32 chunk_z) {
+    Result<std::unique_ptr<NBTCompound>> nbt_result = ErrorCode::NotFound;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Get region file
+        auto region_result = get_region_file(chunk_x, chunk_z);
+        if (!region_result) {
+            return region_result.error();
+        }
+        RegionFile* region = region_result.value();
+
+        // Get local chunk coordinates within region
+        i32 local_x, local_z;
+        chunk_to_local(chunk_x, chunk_z, local_x, local_z);
+
+        // Read chunk from region file
+        nbt_result = region->read_chunk(local_x, local_z);
+    }
     if (!nbt_result) {
         return nbt_result.error();
     }
@@ -117,6 +124,8 @@ Result<std::unique_ptr<Chunk>> ChunkStorage::load_chunk(i32 chunk_x, i32 chunk_z
 }
 
 bool ChunkStorage::chunk_exists(i32 chunk_x, i32 chunk_z) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
     // Get region file
     auto region_result = get_region_file(chunk_x, chunk_z);
     if (!region_result) {
@@ -133,6 +142,7 @@ bool ChunkStorage::chunk_exists(i32 chunk_x, i32 chunk_z) {
 }
 
 void ChunkStorage::close_all() {
+    std::lock_guard<std::mutex> lock(mutex_);
     for (auto& [key, region] : region_files_) {
         region->close();
     }
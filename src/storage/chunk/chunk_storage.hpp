@@ -6,12 +6,14 @@
 #include "storage/region/region_file.hpp"
 #include <string>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace mcserver {
 
 // High-level chunk storage manager for McRegion format
 // Manages region files and provides save/load interface
+// Thread-safe: chunks may be loaded on job system workers while the tick thread saves.
 class ChunkStorage {
 public:
     explicit ChunkStorage(const std::string& world_path);
@@ -43,6 +45,7 @@ private:
     std::string get_region_file_path(i32 region_x, i32 region_z) const;
 
     std::string world_path_;
+    std::mutex mutex_;      // Guards region_files_ and the region files themselves
     std::unordered_map<i64, std::unique_ptr<RegionFile>> region_files_;
 
     // Pack region coordinates into a single i64 key
@@ -121,16 +121,11 @@ Result<void> BlockManager::break_block(i32 x, i8 y, i32 z) {
         lighting_engine_->update_light_on_block_break(x, y, z);
     }
 
-    // Broadcast block change
+    // Broadcast block change; clients relight around it themselves
     if (block_change_callback_) {
         block_change_callback_(x, y, z, 0, 0);
     }
 
-    // Trigger chunk update to resend chunk with updated lighting
-    if (chunk_update_callback_) {
-        chunk_update_callback_(chunk_x, chunk_z);
-    }
-
     return Result<void>();
 }
 
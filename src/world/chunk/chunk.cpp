@@ -1,10 +1,17 @@
 #include "chunk.hpp"
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 
 namespace mcserver {
 
-Chunk::Chunk(i32 x, i32 z) : x_(x), z_(z) {
+// Source of the per-instance half of chunk versions
+static std::atomic<u32> next_chunk_instance{1};
+
+Chunk::Chunk(i32 x, i32 z)
+    : x_(x)
+    , z_(z)
+    , version_(static_cast<u64>(next_chunk_instance.fetch_add(1, std::memory_order_relaxed)) << 32) {
     // Initialize all blocks to air
     std::fill(blocks_.begin(), blocks_.end(), static_cast<u8>(BlockId::Air));
 
@@ -27,8 +34,11 @@ void Chunk::set_block(i32 x, i32 y, i32 z, u8 block_id) {
     if (x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z) {
         return;
     }
-    blocks_[get_index(x, y, z)] = block_id;
-    mark_dirty();
+    u8& block = blocks_[get_index(x, y, z)];
+    if (block != block_id) {
+        block = block_id;
+        touch();
+    }
 }
 
 void Chunk::set_block(i32 x, i32 y, i32 z, BlockId block_id) {
@@ -46,8 +56,9 @@ void Chunk::set_metadata(i32 x, i32 y, i32 z, u8 metadata) {
     if (x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z) {
         return;
     }
-    set_nibble(metadata_.data(), get_index(x, y, z), metadata & 0x0F);
-    mark_dirty();
+    if (set_nibble(metadata_.data(), get_index(x, y, z), metadata & 0x0F)) {
+        touch();
+    }
 }
 
 u8 Chunk::get_block_light(i32 x, i32 y, i32 z) const {
@@ -61,8 +72,9 @@ void Chunk::set_block_light(i32 x, i32 y, i32 z, u8 light_level) {
     if (x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z) {
         return;
     }
-    set_nibble(block_light_.data(), get_index(x, y, z), light_level & 0x0F);
-    mark_dirty();
+    if (set_nibble(block_light_.data(), get_index(x, y, z), light_level & 0x0F)) {
+        touch();
+    }
 }
 
 u8 Chunk::get_sky_light(i32 x, i32 y, i32 z) const {
@@ -76,8 +88,9 @@ void Chunk::set_sky_light(i32 x, i32 y, i32 z, u8 light_level) {
     if (x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z) {
         return;
     }
-    set_nibble(sky_light_.data(), get_index(x, y, z), light_level & 0x0F);
-    mark_dirty();
+    if (set_nibble(sky_light_.data(), get_index(x, y, z), light_level & 0x0F)) {
+        touch();
+    }
 }
 
 u8 Chunk::get_nibble(const u8* data, usize index) {
@@ -91,15 +104,17 @@ u8 Chunk::get_nibble(const u8* data, usize index) {
     }
 }
 
-void Chunk::set_nibble(u8* data, usize index, u8 value) {
+bool Chunk::set_nibble(u8* data, usize index, u8 value) {
     usize byte_index = index / 2;
     bool high_nibble = (index % 2) == 1;
+    u8 old_byte = data[byte_index];
 
     if (high_nibble) {
-        data[byte_index] = (data[byte_index] & 0x0F) | ((value & 0x0F) << 4);
+        data[byte_index] = (old_byte & 0x0F) | ((value & 0x0F) << 4);
     } else {
-        data[byte_index] = (data[byte_index] & 0xF0) | (value & 0x0F);
+        data[byte_index] = (old_byte & 0xF0) | (value & 0x0F);
     }
+    return data[byte_index] != old_byte;
 }
 
 } // namespace mcserver
@@ -67,6 +67,12 @@ public:
     const u8* get_block_light_data() const { return block_light_.data(); }
     const u8* get_sky_light_data() const { return sky_light_.data(); }
 
+    // Changes whenever block, metadata or light data actually changes (setters that
+    // store the value already there leave it alone). The high 32 bits are unique per
+    // Chunk instance, so a reloaded chunk never matches data derived from an earlier
+    // copy (e.g. a cached MapChunk payload)
+    u64 get_version() const { return version_; }
+
     // Mark chunk as modified (needs saving/resending)
     void mark_dirty() { dirty_ = true; }
     bool is_dirty() const { return dirty_; }
@@ -79,6 +85,7 @@ public:
 private:
     i32 x_;  // Chunk X coordinate
     i32 z_;  // Chunk Z coordinate
+    u64 version_;
     bool dirty_ = false;
     bool generated_ = false;
 
@@ -101,7 +108,14 @@ private:
 
     // Get/set nibble (4-bit value) in packed array
     static u8 get_nibble(const u8* data, usize index);
-    static void set_nibble(u8* data, usize index, u8 value);
+    // Returns true if the stored value changed
+    static bool set_nibble(u8* data, usize index, u8 value);
+
+    // Record a data change: new version, needs saving
+    void touch() {
+        ++version_;
+        dirty_ = true;
+    }
 };
 
 } // namespace mcserver
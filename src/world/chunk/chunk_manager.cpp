@@ -1,4 +1,5 @@
 #include "chunk_manager.hpp"
+#include "core/scheduler/job_system.hpp"
 #include "storage/chunk/chunk_storage.hpp"
 #include "util/log/logger.hpp"
 
@@ -29,11 +30,21 @@ Chunk* ChunkManager::load_chunk(i32 chunk_x, i32 chunk_z) {
         return it->second.get();
     }
 
+    std::unique_ptr<Chunk> chunk = read_or_generate(generator_, storage_, chunk_x, chunk_z);
+
+    Chunk* chunk_ptr = chunk.get();
+    chunks_[key] = std::move(chunk);
+
+    return chunk_ptr;
+}
+
+std::unique_ptr<Chunk> ChunkManager::read_or_generate(WorldGenerator* generator, ChunkStorage* storage,
+                                                     i32 chunk_x, i32 chunk_z) {
     std::unique_ptr<Chunk> chunk;
 
     // Try to load from storage first
-    if (storage_ && storage_->chunk_exists(chunk_x, chunk_z)) {
-        auto load_result = storage_->load_chunk(chunk_x, chunk_z);
+    if (storage && storage->chunk_exists(chunk_x, chunk_z)) {
+        auto load_result = storage->load_chunk(chunk_x, chunk_z);
         if (load_result) {
             chunk = std::move(load_result.value());
             Logger::instance().log(LogLevel::Debug, LogCategory::World,
@@ -49,17 +60,39 @@ Chunk* ChunkManager::load_chunk(i32 chunk_x, i32 chunk_z) {
         chunk = std::make_unique<Chunk>(chunk_x, chunk_z);
 
         // Generate terrain if generator is available
-        if (generator_ && !chunk->is_generated()) {
-            generator_->generate_chunk(*chunk);
+        if (generator && !chunk->is_generated()) {
+            generator->generate_chunk(*chunk);
             // Logger::instance().log(LogLevel::Debug, LogCategory::World,
             //     "Generated new chunk (" + std::to_string(chunk_x) + ", " + std::to_string(chunk_z) + ")");
         }
     }
 
-    Chunk* chunk_ptr = chunk.get();
-    chunks_[key] = std::move(chunk);
+    return chunk;
+}
 
-    return chunk_ptr;
+bool ChunkManager::prepare_chunk_async(i32 chunk_x, i32 chunk_z) {
+    auto key = make_key(chunk_x, chunk_z);
+    if (chunks_.contains(key) || preparing_.contains(key)) {
+        return true;
+    }
+
+    if (!job_system_) {
+        load_chunk(chunk_x, chunk_z);
+        return true;
+    }
+
+    if (preparing_.size() >= MAX_PREPARING) {
+        return false;
+    }
+
+    preparing_.insert(key);
+    job_system_->submit([prepared = prepared_, generator = generator_, storage = storage_,
+                         chunk_x, chunk_z]() {
+        auto chunk = read_or_generate(generator, storage, chunk_x, chunk_z);
+        std::lock_guard<std::mutex> lock(prepared->mutex);
+        prepared->chunks.push_back(std::move(chunk));
+    });
+    return true;
 }
 
 void ChunkManager::unload_chunk(i32 chunk_x, i32 chunk_z) {
@@ -140,7 +173,21 @@ void ChunkManager::save_all() {
 }
 
 void ChunkManager::tick() {
-    // Future: Handle chunk updates, lighting, etc.
+    std::vector<std::unique_ptr<Chunk>> ready;
+    {
+        std::lock_guard<std::mutex> lock(prepared_->mutex);
+        ready.swap(prepared_->chunks);
+    }
+
+    for (auto& chunk : ready) {
+        auto key = make_key(chunk->get_x(), chunk->get_z());
+        preparing_.erase(key);
+
+        // Loaded synchronously while the job ran: that copy may already be modified
+        if (!chunks_.contains(key)) {
+            chunks_[key] = std::move(chunk);
+        }
+    }
 }
 
 } // namespace mcserver
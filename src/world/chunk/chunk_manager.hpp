@@ -4,11 +4,14 @@
 #include "world/generation/world_generator.hpp"
 #include <memory>
 #include <map>
+#include <mutex>
+#include <set>
 #include <vector>
 
 namespace mcserver {
 
 class ChunkStorage;
+class JobSystem;
 
 class ChunkManager {
 public:
@@ -23,6 +26,13 @@ public:
     // Load a chunk (from storage or generate if needed)
     Chunk* load_chunk(i32 chunk_x, i32 chunk_z);
 
+    // Load or generate a chunk on the job system; it becomes visible to
+    // get_chunk_if_loaded() in the tick() after it is ready.
+    // Returns true if the chunk is loaded or being prepared, false if MAX_PREPARING
+    // chunks are already in flight (ask again later). Without a job system the
+    // chunk is loaded right away.
+    bool prepare_chunk_async(i32 chunk_x, i32 chunk_z);
+
     // Unload a chunk (saves if dirty)
     void unload_chunk(i32 chunk_x, i32 chunk_z);
 
@@ -38,19 +48,42 @@ public:
     // Save all loaded chunks (dirty or not)
     void save_all();
 
-    // Update logic (placeholder for future use)
+    // Adopt chunks prepared on the job system since the last tick
     void tick();
 
+    // Chunks handed to the job system and not adopted yet
+    usize get_preparing_chunk_count() const { return preparing_.size(); }
+
     // Get chunk count
     usize get_loaded_chunk_count() const { return chunks_.size(); }
 
     // Set chunk storage (can be set after construction)
     void set_storage(ChunkStorage* storage) { storage_ = storage; }
 
+    // Job system for prepare_chunk_async(); nullptr prepares synchronously.
+    // Must outlive the chunks it is preparing (stop it before clearing this).
+    void set_job_system(JobSystem* job_system) { job_system_ = job_system; }
+
+    static constexpr usize MAX_PREPARING = 64;
+
 private:
+    // Chunks finished by workers, waiting for tick() to adopt them
+    // Shared with the jobs so a late job never touches a destroyed manager
+    struct PreparedChunks {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Chunk>> chunks;
+    };
+
     WorldGenerator* generator_;
     ChunkStorage* storage_;
+    JobSystem* job_system_ = nullptr;
     std::map<std::pair<i32, i32>, std::unique_ptr<Chunk>> chunks_;
+    std::set<std::pair<i32, i32>> preparing_;
+    std::shared_ptr<PreparedChunks> prepared_ = std::make_shared<PreparedChunks>();
+
+    // Read a chunk from storage, or generate it; safe to call from workers
+    static std::unique_ptr<Chunk> read_or_generate(WorldGenerator* generator, ChunkStorage* storage,
+                                                   i32 chunk_x, i32 chunk_z);
 
     // Helper to create chunk key
     static std::pair<i32, i32> make_key(i32 x, i32 z) {
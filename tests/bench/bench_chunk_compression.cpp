@@ -0,0 +1,78 @@
+// Chunk compression benchmark
+// Compresses generated terrain with every engine and level built in and prints
+// the average payload size and time per chunk, to pick chunk-compression-engine
+// and chunk-compression-level for a deployment.
+//
+// Usage: bench_chunk_compression [chunks] [seed]
+
+#include "net/protocol/packets/map_chunk.hpp"
+#include "net/protocol/chunk_compressor.hpp"
+#include "world/chunk/chunk.hpp"
+#include "world/generation/world_generator.hpp"
+#include "platform/time/clock.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace mcserver;
+
+int main(int argc, char** argv) {
+    i32 chunk_count = argc > 1 ? std::atoi(argv[1]) : 64;
+    i64 seed = argc > 2 ? std::atoll(argv[2]) : 12345;
+    if (chunk_count <= 0) {
+        std::fprintf(stderr, "usage: %s [chunks] [seed]\n", argv[0]);
+        return 1;
+    }
+
+    // A square of terrain around the origin, like a player's first view
+    WorldGenerator generator(seed);
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    i32 side = 1;
+    while (side * side < chunk_count) {
+        ++side;
+    }
+    for (i32 i = 0; i < chunk_count; ++i) {
+        auto chunk = std::make_unique<Chunk>(i % side - side / 2, i / side - side / 2);
+        generator.generate_chunk(*chunk);
+        chunks.push_back(std::move(chunk));
+    }
+
+    std::printf("%d chunks, seed %lld, %zu bytes each uncompressed\n\n", chunk_count,
+                static_cast<long long>(seed), PacketMapChunk::TOTAL_DATA_SIZE);
+    std::printf("%-12s %5s %12s %10s %8s\n", "engine", "level", "bytes/chunk", "us/chunk", "ratio");
+
+    for (CompressionEngine engine : {CompressionEngine::Zlib, CompressionEngine::Libdeflate}) {
+        if (!ChunkCompressor::is_available(engine)) {
+            std::printf("%-12s (not built in)\n", ChunkCompressor::engine_name(engine));
+            continue;
+        }
+
+        for (i32 level = CompressionSettings::MIN_LEVEL; level <= CompressionSettings::MAX_LEVEL;
+             ++level) {
+            CompressionSettings settings{engine, level};
+            usize total_bytes = 0;
+
+            auto start = Clock::now();
+            for (const auto& chunk : chunks) {
+                SharedBytes payload = PacketMapChunk::compress_sections(
+                    chunk->get_blocks_data(), chunk->get_metadata_data(),
+                    chunk->get_block_light_data(), chunk->get_sky_light_data(), settings);
+                if (!payload) {
+                    std::fprintf(stderr, "%s level %d failed\n",
+                                 ChunkCompressor::engine_name(engine), level);
+                    return 1;
+                }
+                total_bytes += payload->size();
+            }
+            i64 elapsed_us = Clock::elapsed_us(start);
+
+            f64 bytes_per_chunk = static_cast<f64>(total_bytes) / chunk_count;
+            std::printf("%-12s %5d %12.0f %10.1f %7.1fx\n", ChunkCompressor::engine_name(engine),
+                        level, bytes_per_chunk, static_cast<f64>(elapsed_us) / chunk_count,
+                        static_cast<f64>(PacketMapChunk::TOTAL_DATA_SIZE) / bytes_per_chunk);
+        }
+    }
+
+    return 0;
+}
@@ -4,6 +4,7 @@
 int test_packet();
 int test_arena();
 int test_random();
+int test_network_io();
 
 int main() {
     std::cout << "Running unit tests...\n";
@@ -13,6 +14,7 @@ int main() {
     failed += test_packet();
     failed += test_arena();
     failed += test_random();
+    failed += test_network_io();
 
     if (failed == 0) {
         std::cout << "\nAll tests passed!\n";
@@ -0,0 +1,317 @@
+#include "platform/net/poller.hpp"
+#include "platform/net/io_ring.hpp"
+#include "platform/net/socket.hpp"
+#include "net/transport/network_io_thread.hpp"
+#include "net/session/connection.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifndef PLATFORM_WINDOWS
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace mcserver;
+
+#ifndef PLATFORM_WINDOWS
+// Connected pair of stream sockets, both non-blocking
+static bool make_socket_pair(Socket& a, Socket& b) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+        return false;
+    }
+    a = Socket(fds[0]);
+    b = Socket(fds[1]);
+    return a.set_non_blocking(true).is_ok() && b.set_non_blocking(true).is_ok();
+}
+
+// Flags reported for 'user_data' by one wait, or None
+static u32 wait_flags(Poller& poller, void* user_data, i32 timeout_ms) {
+    std::vector<PollEvent> events;
+    auto wait_result = poller.wait(events, timeout_ms);
+    assert(wait_result.is_ok());
+    for (const auto& event : events) {
+        if (event.user_data == user_data) {
+            return event.flags;
+        }
+    }
+    return PollFlags::None;
+}
+
+// Append what the socket has to 'out'; false once the peer has closed it
+static bool read_available(Socket& socket, std::vector<byte>& out) {
+    byte buffer[4096];
+    while (true) {
+        auto received = socket.receive(buffer, sizeof(buffer));
+        if (!received) {
+            return true;    // Would block
+        }
+        if (received.value() == 0) {
+            return false;
+        }
+        out.insert(out.end(), buffer, buffer + received.value());
+    }
+}
+
+// Poll 'done' until it holds or two seconds have passed
+template <typename Fn>
+static bool wait_until(Fn&& done) {
+    for (int attempt = 0; attempt < 400; ++attempt) {
+        if (done()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return done();
+}
+
+// Shard assignment, flushing and closing on two I/O threads asked to use 'backend'
+// Returns the backend they actually run
+static NetworkBackend check_io_threads(NetworkBackend backend,
+                                       u32 ring_entries = IoRing::DEFAULT_ENTRIES) {
+    std::vector<std::unique_ptr<NetworkIoThread>> shards;
+    for (u32 i = 0; i < 2; ++i) {
+        shards.push_back(std::make_unique<NetworkIoThread>(i, backend, ring_entries));
+        assert(shards.back()->start().is_ok());
+    }
+
+    // New connections go to the shard with the fewest
+    Socket peers[3];
+    std::shared_ptr<Connection> connections[3];
+    NetworkIoThread* assigned[3];
+    for (int i = 0; i < 3; ++i) {
+        Socket local;
+        assert(make_socket_pair(local, peers[i]));
+        connections[i] = std::make_shared<Connection>(std::move(local));
+        assigned[i] = NetworkIoThread::least_loaded(shards);
+        assigned[i]->add_connection(connections[i]);
+    }
+    assert(assigned[0] == shards[0].get() && assigned[1] == shards[1].get());
+    assert(assigned[2] == shards[0].get());
+    assert(shards[0]->connection_count() == 2 && shards[1]->connection_count() == 1);
+
+    // Queued output waits for request_flush()
+    const char hello[] = "hello";
+    OutboundQueue batch;
+    batch.append(reinterpret_cast<const byte*>(hello), 5);
+    connections[1]->queue_outbound(batch);
+    std::vector<byte> received;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert(read_available(peers[1], received) && received.empty());
+    shards[1]->request_flush();
+    assert(wait_until([&]() { return read_available(peers[1], received) && received.size() == 5; }));
+    assert(std::memcmp(received.data(), hello, 5) == 0);
+    assert(wait_until([&]() { return connections[1]->bytes_sent() == 5; }));
+    assert(connections[1]->queued_bytes() == 0);
+
+    // More than the socket buffer holds: the rest is sent as the client reads,
+    // complete and in order
+    std::vector<byte> bulk(1024 * 1024);
+    for (usize i = 0; i < bulk.size(); ++i) {
+        bulk[i] = static_cast<byte>(i % 251);
+    }
+    batch.append(bulk.data(), bulk.size());
+    connections[1]->queue_outbound(batch);
+    shards[1]->request_flush();
+    received.clear();
+    assert(wait_until([&]() {
+        read_available(peers[1], received);
+        return received.size() >= bulk.size();
+    }));
+    assert(received == bulk);
+
+    // The client hangs up: marked closed and dropped from its shard
+    peers[0].close();
+    assert(wait_until([&]() { return shards[0]->connection_count() == 1; }));
+    assert(connections[0]->is_closed() && !connections[0]->close_reason().empty());
+
+    // The server closes: queued output is flushed first, then the socket goes
+    batch.append(reinterpret_cast<const byte*>(hello), 5);
+    connections[2]->queue_outbound(batch);
+    connections[2]->request_close();
+    shards[0]->request_flush();
+    assert(wait_until([&]() { return shards[0]->connection_count() == 0; }));
+    assert(connections[2]->is_closed() && connections[2]->close_reason() == "Closed by server");
+    received.clear();
+    assert(wait_until([&]() { return !read_available(peers[2], received); }));
+    assert(received.size() == 5);
+
+    NetworkBackend running = shards[0]->backend();
+    for (auto& shard : shards) {
+        shard->stop();
+    }
+    assert(shards[1]->connection_count() == 0);
+    return running;
+}
+#endif
+
+#ifdef PLATFORM_LINUX
+// Wait for the next completion of 'user_data'; others reaped meanwhile stay in 'seen'
+static bool next_completion(IoRing& ring, std::vector<IoCompletion>& seen, u64 user_data,
+                            IoCompletion& out) {
+    std::vector<IoCompletion> completions;
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        auto it = std::find_if(seen.begin(), seen.end(),
+                               [&](const IoCompletion& c) { return c.user_data == user_data; });
+        if (it != seen.end()) {
+            out = *it;
+            seen.erase(it);
+            return true;
+        }
+        auto wait_result = ring.submit_and_wait(completions, 20);
+        assert(wait_result.is_ok());
+        seen.insert(seen.end(), completions.begin(), completions.end());
+    }
+    return false;
+}
+#endif
+
+int test_network_io() {
+    std::cout << "Testing network I/O...\n";
+
+#ifndef PLATFORM_WINDOWS
+    // Test readiness events and interest changes of the poller
+    {
+        Socket local;
+        Socket peer;
+        assert(make_socket_pair(local, peer));
+
+        Poller poller;
+        assert(poller.open().is_ok());
+        assert(poller.open().error() == ErrorCode::AlreadyExists);
+
+        int tag = 0;
+        assert(poller.add(local.native_handle(), PollFlags::Readable, &tag).is_ok());
+        assert(poller.add(local.native_handle(), PollFlags::Readable, &tag).error() ==
+               ErrorCode::AlreadyExists);
+        assert(poller.size() == 1);
+
+        // Nothing to read yet
+        assert(wait_flags(poller, &tag, 0) == PollFlags::None);
+
+        // Level-triggered: reported again until the data is read
+        const byte ping[4] = {byte{1}, byte{2}, byte{3}, byte{4}};
+        assert(peer.send(ping, sizeof(ping)).value() == 4);
+        assert(wait_flags(poller, &tag, 1000) == PollFlags::Readable);
+        assert(wait_flags(poller, &tag, 0) == PollFlags::Readable);
+        byte buffer[16];
+        assert(local.receive(buffer, sizeof(buffer)).value() == 4);
+        assert(wait_flags(poller, &tag, 0) == PollFlags::None);
+
+        // Re-armed for writing only: free send space is reported, unread data isn't
+        assert(peer.send(ping, sizeof(ping)).value() == 4);
+        assert(poller.modify(local.native_handle(), PollFlags::Writable, &tag).is_ok());
+        assert(wait_flags(poller, &tag, 1000) == PollFlags::Writable);
+
+        // And back: the data that arrived meanwhile is still reported
+        assert(poller.modify(local.native_handle(), PollFlags::Readable, &tag).is_ok());
+        assert(wait_flags(poller, &tag, 1000) == PollFlags::Readable);
+        assert(local.receive(buffer, sizeof(buffer)).value() == 4);
+
+        // A wake interrupts a blocking wait without reporting an event
+        std::vector<PollEvent> events;
+        poller.wake();
+        assert(poller.wait(events, -1).value() == 0);
+
+        // The peer going away is a hangup, even with only read interest
+        peer.close();
+        assert(wait_flags(poller, &tag, 1000) & PollFlags::Hangup);
+
+        poller.remove(local.native_handle());
+        assert(poller.size() == 0);
+        assert(wait_flags(poller, &tag, 0) == PollFlags::None);
+
+        std::cout << "  ✓ Poller\n";
+    }
+
+    // Test network I/O threads serving socket pairs
+    {
+        assert(check_io_threads(NetworkBackend::Poll) == NetworkBackend::Poll);
+
+        std::cout << "  ✓ NetworkIoThread\n";
+    }
+#endif
+
+#ifdef PLATFORM_LINUX
+    // Test io_uring receives and sends over a socket pair
+    {
+        // A ring the kernel refuses leaves it closed, and I/O threads on poll
+        IoRing refused;
+        assert(refused.open(0).is_error() && !refused.is_open());
+        assert(check_io_threads(NetworkBackend::IoUring, 0) == NetworkBackend::Poll);
+
+        IoRing ring;
+        if (ring.open().is_ok()) {
+            assert(ring.open().error() == ErrorCode::AlreadyExists);
+            assert(ring.setup_buffers(4, 64).is_ok());
+
+            Socket local;
+            Socket peer;
+            assert(make_socket_pair(local, peer));
+            std::vector<IoCompletion> seen;
+            IoCompletion completion;
+
+            // One multishot receive completes once per arrival and stays armed
+            assert(ring.prep_recv_multishot(local.native_handle(), 1));
+            assert(ring.pending_submissions() > 0);
+            assert(ring.submit().is_ok() && ring.pending_submissions() == 0);
+            const char* messages[] = {"abc", "defgh"};
+            for (const char* message : messages) {
+                usize size = std::strlen(message);
+                assert(peer.send(reinterpret_cast<const byte*>(message), size).value() ==
+                       static_cast<isize>(size));
+                assert(next_completion(ring, seen, 1, completion));
+                assert(completion.result == static_cast<i32>(size));
+                assert(completion.flags == (IoCompletionFlags::More | IoCompletionFlags::Buffer));
+                assert(std::memcmp(ring.buffer_data(completion.buffer_id), message, size) == 0);
+                ring.recycle_buffer(completion.buffer_id);
+            }
+
+            // A send finding the socket buffer full waits for the peer to read
+            std::vector<byte> filler(4096, byte{7});
+            while (local.send(filler.data(), filler.size()).is_ok()) {
+            }
+            IoSlice slice{filler.data(), filler.size()};
+            std::vector<byte> drained;
+            assert(ring.prep_send_vectored(local.native_handle(), &slice, 1, 2));
+            assert(ring.submit_and_wait(seen, 50).is_ok() && seen.empty());
+            assert(read_available(peer, drained) && !drained.empty());
+            assert(next_completion(ring, seen, 2, completion));
+            assert(completion.result == static_cast<i32>(filler.size()));
+
+            // Unless it may not wait: then it completes with -EAGAIN and goes
+            // through unchanged once resubmitted after the peer has read
+            while (local.send(filler.data(), filler.size()).is_ok()) {
+            }
+            assert(ring.prep_send_vectored(local.native_handle(), &slice, 1, 3, true));
+            assert(next_completion(ring, seen, 3, completion) && completion.result == -EAGAIN);
+            assert(read_available(peer, drained));
+            assert(ring.prep_send_vectored(local.native_handle(), &slice, 1, 3, true));
+            assert(next_completion(ring, seen, 3, completion));
+            assert(completion.result == static_cast<i32>(filler.size()));
+
+            // The peer closing ends the receive (with unread data it would be a reset)
+            assert(read_available(peer, drained));
+            peer.close();
+            assert(next_completion(ring, seen, 1, completion));
+            assert(completion.result == 0 && !(completion.flags & IoCompletionFlags::More));
+
+            // The same I/O thread tests, driven by completions
+            ring.close();
+            assert(!ring.is_open());
+            assert(check_io_threads(NetworkBackend::IoUring) == NetworkBackend::IoUring);
+        }
+
+        std::cout << "  ✓ IoRing\n";
+    }
+#endif
+
+    return 0;
+}
@@ -2,26 +2,70 @@
 #include "net/protocol/packets/handshake.hpp"
 #include "net/protocol/packets/login.hpp"
 #include "net/protocol/packets/keepalive.hpp"
+#include "net/protocol/packets/player_position.hpp"
+#include "net/protocol/packets/chat.hpp"
+#include "net/protocol/packets/place.hpp"
+#include "net/protocol/packets/window_click.hpp"
+#include "net/protocol/packets/block_change.hpp"
+#include "net/protocol/packets/entity_look_move.hpp"
+#include "net/protocol/packets/entity_status.hpp"
+#include "net/protocol/packets/collect.hpp"
+#include "net/protocol/packets/animation.hpp"
+#include "net/protocol/clientbound.hpp"
+#include "net/protocol/frame_scanner.hpp"
+#include "net/protocol/packet_handler.hpp"
+#include "net/session/receive_buffer.hpp"
+#include "net/session/outbound_queue.hpp"
+#include "net/session/traffic_shaper.hpp"
+#include "net/session/inbound_budget.hpp"
+#include "net/session/client_session.hpp"
+#include "net/transport/connection_throttle.hpp"
+#include "net/transport/chunk_streaming_manager.hpp"
+#include "net/transport/block_change_accumulator.hpp"
+#include "net/transport/entity_movement_tracker.hpp"
+#include "net/transport/entity_tracker.hpp"
+#include "net/protocol/packets/map_chunk.hpp"
+#include "world/chunk/chunk.hpp"
+#include "world/chunk/chunk_manager.hpp"
+#include "core/scheduler/job_system.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <chrono>
+#include <thread>
 #include <iostream>
 #include <cassert>
 
 using namespace mcserver;
 
+// Session over an unconnected socket and no managers; no I/O thread ever writes
+// its output or reads its input
+static std::unique_ptr<ClientSession> make_session(std::shared_ptr<Connection> connection,
+                                                   ChunkManager* chunk_manager,
+                                                   const BacklogLimits& backlog_limits = {},
+                                                   i64 login_timeout_ms = 30000) {
+    return std::make_unique<ClientSession>(std::move(connection), chunk_manager, nullptr, nullptr,
+                                           nullptr, nullptr, nullptr, nullptr, nullptr,
+                                           nullptr, nullptr, nullptr, nullptr, nullptr, 2048, 512,
+                                           backlog_limits, InboundLimits{}, login_timeout_ms);
+}
+
 int test_packet() {
     std::cout << "Testing packet serialization...\n";
 
     // Test handshake packet
     {
         PacketHandshake packet("TestUser");
-        PacketBuffer buffer;
+        PacketWriter writer;
 
-        auto write_result = packet.write(buffer);
+        auto write_result = packet.write(writer);
         assert(write_result.is_ok());
 
-        buffer.reset_position();
+        PacketReader reader(writer.data());
 
         PacketHandshake read_packet;
-        auto read_result = read_packet.read(buffer);
+        auto read_result = read_packet.read(reader);
         assert(read_result.is_ok());
         assert(read_packet.username == "TestUser");
 
@@ -31,15 +75,15 @@ int test_packet() {
     // Test login packet
     {
         PacketLogin packet("Player123", 14, 123456789L, 0);
-        PacketBuffer buffer;
+        PacketWriter writer;
 
-        auto write_result = packet.write(buffer);
+        auto write_result = packet.write(writer);
         assert(write_result.is_ok());
 
-        buffer.reset_position();
+        PacketReader reader(writer.data());
 
         PacketLogin read_packet;
-        auto read_result = read_packet.read(buffer);
+        auto read_result = read_packet.read(reader);
         assert(read_result.is_ok());
         assert(read_packet.username == "Player123");
         assert(read_packet.protocol_version == 14);
@@ -49,30 +93,1074 @@ int test_packet() {
         std::cout << "  ✓ Login packet\n";
     }
 
-    // Test packet buffer primitives
+    // Test packet writer and reader primitives
     {
-        PacketBuffer buffer;
+        PacketWriter writer(64);
 
-        buffer.write_i32(42);
-        buffer.write_i64(1234567890123L);
-        buffer.write_string("Hello");
-        buffer.write_bool(true);
+        writer.write_i32(42);
+        writer.write_i64(1234567890123L);
+        writer.write_string("Hello");
+        writer.write_bool(true);
+        writer.write_i16(-7);
 
-        buffer.reset_position();
+        PacketReader reader(writer.data());
 
-        auto i32_result = buffer.read_i32();
+        auto i32_result = reader.read_i32();
         assert(i32_result.is_ok() && i32_result.value() == 42);
 
-        auto i64_result = buffer.read_i64();
+        auto i64_result = reader.read_i64();
         assert(i64_result.is_ok() && i64_result.value() == 1234567890123L);
 
-        auto str_result = buffer.read_string();
+        auto str_result = reader.read_string();
         assert(str_result.is_ok() && str_result.value() == "Hello");
 
-        auto bool_result = buffer.read_bool();
+        auto bool_result = reader.read_bool();
         assert(bool_result.is_ok() && bool_result.value() == true);
 
-        std::cout << "  ✓ PacketBuffer primitives\n";
+        auto i16_result = reader.read_i16();
+        assert(i16_result.is_ok() && i16_result.value() == -7);
+
+        // Reading past the end fails instead of touching the bytes behind the span
+        assert(reader.remaining() == 0);
+        assert(!reader.read_u8().is_ok());
+
+        std::cout << "  ✓ PacketWriter / PacketReader primitives\n";
+    }
+
+    // Test attached payloads stay shared until flattened
+    {
+        auto payload = std::make_shared<const std::vector<byte>>(
+            OutboundQueue::SHARED_SEGMENT_SIZE, byte{0xAB});
+
+        PacketWriter writer;
+        writer.write_u8(51);
+        writer.attach(payload);
+        writer.write_u8(7);
+        assert(writer.data().size() == 2 && writer.size() == 2 + payload->size());
+        assert(writer.attachments().size() == 1 && writer.attachments()[0].offset == 1);
+
+        // The outbound queue references the payload instead of copying it
+        OutboundQueue queue;
+        queue.append(writer);
+        IoSlice slices[4];
+        assert(queue.gather(slices, 4) == 3);
+        assert(slices[1].data == payload->data());
+
+        std::vector<byte> flat = writer.take_flat();
+        assert(flat.size() == 2 + payload->size());
+        assert(flat.front() == byte{51} && flat[1] == byte{0xAB} && flat.back() == byte{7});
+
+        PacketReader reader(flat);
+        reader.read_u8();
+        auto bytes_result = reader.read_bytes(payload->size());
+        assert(bytes_result.is_ok() && bytes_result.value()[0] == byte{0xAB});
+        assert(!reader.read_bytes(2).is_ok());
+
+        std::cout << "  ✓ PacketWriter attachments\n";
+    }
+
+    // Test receive buffer cursors and compaction
+    {
+        ReceiveBuffer buffer(16);
+        assert(buffer.capacity() == 0);
+
+        ByteSpan target = buffer.writable(10);
+        for (usize i = 0; i < 10; ++i) {
+            target[i] = static_cast<byte>(i);
+        }
+        buffer.commit(10);
+        buffer.consume(8);
+        assert(buffer.size() == 2);
+
+        // Needs more room than the tail has: the two unread bytes move to the front
+        target = buffer.writable(12);
+        assert(buffer.capacity() == 16);
+        assert(buffer.readable()[0] == static_cast<byte>(8));
+        assert(buffer.readable()[1] == static_cast<byte>(9));
+        assert(target.size() == 14);
+
+        // A frame larger than the capacity grows the buffer
+        buffer.writable(64);
+        assert(buffer.capacity() >= 66);
+        assert(buffer.size() == 2);
+
+        buffer.consume(2);
+        assert(buffer.empty());
+
+        std::cout << "  ✓ ReceiveBuffer\n";
+    }
+
+    // Test outbound queue coalescing and partial writes
+    {
+        OutboundQueue queue;
+        const byte small[3] = {byte{1}, byte{2}, byte{3}};
+        std::vector<byte> large(OutboundQueue::LARGE_PACKET_SIZE, byte{7});
+
+        // Small packets share a block, a large one gets its own segment
+        queue.append(small, sizeof(small));
+        queue.append(small, sizeof(small));
+        queue.append(large.data(), large.size());
+        queue.append(small, sizeof(small));
+        assert(queue.segment_count() == 3);
+        assert(queue.size() == 9 + large.size());
+
+        IoSlice slices[OutboundQueue::MAX_SLICES];
+        assert(queue.gather(slices, OutboundQueue::MAX_SLICES) == 3);
+        assert(slices[0].size == 6);
+        assert(slices[1].size == large.size());
+
+        // A partial write keeps the unsent tail of the front segment
+        queue.consume(4);
+        assert(queue.gather(slices, 1) == 1);
+        assert(slices[0].size == 2 && slices[0].data[0] == byte{2});
+
+        // Splicing hands the segments over without copying
+        OutboundQueue staged;
+        staged.splice(queue);
+        assert(queue.empty() && queue.segment_count() == 0);
+        assert(staged.size() == 5 + large.size());
+
+        staged.consume(2 + large.size());
+        assert(staged.segment_count() == 1 && staged.size() == 3);
+        staged.consume(3);
+        assert(staged.empty() && staged.segment_count() == 0);
+
+        // A shared encoding is referenced by every queue it is appended to
+        auto shared = std::make_shared<const std::vector<byte>>(
+            OutboundQueue::SHARED_SEGMENT_SIZE, byte{9});
+        OutboundQueue first;
+        OutboundQueue second;
+        first.append(shared);
+        second.append(shared);
+        assert(shared.use_count() == 3);
+        assert(first.gather(slices, 1) == 1 && slices[0].data == shared->data());
+        first.consume(shared->size());
+        assert(shared.use_count() == 2);
+
+        // Tiny shared encodings are copied into the block instead
+        PacketKeepAlive keepalive;
+        EncodedPacket encoded = keepalive.encode();
+        second.append(encoded);
+        assert(encoded.use_count() == 1);
+        assert(second.segment_count() == 2);
+
+        std::cout << "  ✓ OutboundQueue\n";
+    }
+
+    // Test traffic shaper lanes and budget
+    {
+        TrafficShaper shaper(2048, 512);
+        std::vector<byte> chunk(OutboundQueue::LARGE_PACKET_SIZE, byte{51});
+        const byte keepalive[1] = {byte{0}};
+        const byte block_change[12] = {byte{53}};
+
+        assert(traffic_class_of(PacketId::MapChunk) == TrafficClass::Chunk);
+        assert(traffic_class_of(PacketId::RelEntityMove) == TrafficClass::Entity);
+        assert(traffic_class_of(PacketId::KeepAlive) == TrafficClass::Control);
+
+        // Chunk data gets the leftover budget; world packets wait behind it
+        shaper.append(TrafficClass::Chunk, chunk.data(), chunk.size());
+        shaper.append(TrafficClass::Chunk, chunk.data(), chunk.size());
+        shaper.append(TrafficClass::World, block_change, sizeof(block_change));
+        shaper.append(TrafficClass::Control, keepalive, sizeof(keepalive));
+        assert(shaper.pending_bytes(TrafficClass::World) == 0);
+
+        OutboundQueue out;
+        shaper.release(out, 0, 0);
+        IoSlice slices[4];
+        assert(out.gather(slices, 4) == 2);
+        assert(slices[0].size == 1 && slices[1].size == chunk.size());
+
+        // Overshoot is paid back: nothing but control traffic until the debt is gone
+        out.clear();
+        shaper.release(out, 0, 0);
+        assert(out.empty());
+
+        // A socket that falls behind caps the budget at what it drains, which is
+        // also the first measurement of its rate
+        assert(shaper.drain_estimate() == 0);
+        shaper.release(out, 100, 1 << 20);
+        assert(shaper.budget() == 512);
+        assert(shaper.drain_estimate() == 100);
+        while (shaper.pending_bytes() > 0) {
+            shaper.release(out, 1 << 20, 0);
+        }
+        assert(out.size() == chunk.size() + sizeof(block_change));
+        assert(shaper.budget() > 512);
+
+        std::cout << "  ✓ TrafficShaper\n";
+    }
+
+    // Test that entity packets never overtake the spawn of their entity
+    {
+        std::vector<byte> chunk(OutboundQueue::LARGE_PACKET_SIZE, byte{51});
+        byte spawn[22] = {static_cast<byte>(PacketId::NamedEntitySpawn)};
+        byte move[5] = {static_cast<byte>(PacketId::RelEntityMove)};
+
+        auto spawn_before_move = [](const OutboundQueue& out) {
+            IoSlice slices[16];
+            usize count = out.gather(slices, 16);
+            std::vector<byte> bytes;
+            for (usize i = 0; i < count; ++i) {
+                bytes.insert(bytes.end(), slices[i].data, slices[i].data + slices[i].size);
+            }
+            auto spawn_at = std::find(bytes.begin(), bytes.end(), static_cast<byte>(PacketId::NamedEntitySpawn));
+            auto move_at = std::find(bytes.begin(), bytes.end(), static_cast<byte>(PacketId::RelEntityMove));
+            return spawn_at != bytes.end() && move_at != bytes.end() && spawn_at < move_at;
+        };
+
+        // Spawn parked behind chunk data: the move follows it into the chunk lane
+        TrafficShaper parked(2048, 512);
+        parked.append(TrafficClass::Chunk, chunk.data(), chunk.size());
+        parked.append(TrafficClass::World, spawn, sizeof(spawn));
+        parked.append(TrafficClass::Entity, move, sizeof(move));
+        assert(parked.pending_bytes(TrafficClass::Entity) == 0);
+
+        OutboundQueue out;
+        while (parked.pending_bytes() > 0) {
+            parked.release(out, 0, 0);
+        }
+        assert(spawn_before_move(out));
+
+        // Spawn held back by the budget: the move waits in the world lane
+        TrafficShaper held(2048, 512);
+        held.append(TrafficClass::Chunk, chunk.data(), chunk.size());
+        out.clear();
+        held.release(out, 0, 0);
+        held.append(TrafficClass::World, spawn, sizeof(spawn));
+        held.release(out, 0, 0);
+        assert(held.pending_bytes(TrafficClass::World) == sizeof(spawn));
+        held.append(TrafficClass::Entity, move, sizeof(move));
+        assert(held.pending_bytes(TrafficClass::Entity) == 0);
+        while (held.pending_bytes() > 0) {
+            held.release(out, 0, 0);
+        }
+        assert(spawn_before_move(out));
+
+        // With no world packets pending, entity packets keep their own lane
+        held.append(TrafficClass::Entity, move, sizeof(move));
+        assert(held.pending_bytes(TrafficClass::Entity) == sizeof(move));
+
+        std::cout << "  ✓ TrafficShaper spawn before move\n";
+    }
+
+    // Test that a map chunk is released whole, never split from its payload
+    {
+        TrafficShaper shaper(100, 50);
+        const byte control[90] = {byte{3}};
+        shaper.append(TrafficClass::Control, control, sizeof(control));
+
+        PacketMapChunk chunk(1, 2);
+        chunk.compressed_data = std::make_shared<const std::vector<byte>>(4000, byte{0xAA});
+        PacketWriter writer;
+        assert(chunk.encode(writer).is_ok());
+        shaper.append(TrafficClass::Chunk, writer);
+
+        // The credit runs out after the header block; the payload goes with it anyway
+        OutboundQueue out;
+        shaper.release(out, 0, 0);
+        assert(shaper.pending_bytes(TrafficClass::Chunk) == 0);
+
+        PacketKeepAlive keepalive;
+        shaper.append(TrafficClass::Control, keepalive.encode());
+        shaper.release(out, 0, 0);
+
+        IoSlice slices[8];
+        usize count = out.gather(slices, 8);
+        std::vector<byte> bytes;
+        for (usize i = 0; i < count; ++i) {
+            bytes.insert(bytes.end(), slices[i].data, slices[i].data + slices[i].size);
+        }
+        usize header_end = sizeof(control) + 18;
+        assert(bytes.size() == header_end + 4000 + 1);
+        assert(bytes[sizeof(control)] == static_cast<byte>(PacketId::MapChunk));
+        assert(bytes[header_end] == byte{0xAA});
+        assert(bytes[header_end + 3999] == byte{0xAA});
+        assert(bytes.back() == static_cast<byte>(PacketId::KeepAlive));
+
+        std::cout << "  ✓ TrafficShaper releases whole packets\n";
+    }
+
+    // Test inbound packet budget
+    {
+        InboundBudget budget(InboundLimits{4, 16});
+
+        // Cost runs out before the packet count: 8 + 8 fits, a third dig doesn't
+        budget.begin_tick(1000);
+        assert(budget.try_take(PacketId::BlockDig));
+        assert(budget.try_take(PacketId::Place));
+        assert(!budget.try_take(PacketId::BlockDig));
+        assert(budget.cost_used() == 16);
+
+        // Packet count caps cheap traffic
+        budget.begin_tick(1000);
+        for (int i = 0; i < 4; ++i) {
+            assert(budget.try_take(PacketId::PlayerPosition));
+        }
+        assert(!budget.try_take(PacketId::KeepAlive));
+
+        // With the shared budget spent, one packet still gets through
+        budget.begin_tick(0);
+        assert(budget.try_take(PacketId::Chat));
+        assert(!budget.try_take(PacketId::KeepAlive));
+        assert(budget.cost_used() == inbound_cost_of(PacketId::Chat));
+
+        std::cout << "  ✓ InboundBudget\n";
+    }
+
+    // Test per-address connection throttle
+    {
+        ConnectionThrottle throttle(2, 60);
+        Clock::time_point start{};
+
+        // A burst of two, then one connection per second
+        assert(throttle.allow("10.0.0.1", start));
+        assert(throttle.allow("10.0.0.1", start));
+        assert(!throttle.allow("10.0.0.1", start));
+        assert(throttle.allow("10.0.0.2", start));
+        assert(!throttle.allow("10.0.0.1", start + std::chrono::milliseconds(500)));
+        assert(throttle.allow("10.0.0.1", start + std::chrono::milliseconds(1500)));
+
+        // Buckets that filled up again are forgotten
+        throttle.prune(start + std::chrono::seconds(2));
+        assert(throttle.tracked_addresses() == 1);
+        throttle.prune(start + std::chrono::seconds(10));
+        assert(throttle.tracked_addresses() == 0);
+
+        ConnectionThrottle disabled(0, 60);
+        for (int i = 0; i < 10; ++i) {
+            assert(disabled.allow("10.0.0.1", start));
+        }
+
+        std::cout << "  ✓ ConnectionThrottle\n";
+    }
+
+    // Test backlog limits of clients that stop reading
+    {
+        BacklogLimits limits{4096, 16384, 50};
+        PacketWriter chunk;
+        chunk.write_u8(static_cast<u8>(PacketId::MapChunk));
+        chunk.write_bytes(ConstByteSpan(std::vector<byte>(6000).data(), 6000));
+
+        // Past the soft limit: backlogged, kicked once it stalls for the timeout
+        auto slow = make_session(std::make_shared<Connection>(Socket()), nullptr, limits);
+        slow->send_encoded(chunk);
+        slow->flush_output();
+        assert(slow->is_backlogged() && slow->is_connected());
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        slow->flush_output();
+        assert(slow->was_evicted() && !slow->is_connected());
+
+        // At the hard limit: kicked on the spot
+        auto flooded = make_session(std::make_shared<Connection>(Socket()), nullptr, limits);
+        for (int i = 0; i < 3; ++i) {
+            flooded->send_encoded(chunk);
+        }
+        flooded->flush_output();
+        assert(flooded->was_evicted());
+
+        // Nothing waiting: never stalled
+        auto idle = make_session(std::make_shared<Connection>(Socket()), nullptr, limits);
+        idle->flush_output();
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        idle->flush_output();
+        assert(!idle->is_backlogged() && idle->is_connected());
+
+        // Entities whose moves were skipped are handed back once, for a teleport
+        idle->drop_movement(9);
+        idle->drop_movement(4);
+        idle->drop_movement(9);
+        assert(idle->has_dropped_movement());
+        assert((idle->take_dropped_movement() == std::vector<i32>{4, 9}));
+        assert(!idle->has_dropped_movement());
+
+        std::cout << "  ✓ Client backlog limits\n";
+    }
+
+    // Test per-chunk viewer bitset
+    {
+        ChunkViewers viewers;
+        viewers.insert(3);
+        viewers.insert(70);
+        viewers.insert(3);
+        assert(viewers.size() == 2);
+        assert(viewers.contains(70) && !viewers.contains(4) && !viewers.contains(500));
+
+        std::vector<u32> slots;
+        viewers.for_each([&](u32 slot) { slots.push_back(slot); });
+        assert(slots.size() == 2 && slots[0] == 3 && slots[1] == 70);
+
+        viewers.erase(3);
+        viewers.erase(3);
+        viewers.erase(70);
+        assert(viewers.empty());
+
+        std::cout << "  ✓ ChunkViewers\n";
+    }
+
+    // Test compressed chunk payload cache
+    {
+        Chunk chunk(2, -3);
+        ChunkPayloadCache cache;
+
+        SharedBytes first = cache.get(chunk);
+        assert(first && cache.get(chunk) == first);
+        assert(cache.hits() == 1 && cache.misses() == 1);
+
+        uLongf size = PacketMapChunk::TOTAL_DATA_SIZE;
+        std::vector<u8> raw(size);
+        assert(uncompress(raw.data(), &size, reinterpret_cast<const Bytef*>(first->data()), first->size()) == Z_OK);
+        assert(size == PacketMapChunk::TOTAL_DATA_SIZE);
+
+        // Writing the value already there is not a change
+        u64 version = chunk.get_version();
+        chunk.set_block(1, 64, 1, chunk.get_block(1, 64, 1));
+        assert(chunk.get_version() == version && cache.get(chunk) == first);
+
+        chunk.set_block(1, 64, 1, static_cast<u8>(chunk.get_block(1, 64, 1) + 1));
+        assert(chunk.get_version() != version && cache.get(chunk) != first);
+
+        // Another chunk never matches this one's version
+        Chunk other(2, -3);
+        assert(other.get_version() != chunk.get_version());
+
+        cache.erase(ChunkCoord(2, -3));
+        assert(cache.size() == 0 && !cache.find(chunk));
+        cache.get(chunk);
+        assert(cache.misses() == 3);
+
+        // Payloads compressed off-thread only count while the version still matches
+        cache.store(ChunkCoord(2, -3), chunk.get_version(), first);
+        assert(cache.find(chunk) == first);
+        cache.store(ChunkCoord(2, -3), chunk.get_version() - 1, first);
+        assert(!cache.find(chunk));
+
+        std::cout << "  ✓ ChunkPayloadCache\n";
+    }
+
+    // Test that payloads finished after their chunk was released are not cached
+    {
+        WorldGenerator generator(12345);
+        ChunkManager chunks(&generator);
+        JobSystem jobs(2);
+        jobs.start();
+        ChunkStreamingManager streaming(&chunks, 3, &jobs);
+        auto session = make_session(std::make_shared<Connection>(Socket()), nullptr);
+
+        // Loaded up front, so the first tick starts compressing the front of the queue
+        for (i32 cx = -3; cx <= 3; ++cx) {
+            for (i32 cz = -3; cz <= 3; ++cz) {
+                chunks.get_chunk(cx, cz);
+            }
+        }
+
+        // The player leaves while its chunks are still compressing
+        streaming.add_player(session.get(), 8.0, 8.0, 0.0f);
+        streaming.tick();
+        assert(streaming.compress_jobs_in_flight() > 0);
+        streaming.remove_player(session.get());
+        jobs.wait_all();
+
+        streaming.tick();
+        assert(streaming.compress_jobs_in_flight() == 0);
+        assert(streaming.cached_payload_count() == 0);
+
+        jobs.stop();
+        std::cout << "  ✓ Released chunks leave no cached payloads\n";
+    }
+
+    // Test frame scanner against the packet writers
+    {
+        // The length table and the decoder table must agree on what clients may send
+        for (u32 id = 0; id < 256; ++id) {
+            bool has_layout = FrameScanner::layout(static_cast<u8>(id)).rule != FrameRule::Unknown;
+            assert(has_layout == PacketHandler::accepts(static_cast<u8>(id)));
+        }
+
+        PacketWriter frame;
+        PacketChat("hello").encode(frame);
+        ConstByteSpan bytes(frame.data());
+
+        // Every prefix is incomplete and already knows the full size once the length is in
+        for (usize i = 0; i < bytes.size(); ++i) {
+            FrameInfo partial = FrameScanner::scan(bytes.first(i));
+            assert(partial.status == FrameStatus::Incomplete);
+            if (i >= 3) {
+                assert(partial.size == bytes.size());
+            }
+        }
+
+        FrameInfo whole = FrameScanner::scan(bytes);
+        assert(whole.status == FrameStatus::Complete && whole.size == bytes.size());
+
+        ServerboundPacket decoded;
+        usize frame_size = 0;
+        assert(PacketHandler::decode(bytes, decoded, frame_size) == DecodeStatus::Complete);
+        assert(frame_size == bytes.size());
+        assert(std::get<serverbound::Chat>(decoded).message == "hello");
+
+        // Place carries count and damage only when an item is held
+        PacketWriter empty_hand;
+        PacketPlace place;
+        place.block_item_id = -1;
+        place.encode(empty_hand);
+        assert(FrameScanner::scan(empty_hand.data()).size == 13);
+
+        PacketWriter holding;
+        place.block_item_id = 4;
+        place.encode(holding);
+        assert(FrameScanner::scan(holding.data()).size == 16);
+
+        // Out-of-range string lengths are rejected before anything is buffered
+        const byte oversized[] = {static_cast<byte>(PacketId::Chat), byte{0x7F}, byte{0xFF}};
+        assert(FrameScanner::scan(oversized).status == FrameStatus::Malformed);
+
+        const byte unknown[] = {byte{0x99}};
+        assert(FrameScanner::scan(unknown).status == FrameStatus::UnknownPacket);
+
+        std::cout << "  ✓ Frame scanner\n";
+    }
+
+    // Test clientbound encoders against the packet classes
+    {
+        auto same_bytes = [](const Packet& packet, const PacketWriter& encoded) {
+            PacketWriter expected;
+            packet.encode(expected);
+            return expected.data() == encoded.data();
+        };
+
+        PacketWriter writer;
+        clientbound::block_change(writer, -100, 64, 250, 4, 2);
+        assert(writer.size() == 12);
+        assert(same_bytes(PacketBlockChange(-100, 64, 250, 4, 2), writer));
+
+        writer.clear();
+        clientbound::entity_look_move(writer, 42, -3, 0, 5, 64, -128);
+        assert(same_bytes(PacketEntityLookMove(42, -3, 0, 5, 64, -128), writer));
+
+        writer.clear();
+        clientbound::entity_status(writer, 7, 3);
+        assert(same_bytes(PacketEntityStatus(7, 3), writer));
+
+        writer.clear();
+        clientbound::animation(writer, 5, AnimationType::SwingArm);
+        assert(same_bytes(PacketAnimation(5, AnimationType::SwingArm), writer));
+
+        writer.clear();
+        clientbound::collect(writer, 9, 1);
+        assert(same_bytes(PacketCollect(9, 1), writer));
+
+        std::cout << "  ✓ Clientbound encoders\n";
+    }
+
+    // Test per-tick block change batching
+    {
+        BlockChangeAccumulator changes;
+        changes.record(-17, 70, 33, 1, 0);      // Chunk (-2, 2), local (15, 1)
+        changes.record(-17, 70, 33, 4, 0);      // Same block: replaces
+        changes.record(-20, 10, 34, 50, 3);
+        changes.record(5, 5, 5, 1, 0);          // Chunk (0, 0)
+
+        usize chunks = 0;
+        changes.drain([&](ChunkCoord coord, const BlockChangeAccumulator::ChunkChanges& chunk) {
+            ++chunks;
+            assert(!chunk.resend);
+            if (coord == ChunkCoord(-2, 2)) {
+                assert(chunk.changes.size() == 2);
+                const auto& first = chunk.changes[0];
+                assert(first.local_x() == 15 && first.local_z() == 1 && first.y() == 70);
+                assert(first.block_type == 4);
+
+                PacketWriter writer;
+                clientbound::multi_block_change(writer, coord.x, coord.z, chunk.changes);
+                assert(writer.size() == 11 + 2 * 4);
+                PacketReader reader(ConstByteSpan(writer.data()).subspan(1));
+                assert(reader.read_i32().value() == -2 && reader.read_i32().value() == 2);
+                assert(reader.read_i16().value() == 2);
+                assert(reader.read_i16().value() == static_cast<i16>(0xF146));
+            } else {
+                assert(coord == ChunkCoord(0, 0) && chunk.changes.size() == 1);
+            }
+        });
+        assert(chunks == 2 && changes.empty());
+
+        // Too many distinct blocks turn into a resend of the box around them
+        for (i32 i = 0; i <= static_cast<i32>(BlockChangeAccumulator::MAX_CHANGES_PER_CHUNK); ++i) {
+            changes.record(i & 15, static_cast<i8>(60 + (i >> 4)), 2, 1, 0);
+        }
+        changes.drain([](ChunkCoord, const BlockChangeAccumulator::ChunkChanges& chunk) {
+            assert(chunk.overflow && !chunk.resend && chunk.changes.empty());
+            assert(chunk.bounds.min_x == 0 && chunk.bounds.max_x == 15);
+            assert(chunk.bounds.min_y == 60 && chunk.bounds.max_y == 64);
+            assert(chunk.bounds.min_z == 2 && chunk.bounds.max_z == 2);
+        });
+
+        // A whole-chunk resend covers any changes in it
+        changes.record(1, 1, 1, 1, 0);
+        changes.record_resend(0, 0);
+        changes.record(2, 2, 2, 1, 0);
+        changes.drain([](ChunkCoord, const BlockChangeAccumulator::ChunkChanges& chunk) {
+            assert(chunk.resend && chunk.changes.empty());
+        });
+
+        std::cout << "  ✓ BlockChangeAccumulator\n";
+    }
+
+    // Test entity movement tracking
+    {
+        using clientbound::EntityPosition;
+        EntityMovementTracker tracker;
+        PacketWriter writer;
+        EntityPosition previous;
+
+        auto start = EntityPosition::of(10.0, 64.0, -5.0, 90.0f, 0.0f);
+        assert(start.x == 320 && start.z == -160 && start.yaw == 64);
+        tracker.track(7, start, 2);
+
+        auto sent_id = [&]() { return static_cast<PacketId>(writer.data()[0]); };
+
+        // Only every second tick is checked
+        auto moved = EntityPosition::of(10.1, 64.0, -5.0, 90.0f, 0.0f);
+        writer.clear();
+        assert(!tracker.update(7, moved, writer, previous));
+        assert(tracker.update(7, moved, writer, previous));
+        assert(sent_id() == PacketId::RelEntityMove && previous == start);
+
+        // Nothing the client could see changed
+        writer.clear();
+        tracker.update(7, EntityPosition::of(10.11, 64.0, -5.0, 90.5f, 0.0f), writer, previous);
+        assert(!tracker.update(7, EntityPosition::of(10.11, 64.0, -5.0, 90.5f, 0.0f), writer, previous));
+        assert(writer.size() == 0);
+
+        auto turned = EntityPosition::of(10.11, 64.0, -5.0, 180.0f, 0.0f);
+        tracker.update(7, turned, writer, previous);
+        assert(tracker.update(7, turned, writer, previous) && sent_id() == PacketId::EntityLook);
+
+        auto both = EntityPosition::of(10.5, 63.0, -5.0, 0.0f, 10.0f);
+        writer.clear();
+        tracker.update(7, both, writer, previous);
+        assert(tracker.update(7, both, writer, previous) && sent_id() == PacketId::RelEntityMoveLook);
+
+        // Fixed-point deltas sum to exactly where the tracker says clients are
+        PacketReader reader(ConstByteSpan(writer.data()).subspan(5));
+        assert(both.x - previous.x == reader.read_i8().value());
+        assert(*tracker.find(7) == both);
+
+        // Too far for a byte delta
+        auto far = EntityPosition::of(20.0, 63.0, -5.0, 0.0f, 10.0f);
+        writer.clear();
+        tracker.update(7, far, writer, previous);
+        assert(tracker.update(7, far, writer, previous) && sent_id() == PacketId::EntityTeleport);
+
+        // Periodic resync
+        for (u32 tick = 0; tick < EntityMovementTracker::RESYNC_INTERVAL; ++tick) {
+            assert(!tracker.update(7, far, writer, previous));
+        }
+        auto nudged = EntityPosition::of(20.1, 63.0, -5.0, 0.0f, 10.0f);
+        writer.clear();
+        assert(!tracker.update(7, nudged, writer, previous));
+        assert(tracker.update(7, nudged, writer, previous) && sent_id() == PacketId::EntityTeleport);
+
+        tracker.untrack(7);
+        assert(!tracker.find(7) && !tracker.update(7, far, writer, previous));
+
+        // Backlogged clients may skip relative updates of distant entities, never teleports
+        auto viewer = EntityPosition::of(0.0, 64.0, 0.0, 0.0f, 0.0f);
+        auto nearby = EntityPosition::of(20.0, 64.0, -30.0, 0.0f, 0.0f);
+        auto distant = EntityPosition::of(40.0, 64.0, 0.0, 0.0f, 0.0f);
+        writer.clear();
+        clientbound::entity_relative_move(writer, 7, 1, 0, 0);
+        assert(EntityMovementTracker::droppable(writer, distant, viewer));
+        assert(!EntityMovementTracker::droppable(writer, nearby, viewer));
+        writer.clear();
+        clientbound::entity_look(writer, 7, 10, 0);
+        assert(EntityMovementTracker::droppable(writer, distant, viewer));
+        writer.clear();
+        clientbound::entity_teleport(writer, 7, distant);
+        assert(!EntityMovementTracker::droppable(writer, distant, viewer));
+
+        std::cout << "  ✓ EntityMovementTracker\n";
+    }
+
+    // Test range-based entity tracking
+    {
+        EntityTracker tracker;
+        std::vector<std::pair<i32, i32>> spawned;     // (viewer, entity)
+        std::vector<std::pair<i32, i32>> destroyed;
+        bool far_chunk_loaded = true;
+
+        // Sessions are only passed back, never dereferenced
+        auto viewer_id = [](ClientSession* session) {
+            return static_cast<i32>(reinterpret_cast<uintptr_t>(session) / 8);
+        };
+        auto* alice = reinterpret_cast<ClientSession*>(uintptr_t{8});
+        auto* bob = reinterpret_cast<ClientSession*>(uintptr_t{16});
+
+        tracker.set_spawn_callback([&](ClientSession* viewer, i32 entity_id, TrackedEntityKind) {
+            spawned.emplace_back(viewer_id(viewer), entity_id);
+        });
+        tracker.set_destroy_callback([&](ClientSession* viewer, i32 entity_id) {
+            destroyed.emplace_back(viewer_id(viewer), entity_id);
+        });
+        tracker.set_chunk_visible_fn([&](ClientSession*, i32 chunk_x, i32) {
+            return chunk_x < 10 || far_chunk_loaded;
+        });
+
+        // Players see each other, not themselves
+        tracker.add_viewer(alice, 100, 0.0, 0.0);
+        tracker.add_entity(100, TrackedEntityKind::Player, 0.0, 0.0, 64.0);
+        tracker.add_viewer(bob, 200, 50.0, 0.0);
+        tracker.add_entity(200, TrackedEntityKind::Player, 50.0, 0.0, 64.0);
+        tracker.add_entity(7, TrackedEntityKind::Mob, 60.0, 60.0, 64.0);
+        tracker.update();
+        assert(spawned.size() == 4 && tracker.visible_count(alice) == 2);
+        assert(tracker.visible_count(bob) == 2);
+
+        // Small moves are not re-checked at all
+        spawned.clear();
+        tracker.move_entity(7, 61.0, 60.0);
+        tracker.update();
+        assert(spawned.empty() && destroyed.empty());
+
+        // Past the range but inside the margin: still visible to alice
+        tracker.move_entity(7, 70.0, 60.0);
+        tracker.update();
+        assert(destroyed.empty());
+        tracker.move_entity(7, 64.0 + EntityTracker::DESPAWN_MARGIN + 1.0, 60.0);
+        tracker.update();
+        assert(destroyed.size() == 1 && destroyed[0] == std::make_pair(1, 7));
+        assert(!tracker.is_visible(alice, 7) && tracker.is_visible(bob, 7));
+
+        // Coming back has to get within the range again
+        destroyed.clear();
+        tracker.move_entity(7, 70.0, 60.0);
+        tracker.update();
+        assert(spawned.empty());
+        tracker.move_entity(7, 64.0, 60.0);
+        tracker.update();
+        assert(spawned.size() == 1 && spawned[0] == std::make_pair(1, 7));
+
+        // Only the viewers that have it spawned hear about it
+        i32 viewers = 0;
+        tracker.for_each_viewer(7, [&](ClientSession*) { ++viewers; });
+        assert(viewers == 2);
+
+        // Bob follows it, but without its chunk loaded it is destroyed for him too
+        // (as is alice, now out of his range)
+        far_chunk_loaded = false;
+        tracker.move_entity(7, 200.0, 60.0);
+        tracker.move_viewer(bob, 190.0, 60.0);
+        tracker.chunks_changed(bob);
+        tracker.update();
+        assert(destroyed.size() == 3 && tracker.visible_count(bob) == 0);
+
+        // Removing entities and viewers
+        spawned.clear();
+        destroyed.clear();
+        far_chunk_loaded = true;
+        tracker.chunks_changed(bob);
+        tracker.update();
+        assert(spawned.size() == 1 && spawned[0] == std::make_pair(2, 7));
+        tracker.remove_entity(7);
+        assert(destroyed.size() == 1 && !tracker.has_entity(7));
+        tracker.remove_viewer(alice);
+        assert(!tracker.has_viewer(alice) && !tracker.has_entity(100));
+        assert(tracker.visible_count(bob) == 0 && tracker.viewer_count() == 1);
+
+        std::cout << "  ✓ EntityTracker\n";
+    }
+
+    // Test sub-cuboid MapChunk encoding
+    {
+        std::vector<u8> blocks(PacketMapChunk::BLOCKS_SIZE);
+        std::vector<u8> nibbles(PacketMapChunk::METADATA_SIZE);
+        for (usize i = 0; i < blocks.size(); ++i) {
+            blocks[i] = static_cast<u8>(i * 7);
+        }
+        for (usize i = 0; i < nibbles.size(); ++i) {
+            nibbles[i] = static_cast<u8>(i * 13);
+        }
+
+        // The whole chunk as a region matches the whole-chunk encoding
+        PacketMapChunk whole(3 * 16, -1 * 16);
+        whole.set_chunk_data(blocks.data(), nibbles.data(), nibbles.data(), nibbles.data());
+        PacketMapChunk as_region;
+        as_region.set_region_data(3, -1, ChunkBox{}, blocks.data(), nibbles.data(),
+                                  nibbles.data(), nibbles.data());
+        assert(as_region.x == whole.x && as_region.z == whole.z && as_region.y == 0);
+        assert(as_region.size_x == 15 && as_region.size_y == 127 && as_region.size_z == 15);
+        assert(*as_region.compressed_data == *whole.compressed_data);
+
+        // y is widened to even bounds: 61..64 becomes 60..65
+        PacketMapChunk region;
+        region.set_region_data(3, -1, ChunkBox{4, 61, 9, 5, 64, 11}, blocks.data(),
+                               nibbles.data(), nibbles.data(), nibbles.data());
+        assert(region.x == 52 && region.y == 60 && region.z == -7);
+        assert(region.size_x == 1 && region.size_y == 5 && region.size_z == 2);
+        assert(region.volume() == 36);
+
+        // Read back through decompression, as a client would
+        PacketMapChunk decoded;
+        decoded.size_x = region.size_x;
+        decoded.size_y = region.size_y;
+        decoded.size_z = region.size_z;
+        decoded.compressed_data = region.compressed_data;
+        const u8* region_blocks = decoded.get_blocks().value();
+        const u8* region_light = decoded.get_sky_light().value();
+
+        // Second column is (x=4, z=10), starting at y=60
+        usize column = (4 * 16 + 10) * 128 + 60;
+        assert(region_blocks[6] == blocks[column] && region_blocks[11] == blocks[column + 5]);
+        assert(region_light[3] == nibbles[column / 2]);
+
+        std::cout << "  ✓ MapChunk regions\n";
+    }
+
+    // Test chunk compression engines and levels
+    {
+        std::vector<u8> first(1000);
+        std::vector<u8> second(3000, 9);
+        for (usize i = 0; i < first.size(); ++i) {
+            first[i] = static_cast<u8>(i % 17);
+        }
+
+        CompressionEngine engine = CompressionEngine::Libdeflate;
+        assert(ChunkCompressor::parse_engine("zlib", engine) && engine == CompressionEngine::Zlib);
+        assert(ChunkCompressor::parse_engine("auto", engine) && ChunkCompressor::is_available(engine));
+        assert(!ChunkCompressor::parse_engine("lz4", engine));
+
+        // Every engine and level inflates back to the sections, in order
+        for (CompressionEngine candidate : {CompressionEngine::Zlib, CompressionEngine::Libdeflate}) {
+            if (!ChunkCompressor::is_available(candidate)) {
+                continue;
+            }
+            for (i32 level : {CompressionSettings::MIN_LEVEL, CompressionSettings::MAX_LEVEL}) {
+                SharedBytes payload = ChunkCompressor::compress(
+                    {{first.data(), first.size()}, {second.data(), second.size()}},
+                    CompressionSettings{candidate, level});
+                assert(payload);
+
+                std::vector<u8> raw(first.size() + second.size());
+                uLongf size = static_cast<uLongf>(raw.size());
+                assert(uncompress(raw.data(), &size, reinterpret_cast<const Bytef*>(payload->data()),
+                                  payload->size()) == Z_OK);
+                assert(size == raw.size() && raw[16] == 16 && raw[1000] == 9);
+            }
+        }
+
+        // Long ticks lower the level at once, it recovers only after a quiet stretch
+        AdaptiveCompressionLevel adaptive(1, 6);
+        assert(adaptive.update(45.0, 50.0) == 5 && adaptive.update(45.0, 50.0) == 4);
+        assert(adaptive.update(30.0, 50.0) == 4);
+        for (u32 tick = 1; tick < AdaptiveCompressionLevel::RECOVERY_TICKS; ++tick) {
+            assert(adaptive.update(10.0, 50.0) == 4);
+        }
+        assert(adaptive.update(10.0, 50.0) == 5);
+        for (i32 tick = 0; tick < 10; ++tick) {
+            adaptive.update(100.0, 50.0);
+        }
+        assert(adaptive.level() == 1);
+
+        std::cout << "  ✓ Chunk compression\n";
+    }
+
+    // Test the order and pace of chunk streaming
+    {
+        WorldGenerator generator(12345);
+        ChunkManager chunks(&generator);
+        ChunkStreamingManager streaming(&chunks, 3);
+        std::vector<ChunkCoord> sent;
+        streaming.set_chunk_sent_callback([&](ClientSession*, i32 chunk_x, i32 chunk_z) {
+            sent.emplace_back(chunk_x, chunk_z);
+        });
+
+        // A cap of 0 would never send anything
+        streaming.set_chunks_per_tick(0);
+        assert(streaming.get_chunks_per_tick() == 1);
+
+        // Facing +Z in the middle of chunk (0, 0): its own chunk, then the one ahead
+        auto session = make_session(std::make_shared<Connection>(Socket()), nullptr);
+        streaming.add_player(session.get(), 8.0, 8.0, 0.0f);
+        streaming.tick();
+        assert((sent == std::vector<ChunkCoord>{{0, 0}}));
+        streaming.tick();
+        assert(sent.size() == 2 && sent[1] == ChunkCoord(0, 1));
+
+        // Turning around re-orders what is still queued: now the one behind is ahead
+        streaming.update_player_chunks(session.get(), 8.0, 8.0, 180.0f);
+        streaming.tick();
+        assert(sent.size() == 3 && sent[2] == ChunkCoord(0, -1));
+
+        // Nearest first, but a chunk ahead ranks as if FACING_BIAS closer and one
+        // behind as if that much further: (0, -2) beats the nearer (-1, 1)
+        streaming.set_chunks_per_tick(6);
+        streaming.tick();
+        std::vector<ChunkCoord> expected{{0, 0}, {0, 1}, {0, -1}, {-1, 0}, {1, 0},
+                                         {-1, -1}, {1, -1}, {0, -2}, {-1, 1}};
+        assert(sent == expected);
+
+        streaming.remove_player(session.get());
+        std::cout << "  ✓ Chunk streaming order\n";
+    }
+
+    // Test that a chunk edited every tick still gets sent when compressed off-thread
+    {
+        WorldGenerator generator(12345);
+        ChunkManager chunks(&generator);
+        JobSystem jobs(2);
+        jobs.start();
+        ChunkStreamingManager streaming(&chunks, 3, &jobs);
+        std::vector<ChunkCoord> sent;
+        streaming.set_chunk_sent_callback([&](ClientSession*, i32 chunk_x, i32 chunk_z) {
+            sent.emplace_back(chunk_x, chunk_z);
+        });
+
+        for (i32 cx = -3; cx <= 3; ++cx) {
+            for (i32 cz = -3; cz <= 3; ++cz) {
+                chunks.get_chunk(cx, cz);
+            }
+        }
+        Chunk* spawn = chunks.get_chunk(0, 0);
+
+        // The player's own chunk is first in the queue and changes before every tick,
+        // so each payload compressed from a snapshot is already out of date
+        auto session = make_session(std::make_shared<Connection>(Socket()), nullptr);
+        streaming.add_player(session.get(), 8.0, 8.0, 0.0f);
+        for (i32 tick = 0; tick < 40 && sent.size() < 49; ++tick) {
+            spawn->set_block(1, 100, 1, static_cast<u8>(tick % 2));
+            streaming.tick();
+            jobs.wait_all();
+        }
+        assert(sent.size() == 49 && sent.front() == ChunkCoord(0, 0));
+
+        streaming.remove_player(session.get());
+        streaming.tick();
+        jobs.stop();
+        std::cout << "  ✓ Chunk streaming of a chunk edited every tick\n";
+    }
+
+    // Test chunk preparation on the job system
+    {
+        WorldGenerator generator(12345);
+        ChunkManager chunks(&generator);
+        JobSystem jobs(2);
+        jobs.start();
+        chunks.set_job_system(&jobs);
+
+        // Only visible once tick() adopts it, and requested once however often asked
+        assert(chunks.prepare_chunk_async(2, -3) && chunks.prepare_chunk_async(2, -3));
+        assert(chunks.get_preparing_chunk_count() == 1);
+        jobs.wait_all();
+        assert(!chunks.is_chunk_loaded(2, -3));
+        chunks.tick();
+        Chunk* prepared = chunks.get_chunk_if_loaded(2, -3);
+        assert(prepared && prepared->is_generated() && chunks.get_preparing_chunk_count() == 0);
+
+        // Same terrain as generating it on the tick thread
+        Chunk direct(2, -3);
+        generator.generate_chunk(direct);
+        assert(std::memcmp(direct.get_blocks_data(), prepared->get_blocks_data(),
+                           PacketMapChunk::BLOCKS_SIZE) == 0);
+
+        // A chunk loaded synchronously meanwhile wins over the prepared copy
+        assert(chunks.prepare_chunk_async(5, 5));
+        Chunk* loaded = chunks.get_chunk(5, 5);
+        loaded->set_block(1, 70, 1, 1);
+        jobs.wait_all();
+        chunks.tick();
+        assert(chunks.get_chunk_if_loaded(5, 5) == loaded && loaded->get_block(1, 70, 1) == 1);
+
+        // At most MAX_PREPARING in flight
+        for (i32 x = 0; x < static_cast<i32>(ChunkManager::MAX_PREPARING); ++x) {
+            assert(chunks.prepare_chunk_async(x, 100));
+        }
+        assert(!chunks.prepare_chunk_async(0, 101));
+        jobs.wait_all();
+        chunks.tick();
+        assert(chunks.get_preparing_chunk_count() == 0 && chunks.prepare_chunk_async(0, 101));
+
+        jobs.wait_all();
+        jobs.stop();
+        chunks.set_job_system(nullptr);
+        chunks.tick();
+
+        // Without a job system it loads right away
+        assert(chunks.prepare_chunk_async(-8, 8) && chunks.is_chunk_loaded(-8, 8));
+
+        std::cout << "  ✓ Async chunk preparation\n";
+    }
+
+    // Test serverbound decode table
+    {
+        ServerboundPacket decoded;
+        usize frame_size = 0;
+
+        // Optional item fields are read only when an item is held
+        PacketWriter place_frame;
+        PacketPlace(10, 64, -3, 1, 4, 2, 7).encode(place_frame);
+        assert(PacketHandler::decode(place_frame.data(), decoded, frame_size) == DecodeStatus::Complete);
+        const auto& place = std::get<serverbound::Place>(decoded);
+        assert(place.x == 10 && place.y == 64 && place.z == -3 && place.direction == 1);
+        assert(place.item.id == 4 && place.item.count == 2 && place.item.damage == 7);
+
+        PacketWriter click_frame;
+        PacketWindowClick(0, 36, 1, 5, true, nullptr).encode(click_frame);
+        assert(PacketHandler::decode(click_frame.data(), decoded, frame_size) == DecodeStatus::Complete);
+        const auto& click = std::get<serverbound::WindowClick>(decoded);
+        assert(click.slot == 36 && click.right_click == 1 && click.action_number == 5);
+        assert(click.shift && click.item.empty());
+        assert(packet_id_of(decoded) == PacketId::WindowClick);
+
+        // Legality follows the session state
+        assert(PacketHandler::is_legal(PacketId::Handshake, SessionState::Handshake));
+        assert(!PacketHandler::is_legal(PacketId::Chat, SessionState::Handshake));
+        assert(PacketHandler::is_legal(PacketId::Login, SessionState::Login));
+        assert(!PacketHandler::is_legal(PacketId::KeepAlive, SessionState::Login));
+        assert(!PacketHandler::is_legal(PacketId::Login, SessionState::LoggingIn));
+        assert(!PacketHandler::is_legal(PacketId::Position, SessionState::LoggingIn));
+        assert(PacketHandler::is_legal(PacketId::KeepAlive, SessionState::LoggingIn));
+        assert(PacketHandler::is_legal(PacketId::Chat, SessionState::Play));
+        assert(!PacketHandler::is_legal(PacketId::Login, SessionState::Play));
+        assert(!PacketHandler::is_legal(PacketId::Chat, SessionState::Disconnected));
+        assert(!PacketHandler::is_legal(PacketId::MapChunk, SessionState::Play));
+
+        std::cout << "  ✓ Serverbound decode table\n";
+    }
+
+    // Test a login whose spawn area never finishes loading
+    {
+        // Jobs are queued but never run, so the spawn chunks stay pending
+        WorldGenerator generator(12345);
+        ChunkManager chunks(&generator);
+        JobSystem jobs(1);
+        chunks.set_job_system(&jobs);
+
+        auto connection = std::make_shared<Connection>(Socket());
+        auto session = make_session(connection, &chunks, {}, 50);
+        auto receive = [&](const Packet& packet) {
+            PacketWriter frame;
+            packet.encode(frame);
+            connection->on_received(frame.data().data(), frame.data().size());
+        };
+
+        receive(PacketHandshake("Walker"));
+        receive(PacketLogin("Walker", 14, 0, 0));
+        session->process(1000);
+        assert(session->get_state() == SessionState::LoggingIn);
+
+        // Keep-alives and early movement don't end the login
+        receive(PacketKeepAlive());
+        receive(PacketPlayerPosition(0.5, 70.0, 71.62, 0.5, false));
+        session->process(1000);
+        assert(session->get_state() == SessionState::LoggingIn && session->pending_inbound() == 0);
+
+        // Still loading at the deadline: kicked
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        session->process(1000);
+        assert(!session->is_connected());
+
+        chunks.set_job_system(nullptr);
+        std::cout << "  ✓ Login timeout while loading\n";
     }
 
     return 0;
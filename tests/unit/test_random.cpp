@@ -43,6 +43,22 @@ int test_random() {
         std::cout << "  ✓ Float range\n";
     }
 
+    // Test parity with java.util.Random
+    {
+        Random rng(42);
+        assert(rng.next_int() == -1170105035);
+
+        rng.set_seed(42);
+        for (int expected : {0, 3, 8, 4, 0}) {
+            assert(rng.next_int(10) == expected);
+        }
+
+        rng.set_seed(42);
+        assert(rng.next_double() == 0.7275636800328681);
+
+        std::cout << "  ✓ Java parity\n";
+    }
+
     // Test seed consistency
     {
         Random rng(42);